@@ -73,6 +73,29 @@ void GbaCart::WriteRom(uint32_t addr, uint8_t value)
 	}
 }
 
+uint8_t* GbaCart::GetDirectRomPage(uint32_t addr, uint32_t pageSize)
+{
+	//Returns a pointer to the page's data if all reads within it simply return ROM data (no EEPROM, GPIO or open bus)
+	uint32_t start = addr & ~(pageSize - 1);
+	uint32_t end = start + pageSize - 1;
+
+	if((start >> 24) == 0x0D && (_eepromAddr & ~_eepromMask) == 0 && (start & _eepromMask & ~(pageSize - 1)) == (_eepromAddr & ~(pageSize - 1))) {
+		//At least one address in the page maps to the EEPROM
+		return nullptr;
+	}
+
+	if(_gpio && start <= 0x80000C9 && end >= 0x80000C4) {
+		return nullptr;
+	}
+
+	uint32_t romOffset = start & 0x1FFFFFF;
+	if(romOffset + pageSize > _prgRomSize) {
+		return nullptr;
+	}
+
+	return _prgRom + romOffset;
+}
+
 uint8_t GbaCart::ReadRam(uint32_t addr, uint32_t readAddr)
 {
 	if(_flash) {
@@ -69,6 +69,7 @@ public:
 	}
 
 	void WriteRom(uint32_t addr, uint8_t value);
+	uint8_t* GetDirectRomPage(uint32_t addr, uint32_t pageSize);
 
 	uint8_t ReadRam(uint32_t addr, uint32_t readAddr);
 	void WriteRam(GbaAccessModeVal mode, uint32_t addr, uint8_t value, uint32_t writeAddr, uint32_t fullValue);
@@ -112,6 +112,7 @@ LoadRomResult GbaConsole::LoadRom(VirtualFile& romFile)
 
 	_prefetch->Init(_memoryManager.get());
 	_cart->Init(_emu, this, _memoryManager.get(), _saveType, _rtcType, _cartType);
+	_memoryManager->InitReadPages();
 	_ppu->Init(_emu, this, _memoryManager.get());
 	_apu->Init(_emu, this, _dmaController.get(), _memoryManager.get());
 	_timer->Init(_memoryManager.get(), _apu.get());
@@ -49,6 +49,9 @@ GbaMemoryManager::GbaMemoryManager(Emulator* emu, GbaConsole* console, GbaPpu* p
 	_waitStatesLut = new uint8_t[0x400];
 	GenerateWaitStateLut();
 
+	_readPages = new GbaReadPage[GbaMemoryManager::ReadPageCount];
+	memset(_readPages, 0, sizeof(GbaReadPage) * GbaMemoryManager::ReadPageCount);
+
 	//Used to get the correct timing for the timer prescaler, based on the "timer" test
 	_masterClock = 48;
 
@@ -63,6 +66,43 @@ GbaMemoryManager::GbaMemoryManager(Emulator* emu, GbaConsole* console, GbaPpu* p
 GbaMemoryManager::~GbaMemoryManager()
 {
 	delete[] _waitStatesLut;
+	delete[] _readPages;
+}
+
+void GbaMemoryManager::InitReadPages()
+{
+	//Must be called after the cart is initialized
+	//Pages that have side effects or special cases (bootrom, registers, save ram, EEPROM/GPIO, out of bounds ROM, etc.) stay on the slower InternalRead path
+	constexpr uint32_t pageMask = (1 << GbaMemoryManager::ReadPageShift) - 1;
+	for(uint32_t i = 0; i < GbaMemoryManager::ReadPageCount; i++) {
+		uint32_t addr = i << GbaMemoryManager::ReadPageShift;
+		uint32_t offset = addr & 0xFFFFFF;
+		GbaReadPage& page = _readPages[i];
+		page = {};
+
+		switch(addr >> 24) {
+			case 0x02: page = { _extWorkRam + (offset & (GbaConsole::ExtWorkRamSize - 1)), pageMask }; break;
+			case 0x03: page = { _intWorkRam + (offset & (GbaConsole::IntWorkRamSize - 1)), pageMask }; break;
+			case 0x05: page = { _palette, GbaConsole::PaletteRamSize - 1 }; break;
+
+			case 0x06:
+				if(offset < 0x18000 || (offset & 0x14000) != 0x10000) {
+					//Pages that return 0 in bitmap modes stay on the slow path (see InternalRead)
+					page = { _vram + ((offset & 0x10000) ? (offset & 0x17FFF) : (offset & 0xFFFF)), pageMask };
+				}
+				break;
+
+			case 0x07: page = { _oam, GbaConsole::SpriteRamSize - 1 }; break;
+
+			case 0x08: case 0x09: case 0x0A: case 0x0B: case 0x0C: case 0x0D: {
+				uint8_t* rom = _cart->GetDirectRomPage(addr, pageMask + 1);
+				if(rom) {
+					page = { rom, pageMask };
+				}
+				break;
+			}
+		}
+	}
 }
 
 void GbaMemoryManager::ProcessIdleCycle()
@@ -182,11 +222,6 @@ void GbaMemoryManager::GenerateWaitStateLut()
 	}
 }
 
-uint8_t GbaMemoryManager::GetWaitStates(GbaAccessModeVal mode, uint32_t addr)
-{
-	return _waitStatesLut[((addr >> 22) & 0x3FC) | (mode & (GbaAccessMode::Word | ((addr & 0x1FFFF) ? GbaAccessMode::Sequential : 0)))];
-}
-
 void GbaMemoryManager::ProcessWaitStates(GbaAccessModeVal mode, uint32_t addr)
 {
 	uint8_t waitStates;
@@ -273,14 +308,20 @@ uint32_t GbaMemoryManager::Read(GbaAccessModeVal mode, uint32_t addr)
 
 	bool isSigned = mode & GbaAccessMode::Signed;
 	if(mode & GbaAccessMode::Byte) {
-		value = InternalRead(mode, addr, addr);
+		uint8_t* src = GetDirectReadPtr(addr);
+		value = src ? *src : InternalRead(mode, addr, addr);
 		UpdateOpenBus<1>(addr, value);
 		value = isSigned ? (uint32_t)(int8_t)value : (uint8_t)value;
 		_emu->ProcessMemoryRead<CpuType::Gba, 1>(addr, value, mode & GbaAccessMode::Prefetch ? MemoryOperationType::ExecOpCode : MemoryOperationType::Read);
 	} else if(mode & GbaAccessMode::HalfWord) {
-		uint8_t b0 = InternalRead(mode, addr & ~0x01, addr);
-		uint8_t b1 = InternalRead(mode, addr | 1, addr);
-		value = b0 | (b1 << 8);
+		uint8_t* src = GetDirectReadPtr(addr & ~0x01);
+		if(src) {
+			value = src[0] | (src[1] << 8);
+		} else {
+			uint8_t b0 = InternalRead(mode, addr & ~0x01, addr);
+			uint8_t b1 = InternalRead(mode, addr | 1, addr);
+			value = b0 | (b1 << 8);
+		}
 		UpdateOpenBus<2>(addr, value);
 		value = isSigned ? (uint32_t)(int16_t)value : (uint16_t)value;
 		if(!(mode & GbaAccessMode::NoRotate)) {
@@ -288,11 +329,16 @@ uint32_t GbaMemoryManager::Read(GbaAccessModeVal mode, uint32_t addr)
 		}
 		_emu->ProcessMemoryRead<CpuType::Gba, 2>(addr & ~0x01, value, mode & GbaAccessMode::Prefetch ? MemoryOperationType::ExecOpCode : MemoryOperationType::Read);
 	} else {
-		uint8_t b0 = InternalRead(mode, addr & ~0x03, addr);
-		uint8_t b1 = InternalRead(mode, (addr & ~0x03) | 1, addr);
-		uint8_t b2 = InternalRead(mode, (addr & ~0x03) | 2, addr);
-		uint8_t b3 = InternalRead(mode, addr | 3, addr);
-		value = b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+		uint8_t* src = GetDirectReadPtr(addr & ~0x03);
+		if(src) {
+			value = src[0] | (src[1] << 8) | (src[2] << 16) | (src[3] << 24);
+		} else {
+			uint8_t b0 = InternalRead(mode, addr & ~0x03, addr);
+			uint8_t b1 = InternalRead(mode, (addr & ~0x03) | 1, addr);
+			uint8_t b2 = InternalRead(mode, (addr & ~0x03) | 2, addr);
+			uint8_t b3 = InternalRead(mode, addr | 3, addr);
+			value = b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+		}
 		UpdateOpenBus<4>(addr, value);
 		if(!(mode & GbaAccessMode::NoRotate)) {
 			value = RotateValue(mode, addr, value, isSigned);
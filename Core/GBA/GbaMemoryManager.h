@@ -18,9 +18,18 @@ class GbaSerial;
 class GbaRomPrefetch;
 class MgbaLogHandler;
 
+struct GbaReadPage
+{
+	uint8_t* Memory;
+	uint32_t Mask;
+};
+
 class GbaMemoryManager final : public ISerializable
 {
 private:
+	static constexpr uint32_t ReadPageShift = 14;
+	static constexpr uint32_t ReadPageCount = 0x10000000 >> ReadPageShift;
+
 	Emulator* _emu = nullptr;
 	GbaConsole* _console = nullptr;
 	GbaPpu* _ppu = nullptr;
@@ -59,6 +68,20 @@ private:
 
 	uint8_t* _waitStatesLut = nullptr;
 
+	//16KB pages that can be read directly from memory, without side effects (nullptr for all other pages)
+	GbaReadPage* _readPages = nullptr;
+
+	__forceinline uint8_t* GetDirectReadPtr(uint32_t addr)
+	{
+		if(addr < 0x10000000) {
+			GbaReadPage& page = _readPages[addr >> GbaMemoryManager::ReadPageShift];
+			if(page.Memory) {
+				return page.Memory + (addr & page.Mask);
+			}
+		}
+		return nullptr;
+	}
+
 	__forceinline void ProcessWaitStates(GbaAccessModeVal mode, uint32_t addr);
 
 	__noinline void ProcessVramStalling(uint32_t addr);
@@ -85,6 +108,8 @@ public:
 	GbaMemoryManager(Emulator* emu, GbaConsole* console, GbaPpu* ppu, GbaDmaController* dmaController, GbaControlManager* controlManager, GbaTimer* timer, GbaApu* apu, GbaCart* cart, GbaSerial* serial, GbaRomPrefetch* prefetch);
 	~GbaMemoryManager();
 
+	void InitReadPages();
+
 	GbaMemoryManagerState& GetState() { return _state; }
 	uint64_t GetMasterClock() { return _masterClock; }
 
@@ -118,7 +143,10 @@ public:
 	void SetPendingUpdateFlag() { _hasPendingUpdates = true; }
 	void SetPendingLateUpdateFlag() { _hasPendingLateUpdates = true; }
 
-	uint8_t GetWaitStates(GbaAccessModeVal mode, uint32_t addr);
+	__forceinline uint8_t GetWaitStates(GbaAccessModeVal mode, uint32_t addr)
+	{
+		return _waitStatesLut[((addr >> 22) & 0x3FC) | (mode & (GbaAccessMode::Word | ((addr & 0x1FFFF) ? GbaAccessMode::Sequential : 0)))];
+	}
 
 	uint32_t Read(GbaAccessModeVal mode, uint32_t addr);
 	void Write(GbaAccessModeVal mode, uint32_t addr, uint32_t value);
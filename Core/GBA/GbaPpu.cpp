@@ -685,6 +685,11 @@ void GbaPpu::RenderTransformTilemap()
 	int end = std::min<int>(_state.Cycle, 1005) - gap;
 
 	for(; cycle <= end; cycle++) {
+		if(!layer.Mosaic && (cycle & 0x03) == 0 && cycle < end) {
+			cycle = RenderTransformPixels<i>(cycle, end, screenSize) - 1;
+			continue;
+		}
+
 		switch(cycle & 0x03) {
 			case 0: {
 				//Fetch tilemap data
@@ -741,6 +746,57 @@ void GbaPpu::RenderTransformTilemap()
 	}
 }
 
+template<int i>
+int GbaPpu::RenderTransformPixels(int cycle, int end, uint16_t screenSize)
+{
+	//Processes all complete tilemap+pixel fetch pairs between cycle and end (without mosaic), returns the next cycle to process
+	GbaBgConfig& layer = _state.BgLayers[i];
+	GbaTransformConfig& cfg = _state.Transform[i - 2];
+	GbaLayerRendererData& data = _layerData[i];
+
+	constexpr int gap = (37 - i * 2);
+	uint32_t wrapMask = layer.WrapAround ? (screenSize - 1) : 0xFFFFF;
+	uint16_t columnCount = screenSize >> 3;
+	int count = (end - cycle - 1) / 4 + 1;
+
+	//Calculate the tilemap coordinates of all pixels first - this loop has no branches or
+	//memory lookups, which allows the compiler to vectorize it.
+	uint32_t xPos[256];
+	uint32_t yPos[256];
+	int32_t transformX = data.TransformX;
+	int32_t transformY = data.TransformY;
+	int32_t stepX = cfg.Matrix[0];
+	int32_t stepY = cfg.Matrix[2];
+	for(int k = 0; k < count; k++) {
+		xPos[k] = ((transformX + stepX * k) >> 8) & wrapMask;
+		yPos[k] = ((transformY + stepY * k) >> 8) & wrapMask;
+	}
+
+	for(int k = 0; k < count; k++) {
+		uint16_t vramAddr = layer.TilemapAddr + (yPos[k] >> 3) * columnCount + (xPos[k] >> 3);
+		data.TileIndex = _vram[vramAddr];
+		_memoryAccess[cycle + gap] |= GbaPpuMemAccess::Vram;
+		_memoryAccess[cycle + gap + 1] |= GbaPpuMemAccess::Vram;
+
+		if(data.RenderX < 240) {
+			uint8_t color = _vram[(layer.TilesetAddr + data.TileIndex * 64 + (yPos[k] & 0x07) * 8 + (xPos[k] & 0x07)) & 0xFFFF];
+			if(color != 0 && xPos[k] < screenSize && yPos[k] < screenSize) {
+				SetPixelData(_layerOutput[i][data.RenderX], color * 2, layer.Priority, i);
+			}
+		}
+		data.RenderX++;
+		cycle += 4;
+	}
+
+	data.XPos = xPos[count - 1];
+	data.YPos = yPos[count - 1];
+	data.TileRow = data.YPos & 0x07;
+	data.TileColumn = data.XPos & 0x07;
+	data.TransformX = transformX + stepX * count;
+	data.TransformY = transformY + stepY * count;
+	return cycle;
+}
+
 template<int mode>
 void GbaPpu::RenderBitmapMode()
 {
@@ -188,6 +188,7 @@ private:
 	template<int layer, bool mosaic, bool bpp8> void RenderTilemap();
 
 	template<int layer> void RenderTransformTilemap();
+	template<int layer> int RenderTransformPixels(int cycle, int end, uint16_t screenSize);
 	template<int mode> void RenderBitmapMode();
 	
 	__forceinline void SetPixelData(GbaPixelData& pixel, uint16_t color, uint8_t priority, uint8_t layer);
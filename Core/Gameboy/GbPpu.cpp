@@ -66,6 +66,8 @@ void GbPpu::Init(Emulator* emu, Gameboy* gameboy, GbMemoryManager* memoryManager
 	_isFirstFrame = true;
 	_forceBlankFrame = true;
 	_rendererIdle = false;
+	_fastScanline = false;
+	_verifyScanline = false;
 }
 
 GbPpu::~GbPpu()
@@ -103,6 +105,8 @@ uint16_t* GbPpu::GetPreviousEventViewerBuffer()
 
 void GbPpu::SetCpuStopState(bool stopped)
 {
+	InterruptFastScanline();
+
 	if(!_gameboy->IsCgb()) {
 		if(stopped) {
 			_lcdDisabled = true;
@@ -173,6 +177,10 @@ void GbPpu::ExecCycle()
 	if(_state.Mode == PpuMode::Drawing) {
 		RunDrawCycle();
 		if(_drawnPixels == 160) {
+			if(_verifyScanline) {
+				VerifyFastScanline();
+			}
+
 			//Mode turns to hblank on the same cycle as the last pixel is output
 			_state.Mode = PpuMode::HBlank;
 			_state.IrqMode = PpuMode::HBlank;
@@ -350,6 +358,9 @@ void GbPpu::ProcessVisibleScanline()
 
 		case 89:
 			_rendererIdle = false;
+			if(!_fastScanlineDisabled && CanUseFastScanline()) {
+				StartFastScanline();
+			}
 			break;
 
 		case 456:
@@ -391,6 +402,16 @@ void GbPpu::RunDrawCycle()
 		return;
 	}
 
+	if(_fastScanline) {
+		//The scanline has already been drawn, keep track of the number of pixels the pixel FIFO would have output so far
+		_drawnPixels = (int16_t)_state.Cycle - 96 - (_state.ScrollX & 0x07);
+		if(_drawnPixels == 160) {
+			_fastScanline = false;
+			SetFastScanlineEndState();
+		}
+		return;
+	}
+
 	//TODO fix/check behavior for WX=0 and WX=166
 	if(!_wxEnableFlag) {
 		_wxEnableFlag |= _drawnPixels == _state.WindowX - 7;
@@ -610,34 +631,10 @@ void GbPpu::ClockTileFetcher()
 	_evtColor = EvtColor::RenderingBgLoad;
 
 	switch(_bgFetcher.Step++) {
-		case 1: {
+		case 1:
 			//Fetch tile index
-			uint16_t tilemapAddr;
-			uint8_t yOffset;
-			if(_fetchWindow) {
-				tilemapAddr = _state.WindowTilemapSelect ? 0x1C00 : 0x1800;
-				yOffset = (uint8_t)_windowCounter;
-			} else {
-				tilemapAddr = _state.BgTilemapSelect ? 0x1C00 : 0x1800;
-				yOffset = _state.ScrollY + _state.Scanline;
-			}
-
-			uint8_t row = yOffset >> 3;
-			uint16_t tileAddr = tilemapAddr + _fetchColumn + row * 32;
-			_tileIndex = LcdReadVram(tileAddr);
-
-			uint8_t attributes = _state.CgbEnabled ? _vram[tileAddr | 0x2000] : 0;
-			bool vMirror = (attributes & 0x40) != 0;
-			uint16_t tileBank = (attributes & 0x08) ? 0x2000 : 0x0000;
-
-			uint16_t baseTile = _state.BgTileSelect ? 0 : 0x1000;
-			uint8_t tileY = vMirror ? (7 - (yOffset & 0x07)) : (yOffset & 0x07);
-			uint16_t tileRowAddr = baseTile + (baseTile ? (int8_t)_tileIndex * 16 : _tileIndex * 16) + tileY * 2;
-			tileRowAddr |= tileBank;
-			_bgFetcher.Addr = tileRowAddr;
-			_bgFetcher.Attributes = (attributes & 0xBF);
+			FetchBgTile(_bgFetcher, _tileIndex, _fetchColumn, _fetchWindow);
 			break;
-		}
 
 		case 3: {
 			//Fetch tile data (low byte)
@@ -672,6 +669,34 @@ void GbPpu::ClockTileFetcher()
 	}
 }
 
+void GbPpu::FetchBgTile(GbPpuFetcher& fetcher, uint8_t& tileIndex, uint8_t column, bool window)
+{
+	uint16_t tilemapAddr;
+	uint8_t yOffset;
+	if(window) {
+		tilemapAddr = _state.WindowTilemapSelect ? 0x1C00 : 0x1800;
+		yOffset = (uint8_t)_windowCounter;
+	} else {
+		tilemapAddr = _state.BgTilemapSelect ? 0x1C00 : 0x1800;
+		yOffset = _state.ScrollY + _state.Scanline;
+	}
+
+	uint8_t row = yOffset >> 3;
+	uint16_t tileAddr = tilemapAddr + column + row * 32;
+	tileIndex = LcdReadVram(tileAddr);
+
+	uint8_t attributes = _state.CgbEnabled ? _vram[tileAddr | 0x2000] : 0;
+	bool vMirror = (attributes & 0x40) != 0;
+	uint16_t tileBank = (attributes & 0x08) ? 0x2000 : 0x0000;
+
+	uint16_t baseTile = _state.BgTileSelect ? 0 : 0x1000;
+	uint8_t tileY = vMirror ? (7 - (yOffset & 0x07)) : (yOffset & 0x07);
+	uint16_t tileRowAddr = baseTile + (baseTile ? (int8_t)tileIndex * 16 : tileIndex * 16) + tileY * 2;
+	tileRowAddr |= tileBank;
+	fetcher.Addr = tileRowAddr;
+	fetcher.Attributes = (attributes & 0xBF);
+}
+
 void GbPpu::PushSpriteToPixelFifo()
 {
 	uint8_t spriteIndex = _fetchSprite;
@@ -719,6 +744,203 @@ void GbPpu::PushTileToPixelFifo()
 	_bgFetcher.Step = 0;
 }
 
+bool GbPpu::CanUseFastScanline()
+{
+	//When a scanline has no sprites and no window, the pixel FIFO outputs one pixel per cycle from the start of
+	//mode 3, so the whole scanline can be drawn at once and mode 3 always lasts 168 + (SCX & 7) cycles.
+	if(_emu->IsDebugging() || _gameboy->IsSgb() || _gbcTileGlitch) {
+		return false;
+	}
+
+	if(_spriteCount > 0 && (_state.SpritesEnabled || _state.CgbEnabled)) {
+		return false;
+	}
+
+	if(_state.WindowEnabled && _wyEnableFlag) {
+		return false;
+	}
+
+	if(!_gameboy->IsCgb() && !_state.WindowEnabled && _windowCounter > 0 && ((int)_state.WindowX & 0x07) == 7 - ((int)_state.ScrollX & 0x07)) {
+		//DMG window glitch could insert an extra pixel (see RunDrawCycle)
+		return false;
+	}
+
+	//SCX must not have changed since the renderer was reset at the start of mode 3
+	return _drawnPixels == -8 - (_state.ScrollX & 0x07) && _fetchColumn == _state.ScrollX / 8 && _bgFetcher.Step == 0;
+}
+
+void GbPpu::StartFastScanline()
+{
+	uint16_t* row = _currentBuffer + _state.Scanline * GbConstants::ScreenWidth;
+
+	if(_state.FrameCount % GbPpu::FastScanlineVerifyInterval == 0) {
+		//Periodically draw the scanline with both renderers, the results are compared at the end of mode 3
+		RenderFastScanline(_scanlineBuffer);
+		_verifyScanline = true;
+		return;
+	}
+
+	//Keep the previous content of the scanline, in case the fast path is interrupted before the end of the scanline
+	memcpy(_scanlineBuffer, row, sizeof(_scanlineBuffer));
+	RenderFastScanline(row);
+
+	_fastScanline = true;
+	_state.IdleCycles = 166 + (_state.ScrollX & 0x07);
+}
+
+void GbPpu::RenderFastScanline(uint16_t* out)
+{
+	GameboyConfig& cfg = _emu->GetSettings()->GetGameboyConfig();
+
+	GbPpuFetcher fetcher = {};
+	uint8_t tileIndex = 0;
+	uint8_t column = _state.ScrollX / 8;
+	int x = -(_state.ScrollX & 0x07);
+
+	while(x < (int)GbConstants::ScreenWidth) {
+		FetchBgTile(fetcher, tileIndex, column, false);
+		fetcher.LowByte = LcdReadVram(fetcher.Addr);
+		fetcher.HighByte = LcdReadVram(fetcher.Addr + 1);
+		column = (column + 1) & 0x1F;
+
+		for(int i = 0; i < 8; i++, x++) {
+			if(x < 0 || x >= (int)GbConstants::ScreenWidth) {
+				continue;
+			}
+
+			uint8_t shift = (fetcher.Attributes & 0x20) ? i : (7 - i);
+			uint8_t color = ((fetcher.LowByte >> shift) & 0x01) | (((fetcher.HighByte >> shift) & 0x01) << 1);
+
+			uint8_t colorIndex;
+			if(cfg.DisableBackground) {
+				colorIndex = _state.BgPalette & 0x03;
+			} else if(_state.CgbEnabled) {
+				colorIndex = color | ((fetcher.Attributes & 0x07) << 2);
+			} else {
+				colorIndex = _state.BgEnabled ? ((_state.BgPalette >> (color * 2)) & 0x03) : (_state.BgPalette & 0x03);
+			}
+			out[x] = LcdReadBgPalette(colorIndex) & 0x7FFF;
+		}
+	}
+}
+
+void GbPpu::SetFastScanlineEndState()
+{
+	//Put the fetcher & pixel FIFO in the state the pixel FIFO renderer leaves them in at the end of mode 3:
+	//21 tiles were pushed to the FIFO, the last one at cycle 167, and (SCX & 7) pixels were output after that
+	uint8_t fineScroll = _state.ScrollX & 0x07;
+	uint8_t firstColumn = _state.ScrollX / 8;
+
+	FetchBgTile(_bgFetcher, _tileIndex, (firstColumn + 20) & 0x1F, false);
+	_bgFetcher.LowByte = LcdReadVram(_bgFetcher.Addr);
+	_bgFetcher.HighByte = LcdReadVram(_bgFetcher.Addr + 1);
+	PushTileToPixelFifo();
+	_fetchColumn = (firstColumn + 21) & 0x1F;
+	for(int i = 0; i < fineScroll; i++) {
+		_bgFifo.Pop();
+	}
+
+	//Last pixel output (x=159)
+	GbPpuFetcher lastTile = _bgFetcher;
+	uint8_t lastTileIndex = _tileIndex;
+	if(fineScroll == 0) {
+		FetchBgTile(lastTile, lastTileIndex, (firstColumn + 19) & 0x1F, false);
+		lastTile.LowByte = LcdReadVram(lastTile.Addr);
+		lastTile.HighByte = LcdReadVram(lastTile.Addr + 1);
+	}
+	uint8_t pos = (fineScroll + 7) & 0x07;
+	uint8_t shift = (lastTile.Attributes & 0x20) ? pos : (7 - pos);
+	_lastBgColor = ((lastTile.LowByte >> shift) & 0x01) | (((lastTile.HighByte >> shift) & 0x01) << 1);
+	_lastPixelType = GbPixelType::Background;
+
+	//The fetcher has been running for (SCX & 7) cycles on the next tile
+	if(fineScroll >= 2) {
+		FetchBgTile(_bgFetcher, _tileIndex, _fetchColumn, false);
+	}
+	if(fineScroll >= 4) {
+		_bgFetcher.LowByte = LcdReadVram(_bgFetcher.Addr);
+	}
+	if(fineScroll >= 6) {
+		_bgFetcher.HighByte = LcdReadVram(_bgFetcher.Addr + 1);
+	}
+	_bgFetcher.Step = fineScroll;
+
+	_wxEnableFlag = _state.WindowX <= 166;
+	_evtColor = EvtColor::RenderingBgLoad;
+}
+
+void GbPpu::ExitFastScanline()
+{
+	//Something that can affect the rest of the scanline is about to change: run the pixel FIFO renderer over the
+	//cycles that were skipped to get it to the exact same state (this draws the same pixels again) and let it
+	//draw the rest of the scanline normally
+	_fastScanline = false;
+	_state.IdleCycles = 0;
+
+	uint8_t tileGlitch = _gbcTileGlitch;
+	_gbcTileGlitch = false;
+	_wxEnableFlag = false;
+	ResetRenderer();
+	for(int i = 89; i <= _state.Cycle; i++) {
+		RunDrawCycle();
+	}
+	_gbcTileGlitch = tileGlitch;
+
+	//Restore the pixels that have not been output yet
+	uint16_t* row = _currentBuffer + _state.Scanline * GbConstants::ScreenWidth;
+	for(int x = std::max<int>(0, _drawnPixels); x < (int)GbConstants::ScreenWidth; x++) {
+		row[x] = _scanlineBuffer[x];
+	}
+}
+
+void GbPpu::InterruptFastScanline()
+{
+	if(_fastScanline) {
+		ExitFastScanline();
+	}
+	_verifyScanline = false;
+}
+
+void GbPpu::VerifyFastScanline()
+{
+	//The pixel FIFO renderer just finished a scanline the fast path also drew, compare their output and timing
+	_verifyScanline = false;
+
+	uint16_t* row = _currentBuffer + _state.Scanline * GbConstants::ScreenWidth;
+	bool match = _state.Cycle == 256 + (_state.ScrollX & 0x07) && memcmp(row, _scanlineBuffer, sizeof(_scanlineBuffer)) == 0;
+
+	GbPpuFifo bgFifo = _bgFifo;
+	GbPpuFetcher bgFetcher = _bgFetcher;
+	uint8_t tileIndex = _tileIndex;
+	uint8_t fetchColumn = _fetchColumn;
+	bool wxEnableFlag = _wxEnableFlag;
+	GbPixelType lastPixelType = _lastPixelType;
+	uint8_t lastBgColor = _lastBgColor;
+
+	SetFastScanlineEndState();
+
+	match &= (
+		bgFetcher.Addr == _bgFetcher.Addr && bgFetcher.Attributes == _bgFetcher.Attributes && bgFetcher.Step == _bgFetcher.Step &&
+		bgFetcher.LowByte == _bgFetcher.LowByte && bgFetcher.HighByte == _bgFetcher.HighByte &&
+		bgFifo.Position == _bgFifo.Position && bgFifo.Size == _bgFifo.Size && memcmp(bgFifo.Content, _bgFifo.Content, sizeof(bgFifo.Content)) == 0 &&
+		tileIndex == _tileIndex && fetchColumn == _fetchColumn && wxEnableFlag == _wxEnableFlag &&
+		lastPixelType == _lastPixelType && lastBgColor == _lastBgColor
+	);
+
+	_bgFifo = bgFifo;
+	_bgFetcher = bgFetcher;
+	_tileIndex = tileIndex;
+	_fetchColumn = fetchColumn;
+	_wxEnableFlag = wxEnableFlag;
+	_lastPixelType = lastPixelType;
+	_lastBgColor = lastBgColor;
+
+	if(!match) {
+		MessageManager::Log("[GB] Fast scanline rendering does not match the pixel FIFO renderer (scanline " + std::to_string(_state.Scanline) + "), disabling it.");
+		_fastScanlineDisabled = true;
+	}
+}
+
 void GbPpu::UpdateStatIrq()
 {
 	bool irqFlag = (
@@ -826,6 +1048,8 @@ void GbPpu::DebugSendFrame()
 		return;
 	}
 
+	InterruptFastScanline();
+
 	int lastPixel = std::max(0, _state.IrqMode == PpuMode::HBlank ? 160 : _drawnPixels);
 	int offset = std::max(0, (int)(lastPixel + 1 + _state.Scanline * GbConstants::ScreenWidth));
 	int pixelsToClear = GbConstants::PixelCount - offset;
@@ -888,6 +1112,11 @@ uint8_t GbPpu::Read(uint16_t addr)
 
 void GbPpu::Write(uint16_t addr, uint8_t value)
 {
+	if(addr != 0xFF41 && addr != 0xFF45) {
+		//STAT/LYC writes do not affect the picture, all other registers can
+		InterruptFastScanline();
+	}
+
 	switch(addr) {
 		case 0xFF40:
 			_state.Control = value; 
@@ -1011,6 +1240,7 @@ void GbPpu::Write(uint16_t addr, uint8_t value)
 
 void GbPpu::SetTileFetchGlitchState()
 {
+	InterruptFastScanline();
 	_gbcTileGlitch = true;
 }
 
@@ -1199,6 +1429,10 @@ void GbPpu::WriteCgbRegister(uint16_t addr, uint8_t value)
 		return;
 	}
 
+	if(addr == 0xFF4C) {
+		InterruptFastScanline();
+	}
+
 	switch(addr) {
 		case 0xFF4C: _state.CgbEnabled = (value & 0x0C) == 0; break;
 		case 0xFF4F: _state.CgbVramBank = value & 0x01; break;
@@ -1257,6 +1491,11 @@ void GbPpu::WriteCgbPalette(uint8_t& pos, uint16_t* pal, bool autoInc, uint8_t v
 
 void GbPpu::Serialize(Serializer& s)
 {
+	if(s.IsSaving()) {
+		//Save states always contain the pixel FIFO renderer's state
+		InterruptFastScanline();
+	}
+
 	SV(_state.Scanline); SV(_state.Cycle); SV(_state.Mode); SV(_state.LyCompare); SV(_state.BgPalette); SV(_state.ObjPalette0); SV(_state.ObjPalette1);
 	SV(_state.ScrollX); SV(_state.ScrollY); SV(_state.WindowX); SV(_state.WindowY); SV(_state.Control); SV(_state.LcdEnabled); SV(_state.WindowTilemapSelect);
 	SV(_state.WindowEnabled); SV(_state.BgTileSelect); SV(_state.BgTilemapSelect); SV(_state.LargeSprites); SV(_state.SpritesEnabled); SV(_state.BgEnabled);
@@ -1322,6 +1561,8 @@ void GbPpu::Serialize(Serializer& s)
 		if(!_state.LcdEnabled) {
 			_lcdDisabled = true;
 		}
+		_fastScanline = false;
+		_verifyScanline = false;
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "pch.h"
 #include "Gameboy/GbTypes.h"
+#include "Gameboy/GbConstants.h"
 #include "Utilities/ISerializable.h"
 
 class Emulator;
@@ -70,6 +71,13 @@ private:
 	GbPixelType _lastPixelType = {};
 	uint8_t _lastBgColor = 0;
 
+	//Scanlines without sprites or window are drawn in a single step (see CanUseFastScanline)
+	static constexpr uint32_t FastScanlineVerifyInterval = 300;
+	bool _fastScanline = false;
+	bool _verifyScanline = false;
+	bool _fastScanlineDisabled = false;
+	uint16_t _scanlineBuffer[GbConstants::ScreenWidth] = {};
+
 	__forceinline void WriteBgPixel(uint8_t colorIndex);
 	__forceinline void WriteObjPixel(uint8_t colorIndex);
 
@@ -85,9 +93,18 @@ private:
 	void ClockSpriteFetcher();
 	void FindNextSprite();
 	__forceinline void ClockTileFetcher();
+	__forceinline void FetchBgTile(GbPpuFetcher& fetcher, uint8_t& tileIndex, uint8_t column, bool window);
 	__forceinline void PushSpriteToPixelFifo();
 	__forceinline void PushTileToPixelFifo();
 
+	bool CanUseFastScanline();
+	void StartFastScanline();
+	void RenderFastScanline(uint16_t* out);
+	void SetFastScanlineEndState();
+	void ExitFastScanline();
+	void VerifyFastScanline();
+	__forceinline void InterruptFastScanline();
+
 	void UpdateStatIrq();
 
 	__forceinline uint8_t LcdReadOam(uint8_t addr);
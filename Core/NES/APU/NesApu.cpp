@@ -286,6 +286,11 @@ uint16_t NesApu::GetDmcReadAddress()
 	return _dmc->GetDmcReadAddress();
 }
 
+bool NesApu::IsDmcActive()
+{
+	return _dmc->GetStatus();
+}
+
 void NesApu::SetDmcReadBuffer(uint8_t value)
 {
 	_dmc->SetDmcReadBuffer(value);
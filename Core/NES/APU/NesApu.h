@@ -73,6 +73,7 @@ public:
 	bool IsApuEnabled();
 	static ConsoleRegion GetApuRegion(NesConsole* console);
 	uint16_t GetDmcReadAddress();
+	bool IsDmcActive();
 	void SetDmcReadBuffer(uint8_t value);
 	void SetNeedToRun();
 };
\ No newline at end of file
@@ -180,6 +180,16 @@ void BaseMapper::SetCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr, uint8
 
 		sourceOffset += 0x100;
 	}
+
+	UpdateDirectReadPages(startAddr, endAddr);
+}
+
+void BaseMapper::UpdateDirectReadPages(uint16_t firstPage, uint16_t lastPage)
+{
+	NesMemoryManager* memoryManager = _console->GetMemoryManager();
+	if(memoryManager) {
+		memoryManager->UpdateMapperPages(this, firstPage, lastPage);
+	}
 }
 
 void BaseMapper::RemoveCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr)
@@ -531,6 +541,20 @@ bool BaseMapper::HasChrRom()
 	return _chrRomSize > 0;
 }
 
+void BaseMapper::UpdateReadRegisterPages(uint16_t firstPage, uint16_t lastPage)
+{
+	for(int page = firstPage; page <= lastPage; page++) {
+		_isReadRegisterPage[page] = false;
+		for(int i = 0; i < 0x100; i++) {
+			if(_isReadRegisterAddr[(page << 8) | i]) {
+				_isReadRegisterPage[page] = true;
+				break;
+			}
+		}
+	}
+	UpdateDirectReadPages(firstPage, lastPage);
+}
+
 void BaseMapper::AddRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOperation operation)
 {
 	for(int i = startAddr; i <= endAddr; i++) {
@@ -541,6 +565,10 @@ void BaseMapper::AddRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOp
 			_isWriteRegisterAddr[i] = true;
 		}
 	}
+
+	if((int)operation & (int)MemoryOperation::Read) {
+		UpdateReadRegisterPages(startAddr >> 8, endAddr >> 8);
+	}
 }
 
 void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOperation operation)
@@ -553,6 +581,10 @@ void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, Memor
 			_isWriteRegisterAddr[i] = false;
 		}
 	}
+
+	if((int)operation & (int)MemoryOperation::Read) {
+		UpdateReadRegisterPages(startAddr >> 8, endAddr >> 8);
+	}
 }
 
 void BaseMapper::Serialize(Serializer& s)
@@ -633,9 +665,11 @@ void BaseMapper::Initialize(NesConsole* console, RomData& romData)
 	_allowRegisterRead = AllowRegisterRead();
 	_hasCpuClockHook = EnableCpuClockHook();
 	_hasCustomReadVram = EnableCustomVramRead();
+	_hasCustomReadRam = EnableCustomCpuRead();
 	_hasVramAddressHook = EnableVramAddressHook();
 
 	memset(_isReadRegisterAddr, 0, sizeof(_isReadRegisterAddr));
+	memset(_isReadRegisterPage, 0, sizeof(_isReadRegisterPage));
 	memset(_isWriteRegisterAddr, 0, sizeof(_isWriteRegisterAddr));
 	AddRegisterRange(RegisterStartAddress(), RegisterEndAddress(), MemoryOperation::Any);
 
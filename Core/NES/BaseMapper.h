@@ -28,6 +28,8 @@ private:
 	uint16_t InternalGetChrRomPageSize();
 	uint16_t InternalGetChrRamPageSize();
 	bool ValidateAddressRange(uint16_t startAddr, uint16_t endAddr);
+	void UpdateDirectReadPages(uint16_t firstPage, uint16_t lastPage);
+	void UpdateReadRegisterPages(uint16_t firstPage, uint16_t lastPage);
 
 	uint8_t *_nametableRam = nullptr;
 	uint8_t _nametableCount = 2;
@@ -39,11 +41,13 @@ private:
 	bool _hasDefaultWorkRam = false;
 	
 	bool _hasCustomReadVram = false;
+	bool _hasCustomReadRam = false;
 	bool _hasCpuClockHook = false;
 	bool _hasVramAddressHook = false;
 
 	bool _allowRegisterRead = false;
 	bool _isReadRegisterAddr[0x10000] = {};
+	bool _isReadRegisterPage[0x100] = {};
 	bool _isWriteRegisterAddr[0x10000] = {};
 
 	MemoryAccessType _prgMemoryAccess[0x100] = {};
@@ -115,6 +119,7 @@ protected:
 
 	virtual bool EnableCpuClockHook() { return false; }
 	virtual bool EnableCustomVramRead() { return false; }
+	virtual bool EnableCustomCpuRead() { return false; }
 	virtual bool EnableVramAddressHook() { return false; }
 
 	virtual uint32_t GetDipSwitchCount() { return 0; }
@@ -222,6 +227,19 @@ public:
 	uint32_t GetMapperDipSwitchCount();
 
 	uint8_t ReadRam(uint16_t addr) override;
+
+	//Returns the PRG page that the CPU can read directly without calling ReadRam (nullptr if reading has side effects, or is open bus)
+	__forceinline uint8_t* GetDirectReadPage(uint8_t page)
+	{
+		if(_hasCustomReadRam || !(_prgMemoryAccess[page] & MemoryAccessType::Read) || (_allowRegisterRead && _isReadRegisterPage[page])) {
+			return nullptr;
+		}
+		return _prgPages[page];
+	}
+
+	//Returns false for mapper-specific RAM, which the mapper itself can modify
+	bool IsCpuOwnedPage(uint8_t page) { return _prgMemoryType[page] != PrgMemoryType::MapperRam; }
+
 	uint8_t PeekRam(uint16_t addr) override;
 	uint8_t DebugReadRam(uint16_t addr);
 	void WriteRam(uint16_t addr, uint8_t value) override;
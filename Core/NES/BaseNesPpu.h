@@ -130,6 +130,17 @@ public:
 	int32_t GetScanlineCount() { return _vblankEnd + 2; }
 	uint32_t GetFrameCycle() { return ((_scanline + 1) * 341) + _cycle; }
 
+	//Returns the master clock up to which the PPU can run without leaving the visible scanlines (0 outside of them).
+	//Nothing the PPU does before the post-render scanline can trigger an NMI or end the frame.
+	uint64_t GetVisibleScanlinesEndClock()
+	{
+		if(_scanline < 0 || _scanline >= 240) {
+			return 0;
+		}
+		uint32_t dots = (239 - _scanline) * 341 + (340 - _cycle);
+		return _masterClock + (uint64_t)dots * _masterClockDivider;
+	}
+
 	virtual uint16_t* GetScreenBuffer(bool previousBuffer, bool processGrayscaleEmphasisBits = false) = 0;
 	virtual void UpdateTimings(ConsoleRegion region, bool overclockAllowed = true) = 0;
 
@@ -18,7 +18,7 @@ HdAudioDevice::HdAudioDevice(Emulator* emu, HdPackData* hdData)
 	_sfxVolume = 128;
 	_bgmVolume = 128;
 
-	_oggMixer.reset(new OggMixer());
+	_oggMixer.reset(new OggMixer(_emu->GetSoundMixer()->GetAudioStreamService()));
 	_oggMixer->SetBgmVolume(_bgmVolume);
 	_oggMixer->SetSfxVolume(_sfxVolume);
 	_emu->GetSoundMixer()->RegisterAudioProvider(_oggMixer.get());
@@ -9,8 +9,9 @@ enum class OggPlaybackOptions
 	Loop = 0x01
 };
 
-OggMixer::OggMixer()
+OggMixer::OggMixer(AudioStreamService* streamService)
 {
+	_streamService = streamService;
 }
 
 void OggMixer::Reset(uint32_t sampleRate)
@@ -82,7 +83,7 @@ void OggMixer::SetSampleRate(int sampleRate)
 
 bool OggMixer::Play(string filename, bool isSfx, uint32_t startOffset, uint32_t loopPosition)
 {
-	shared_ptr<OggReader> reader(new OggReader());
+	shared_ptr<OggReader> reader(new OggReader(_streamService));
 	bool loop = !isSfx && (_options & (int)OggPlaybackOptions::Loop) != 0;
 	if(reader->Init(filename, loop, _sampleRate, startOffset, loopPosition)) {
 		if(isSfx) {
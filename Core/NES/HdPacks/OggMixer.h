@@ -3,10 +3,12 @@
 #include "Shared/Interfaces/IAudioProvider.h"
 
 class OggReader;
+class AudioStreamService;
 
 class OggMixer : public IAudioProvider
 {
 private:
+	AudioStreamService* _streamService = nullptr;
 	shared_ptr<OggReader> _bgm;
 	vector<shared_ptr<OggReader>> _sfx;
 
@@ -17,7 +19,7 @@ private:
 	bool _paused = false;
 
 public:
-	OggMixer();
+	OggMixer(AudioStreamService* streamService);
 	virtual ~OggMixer() = default;
 
 	void SetSampleRate(int sampleRate);
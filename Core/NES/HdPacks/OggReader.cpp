@@ -1,49 +1,97 @@
 #include "pch.h"
 #include "NES/HdPacks/OggReader.h"
+#include "Shared/Audio/AudioStream.h"
+#include "Shared/Audio/AudioStreamService.h"
 #include "Utilities/Audio/stb_vorbis.h"
 
-OggReader::OggReader()
+OggStreamDecoder::OggStreamDecoder(string filename, uint32_t loopPosition)
 {
-	_done = false;
-	_oggBuffer = new int16_t[10000];
-	_outputBuffer = new int16_t[2000];
+	_filename = filename;
+	_loopPosition = loopPosition;
 }
 
-OggReader::~OggReader()
+OggStreamDecoder::~OggStreamDecoder()
 {
-	delete[] _oggBuffer;
-	delete[] _outputBuffer;
-
 	if(_vorbis) {
 		stb_vorbis_close(_vorbis);
 	}
 }
 
-bool OggReader::Init(string filename, bool loop, uint32_t sampleRate, uint32_t startOffset, uint32_t loopPosition)
+bool OggStreamDecoder::Open()
 {
 	int error;
-	VirtualFile file = filename;
-	_fileData = vector<uint8_t>(100000);
+	VirtualFile file = _filename;
 	if(file.ReadFile(_fileData)) {
 		_vorbis = stb_vorbis_open_memory(_fileData.data(), (int)_fileData.size(), &error, nullptr);
 		if(_vorbis) {
-			_loop = loop;
-			if(loopPosition > 0) {
-				unsigned int sampleCount = stb_vorbis_stream_length_in_samples(_vorbis);
-				_loopPosition = loopPosition < sampleCount ? loopPosition : 0;
-			} else {
+			_frameCount = stb_vorbis_stream_length_in_samples(_vorbis);
+			if(_loopPosition >= _frameCount) {
 				_loopPosition = 0;
 			}
-			_oggSampleRate = stb_vorbis_get_info(_vorbis).sample_rate;
-			if(startOffset > 0) {
-				stb_vorbis_seek(_vorbis, startOffset);
-			}
+			_sampleRate = stb_vorbis_get_info(_vorbis).sample_rate;
 			return true;
 		}
 	}
 	return false;
 }
 
+uint32_t OggStreamDecoder::Decode(int16_t* out, uint32_t frameCount)
+{
+	return (uint32_t)stb_vorbis_get_samples_short_interleaved(_vorbis, 2, out, frameCount * 2);
+}
+
+bool OggStreamDecoder::Seek(uint32_t frame)
+{
+	return stb_vorbis_seek(_vorbis, frame) != 0;
+}
+
+OggReader::OggReader(AudioStreamService* streamService)
+{
+	_streamService = streamService;
+	_done = false;
+	_oggBuffer = new int16_t[OggReader::OggBufferSize];
+	_outputBuffer = new int16_t[2000];
+}
+
+OggReader::~OggReader()
+{
+	delete[] _oggBuffer;
+	delete[] _outputBuffer;
+}
+
+bool OggReader::IsVorbisFile(VirtualFile& file)
+{
+	//Only the start of the file is read (and decompressed, for archives), the rest is loaded by the stream service's thread
+	vector<uint8_t> data;
+	file.ReadFilePrefix(data, 512);
+
+	//The first Ogg page must start a stream and contain the Vorbis identification header
+	if(data.size() < 27 || memcmp(data.data(), "OggS", 4) != 0 || !(data[5] & 0x02)) {
+		return false;
+	}
+
+	size_t pos = 27 + data[26];
+	if(data.size() < pos + 16 || data[pos] != 0x01 || memcmp(data.data() + pos + 1, "vorbis", 6) != 0) {
+		return false;
+	}
+
+	uint32_t version = data[pos + 7] | (data[pos + 8] << 8) | (data[pos + 9] << 16) | (data[pos + 10] << 24);
+	uint8_t channels = data[pos + 11];
+	uint32_t sampleRate = data[pos + 12] | (data[pos + 13] << 8) | (data[pos + 14] << 16) | (data[pos + 15] << 24);
+	return version == 0 && channels > 0 && sampleRate > 0;
+}
+
+bool OggReader::Init(string filename, bool loop, uint32_t sampleRate, uint32_t startOffset, uint32_t loopPosition)
+{
+	//Only check the file's header here, reading and decoding is done on the stream service's thread
+	VirtualFile file = filename;
+	if(IsVorbisFile(file)) {
+		_stream = _streamService->Open(std::make_unique<OggStreamDecoder>(filename, loopPosition), startOffset, loop);
+		return true;
+	}
+	return false;
+}
+
 bool OggReader::IsPlaybackOver()
 {
 	return _done;
@@ -58,27 +106,27 @@ void OggReader::SetSampleRate(int sampleRate)
 
 void OggReader::SetLoopFlag(bool loop)
 {
-	_loop = loop;
+	if(_stream) {
+		_stream->SetLoop(loop);
+	}
 }
 
 void OggReader::ApplySamples(int16_t* buffer, size_t sampleCount, uint8_t volume)
 {
+	if(!_stream) {
+		return;
+	}
+
 	int32_t samplesNeeded = (int32_t)sampleCount - _resampler.GetPendingCount();
+	uint32_t oggSampleRate = _stream->GetSampleRate();
 	uint32_t samplesRead = 0;
-	if(samplesNeeded > 0) {
-		uint32_t samplesToLoad = samplesNeeded * _oggSampleRate / _sampleRate + 2;
-		uint32_t samplesLoaded = (uint32_t)stb_vorbis_get_samples_short_interleaved(_vorbis, 2, _oggBuffer, samplesToLoad * 2);
-		if(samplesLoaded < samplesToLoad) {
-			if(_loop) {
-				stb_vorbis_seek(_vorbis, _loopPosition);
-				samplesLoaded += stb_vorbis_get_samples_short_interleaved(_vorbis, 2, _oggBuffer + samplesLoaded * 2, (samplesToLoad - samplesLoaded) * 2);
-			} else {
-				_done = true;
-			}
-		}
-		_resampler.SetSampleRates(_oggSampleRate, _sampleRate);
+	if(samplesNeeded > 0 && oggSampleRate > 0) {
+		uint32_t samplesToLoad = std::min<uint32_t>(samplesNeeded * oggSampleRate / _sampleRate + 2, OggReader::OggBufferSize / 2);
+		uint32_t samplesLoaded = _stream->Read(_oggBuffer, samplesToLoad);
+		_resampler.SetSampleRates(oggSampleRate, _sampleRate);
 		samplesRead = _resampler.Resample<false>(_oggBuffer, samplesLoaded, _outputBuffer, sampleCount);
 	}
+	_done = _stream->IsPlaybackOver();
 	
 	uint32_t samplesToProcess = (uint32_t)samplesRead * 2;
 	for(uint32_t i = 0; i < samplesToProcess; i++) {
@@ -88,5 +136,5 @@ void OggReader::ApplySamples(int16_t* buffer, size_t sampleCount, uint8_t volume
 
 uint32_t OggReader::GetOffset()
 {
-	return stb_vorbis_get_file_offset(_vorbis);
-}
\ No newline at end of file
+	return _stream ? _stream->GetPosition() : 0;
+}
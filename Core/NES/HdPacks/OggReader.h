@@ -1,31 +1,58 @@
 #pragma once
 #include "pch.h"
+#include "Shared/Interfaces/IAudioStreamDecoder.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/Audio/HermiteResampler.h"
 
 struct stb_vorbis;
+class AudioStream;
+class AudioStreamService;
 
-class OggReader
+class OggStreamDecoder final : public IAudioStreamDecoder
 {
 private:
+	string _filename;
 	stb_vorbis* _vorbis = nullptr;
+	vector<uint8_t> _fileData;
+
+	uint32_t _frameCount = 0;
+	uint32_t _loopPosition = 0;
+	uint32_t _sampleRate = 0;
+
+public:
+	OggStreamDecoder(string filename, uint32_t loopPosition);
+	~OggStreamDecoder();
+
+	bool Open() override;
+	uint32_t Decode(int16_t* out, uint32_t frameCount) override;
+	bool Seek(uint32_t frame) override;
+
+	uint32_t GetSampleRate() override { return _sampleRate; }
+	uint32_t GetFrameCount() override { return _frameCount; }
+	uint32_t GetLoopFrame() override { return _loopPosition; }
+};
+
+class OggReader
+{
+private:
+	static constexpr uint32_t OggBufferSize = 10000;
+
+	AudioStreamService* _streamService = nullptr;
+	shared_ptr<AudioStream> _stream;
+
 	int16_t* _outputBuffer = nullptr;
 	int16_t* _oggBuffer = nullptr;
 
 	HermiteResampler _resampler;
 
-	bool _loop = false;
 	bool _done = false;
-	
-	uint32_t _loopPosition = 0;
 
 	int _sampleRate = 0;
-	int _oggSampleRate = 0;
 
-	vector<uint8_t> _fileData;
+	bool IsVorbisFile(VirtualFile& file);
 
 public:
-	OggReader();
+	OggReader(AudioStreamService* streamService);
 	~OggReader();
 
 	bool Init(string filename, bool loop, uint32_t sampleRate, uint32_t startOffset = 0, uint32_t loopPosition = 0);
@@ -88,6 +88,7 @@ protected:
 	uint16_t RegisterEndAddress() override { return 0x4092; }
 	bool AllowRegisterRead() override { return true; }
 	bool EnableCpuClockHook() override { return true; }
+	bool EnableCustomCpuRead() override { return true; }
 
 	void InitMapper() override;
 	void InitMapper(RomData &romData) override;
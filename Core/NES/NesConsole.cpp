@@ -265,6 +265,10 @@ void NesConsole::RunFrame()
 
 	uint32_t frame = _ppu->GetFrameCount();
 
+	//Idle loop skipping relies on memory only being changed by the CPU (cheats refresh RAM, and the VS DualSystem shares RAM between both CPUs)
+	bool skipIdleLoops = _emu->GetSettings()->GetGameConfig().SkipIdleLoops && !_vsSubConsole && !_emu->GetCheatManager()->HasCheats<CpuType::Nes>();
+	_cpu->SetIdleLoopSkipEnabled(skipIdleLoops);
+
 	if(_nextFrameOverclockDisabled) {
 		//Disable overclocking for the next frame
 		//This is used by the DMC when a sample is playing
@@ -382,6 +386,14 @@ uint64_t NesConsole::GetMasterClock()
 	return _cpu->GetCycleCount();
 }
 
+IdleLoopStats NesConsole::GetIdleLoopStats()
+{
+	IdleLoopStats stats = {};
+	stats.SkippedCycles = _cpu->GetIdleLoopSkippedCycles();
+	stats.CpuCycles = _cpu->GetCycleCount();
+	return stats;
+}
+
 uint32_t NesConsole::GetMasterClockRate()
 {
 	return NesConstants::GetClockRate(_region);
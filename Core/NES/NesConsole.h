@@ -105,6 +105,7 @@ public:
 	void GetConsoleState(BaseState& state, ConsoleType consoleType) override;
 
 	uint64_t GetMasterClock() override;
+	IdleLoopStats GetIdleLoopStats() override;
 	uint32_t GetMasterClockRate() override;
 
 	void SaveBattery() override;
@@ -7,6 +7,7 @@
 #include "NES/NesPpu.h"
 #include "NES/APU/NesApu.h"
 #include "NES/NesMemoryManager.h"
+#include "NES/BaseMapper.h"
 #include "NES/NesControlManager.h"
 #include "NES/NesConsole.h"
 #include "Shared/MessageManager.h"
@@ -95,6 +96,7 @@ void NesCpu::Reset(bool softReset, ConsoleRegion region)
 	_isDmcDmaRead = false;
 	_cpuWrite = false;
 	_lastCrashWarning = 0;
+	_idleLoop.Reset();
 
 	//Use _memoryManager->Read() directly to prevent clocking the PPU/APU when setting PC at reset
 	_state.PC = _memoryManager->Read(NesCpu::ResetVector) | _memoryManager->Read(NesCpu::ResetVector+1) << 8;
@@ -168,16 +170,136 @@ void NesCpu::Exec()
 {
 #ifndef DUMMYCPU
 	_emu->ProcessInstruction<CpuType::Nes>();
+
+	bool skipIdleLoops = _skipIdleLoops;
+	uint16_t startPc = _state.PC;
+	if(skipIdleLoops) {
+		if(_emu->IsDebugging()) {
+			//Memory may be changed by the debugger
+			_idleLoop.Reset();
+			skipIdleLoops = false;
+		} else {
+			if(_idleLoop.IsSkipping() && SkipIdleLoopInstruction()) {
+				return;
+			}
+			_idleLoop.BeginInstruction(_state);
+		}
+	}
 #endif
 
 	uint8_t opCode = GetOPCode();
 	_instAddrMode = _addrMode[opCode];
 	_operand = FetchOperand();
 	(this->*_opTable[opCode])();
-	
+
+#ifndef DUMMYCPU
+	if(skipIdleLoops) {
+		//Loops end with a branch or a JMP (absolute)
+		_idleLoop.EndInstruction(startPc, _instAddrMode == NesAddrMode::Rel || opCode == 0x4C, _state, _memoryManager->GetDirectPageGeneration());
+	}
+#endif
+
+	if(_prevRunIrq || _prevNeedNmi) {
+		IRQ();
+	}
+}
+
+bool NesCpu::SkipIdleLoopInstruction()
+{
+	NesIdleLoop::Instruction* inst = _idleLoop.GetNextInstruction(_state.PC, _memoryManager->GetDirectPageGeneration());
+	if(!inst) {
+		return false;
+	}
+
+	if(_idleLoop.IsAtLoopStart()) {
+		FastForwardIdleLoop();
+	}
+
+	//Run the instruction's bus cycles without decoding it or reading memory (the values read are known to be the same as in the recorded iteration)
+	uint32_t pageGeneration = _memoryManager->GetDirectPageGeneration();
+	bool exitLoop = false;
+	for(uint8_t i = 0; i < inst->CycleCount; i++) {
+		NesIdleLoop::Cycle& cycle = _idleLoop.GetCycle(inst->FirstCycle + i);
+		if(cycle.BranchIrqCheck && _runIrq && !_prevRunIrq) {
+			_runIrq = false;
+		}
+
+		if(exitLoop || _needHalt) {
+			//A DMA is pending - run the remaining cycles normally and stop skipping after this instruction
+			exitLoop = true;
+			MemoryRead(cycle.Addr, cycle.Type);
+		} else {
+			StartCpuCycle(true);
+			if(pageGeneration != _memoryManager->GetDirectPageGeneration()) {
+				//The mapper changed the memory mappings while clocking, do the actual read and stop skipping after this instruction
+				exitLoop = true;
+				_memoryManager->Read(cycle.Addr, cycle.Type);
+			} else {
+				//The value on the bus is the same as the one read in the recorded iteration
+				_memoryManager->SetOpenBus(cycle.Value);
+			}
+			EndCpuCycle(true);
+			_idleLoopSkippedCycles++;
+		}
+	}
+
+	_idleLoop.Advance(_state);
+	if(exitLoop) {
+		_idleLoop.Reset();
+	}
+
 	if(_prevRunIrq || _prevNeedNmi) {
 		IRQ();
 	}
+	return true;
+}
+
+void NesCpu::FastForwardIdleLoop()
+{
+	//Skips whole loop iterations at once, up to the end of the visible scanlines (the next point where an NMI can occur).
+	//This is only done when nothing else can interrupt the loop before then: IRQs are masked for the whole loop,
+	//no NMI or DMA is pending, the DMC is idle (no DMA can start) and the mapper has no CPU clock hook.
+	//PRG mappings can only be changed by CPU writes and CPU clock hooks, so the recorded reads stay valid.
+	if(!_idleLoop.IsIrqMasked() || _needHalt || _needNmi || _prevNeedNmi || _state.NmiFlag != _prevNmiFlag) {
+		return;
+	}
+
+	if(_console->GetMapper()->HasCpuClockHook() || _console->GetApu()->IsDmcActive()) {
+		return;
+	}
+
+	uint64_t endClock = _console->GetPpu()->GetVisibleScanlinesEndClock();
+	uint64_t ppuClock = _masterClock - _ppuOffset;
+	uint64_t iterationClocks = (uint64_t)_idleLoop.GetIterationCycleCount() * (_startClockCount + _endClockCount);
+	if(endClock <= ppuClock || iterationClocks == 0) {
+		return;
+	}
+
+	uint64_t iterations = (endClock - ppuClock) / iterationClocks;
+	if(iterations == 0) {
+		return;
+	}
+
+	//The PPU and APU still process every cycle, but the CPU no longer needs to synchronize with them after each bus access
+	uint32_t cycleCount = (uint32_t)(iterations * _idleLoop.GetIterationCycleCount());
+	for(uint32_t i = 0; i < cycleCount; i++) {
+		_console->ProcessCpuClock();
+	}
+	_state.CycleCount += cycleCount;
+	_masterClock += iterations * iterationClocks;
+	_console->GetPpu()->Run(_masterClock - _ppuOffset);
+	_idleLoopSkippedCycles += cycleCount;
+
+	_memoryManager->SetOpenBus(_idleLoop.GetLastCycleValue());
+
+	//Same interrupt line polling as the end of the last skipped cycle (see EndCpuCycle)
+	_prevNeedNmi = _needNmi;
+	if(!_prevNmiFlag && _state.NmiFlag) {
+		_needNmi = true;
+	}
+	_prevNmiFlag = _state.NmiFlag;
+	_runIrq = ((_state.IrqFlag & _irqMask) > 0 && !CheckFlag(PSFlags::Interrupt));
+	_prevRunIrq = _runIrq;
 }
 
 void NesCpu::IRQ() 
@@ -186,6 +308,8 @@ void NesCpu::IRQ()
 	uint16_t originalPc = PC();
 #endif
 
+	_idleLoop.Reset();
+
 	DummyRead();  //fetch opcode (and discard it - $00 (BRK) is forced into the opcode register instead)
 	DummyRead();  //read next instruction byte (actually the same as above, since PC increment is suppressed. Also discarded.)
 	Push((uint16_t)(PC()));
@@ -238,6 +362,9 @@ void NesCpu::MemoryWrite(uint16_t addr, uint8_t value, MemoryOperationType opera
 #ifdef DUMMYCPU
 	LogMemoryOperation(addr, value, operationType);
 #else
+	if(_skipIdleLoops) {
+		_idleLoop.Reset();
+	}
 	_cpuWrite = true;
 	StartCpuCycle(false);
 	_memoryManager->Write(addr, value, operationType);
@@ -258,6 +385,10 @@ uint8_t NesCpu::MemoryRead(uint16_t addr, MemoryOperationType operationType)
 	StartCpuCycle(true);
 	uint8_t value = _memoryManager->Read(addr, operationType);
 	EndCpuCycle(true);
+
+	if(_idleLoop.IsRecording()) {
+		_idleLoop.RecordRead(addr, value, operationType, _memoryManager->IsStableRead(addr));
+	}
 	return value;
 #endif
 }
@@ -340,6 +471,8 @@ void NesCpu::ProcessPendingDma(uint16_t readAddress)
 		return;
 	}
 
+	_idleLoop.Reset();
+
 	uint16_t prevReadAddress = readAddress;
 	bool enableInternalRegReads = (readAddress & 0xFFE0) == 0x4000;
 	bool skipFirstInputClock = false;
@@ -606,4 +739,8 @@ void NesCpu::Serialize(Serializer &s)
 		SV(_prevNmiFlag);
 		SV(_needNmi);
 	}
+
+	if(!s.IsSaving()) {
+		_idleLoop.Reset();
+	}
 }
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include "pch.h"
 #include "Utilities/ISerializable.h"
 #include "NesTypes.h"
+#include "NES/NesIdleLoop.h"
 #include "Shared/MemoryOperationType.h"
 
 enum class ConsoleRegion;
@@ -62,12 +63,18 @@ private:
 	uint64_t _lastCrashWarning = 0;
 	bool _isDmcDmaRead = false;
 
+	NesIdleLoop _idleLoop;
+	bool _skipIdleLoops = false;
+	uint64_t _idleLoopSkippedCycles = 0;
+
 	__forceinline void StartCpuCycle(bool forRead);
 	__forceinline void ProcessPendingDma(uint16_t readAddress);
 	uint8_t ProcessDmaRead(uint16_t addr, uint16_t& prevReadAddress, bool enableInternalRegReads, bool isNesBehavior);
 	__forceinline uint16_t FetchOperand();
 	__forceinline void EndCpuCycle(bool forRead);
 	void IRQ();
+	bool SkipIdleLoopInstruction();
+	void FastForwardIdleLoop();
 
 	uint8_t GetOPCode()
 	{
@@ -437,6 +444,11 @@ private:
 			if(_runIrq && !_prevRunIrq) {
 				_runIrq = false;
 			}
+#ifndef DUMMYCPU
+			if(_idleLoop.IsRecording()) {
+				_idleLoop.RecordBranchIrqCheck();
+			}
+#endif
 			DummyRead();
 
 			if(CheckPageCrossed(PC(), offset)) {
@@ -792,6 +804,16 @@ public:
 	void StopDmcTransfer();
 
 	bool IsCpuWrite() { return _cpuWrite; }
+
+	void SetIdleLoopSkipEnabled(bool enabled)
+	{
+		if(enabled != _skipIdleLoops) {
+			//Memory may have been changed by the debugger, cheats, etc. while disabled
+			_idleLoop.Reset();
+			_skipIdleLoops = enabled;
+		}
+	}
+	uint64_t GetIdleLoopSkippedCycles() { return _idleLoopSkippedCycles; }
 	bool IsDmcDma() { return _isDmcDmaRead; }
 
 	void Reset(bool softReset, ConsoleRegion region);
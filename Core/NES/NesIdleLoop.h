@@ -0,0 +1,176 @@
+#pragma once
+#include "pch.h"
+#include "NES/NesTypes.h"
+#include "Shared/MemoryOperationType.h"
+
+//Detects short polling loops (e.g "loop: LDA $10 / BEQ loop") that have no side effects.
+//A loop is recorded for one iteration, starting after a short backward jump. If the iteration
+//only read side effect-free memory (internal RAM, PRG ROM/RAM), wrote nothing and ended with
+//the exact same CPU registers it started with, every following iteration is guaranteed to be
+//identical until an interrupt or DMA occurs. The CPU can then replay the recorded bus cycles
+//(which still clock the PPU/APU/mapper normally) without decoding the instructions again.
+//When IRQs are masked and nothing else can interrupt the loop, whole iterations are skipped at once
+//up to the end of the visible scanlines (see NesCpu::FastForwardIdleLoop).
+class NesIdleLoop
+{
+public:
+	struct Cycle
+	{
+		uint16_t Addr;
+		uint8_t Value;
+		MemoryOperationType Type;
+
+		//A taken branch checks the IRQ line before its dummy read (see NesCpu::BranchRelative)
+		bool BranchIrqCheck;
+	};
+
+	struct Instruction
+	{
+		uint16_t PC;
+		uint8_t SP;
+		uint8_t A;
+		uint8_t X;
+		uint8_t Y;
+		uint8_t PS;
+		uint8_t FirstCycle;
+		uint8_t CycleCount;
+	};
+
+private:
+	static constexpr uint16_t MaxLoopSize = 0x20;
+	static constexpr uint8_t MaxInstructions = 8;
+	static constexpr uint8_t MaxCycles = 32;
+
+	enum class LoopState : uint8_t
+	{
+		None,
+		Recording,
+		Skipping
+	};
+
+	LoopState _state = LoopState::None;
+	uint16_t _loopStart = 0;
+	uint32_t _pageGeneration = 0;
+	bool _branchIrqCheck = false;
+
+	Instruction _instructions[MaxInstructions] = {};
+	uint8_t _instructionCount = 0;
+	uint8_t _index = 0;
+
+	Cycle _cycles[MaxCycles] = {};
+	uint8_t _cycleCount = 0;
+
+	//True when every instruction in the loop runs with the I flag set (IRQs can't interrupt it)
+	bool _irqMasked = false;
+
+public:
+	void Reset()
+	{
+		_state = LoopState::None;
+	}
+
+	bool IsRecording() { return _state == LoopState::Recording; }
+	bool IsSkipping() { return _state == LoopState::Skipping; }
+	bool IsAtLoopStart() { return _index == 0; }
+	bool IsIrqMasked() { return _irqMasked; }
+	uint8_t GetIterationCycleCount() { return _cycleCount; }
+	uint8_t GetLastCycleValue() { return _cycles[_cycleCount - 1].Value; }
+
+	void BeginInstruction(NesCpuState& state)
+	{
+		if(_state != LoopState::Recording) {
+			return;
+		}
+
+		if(_instructionCount == MaxInstructions) {
+			_state = LoopState::None;
+			return;
+		}
+
+		Instruction& inst = _instructions[_instructionCount++];
+		inst.PC = state.PC;
+		inst.SP = state.SP;
+		inst.A = state.A;
+		inst.X = state.X;
+		inst.Y = state.Y;
+		inst.PS = state.PS;
+		inst.FirstCycle = _cycleCount;
+		inst.CycleCount = 0;
+		_branchIrqCheck = false;
+	}
+
+	void RecordRead(uint16_t addr, uint8_t value, MemoryOperationType type, bool sideEffectFree)
+	{
+		if(!sideEffectFree || _instructionCount == 0 || _cycleCount == MaxCycles) {
+			_state = LoopState::None;
+			return;
+		}
+
+		_cycles[_cycleCount++] = { addr, value, type, _branchIrqCheck };
+		_instructions[_instructionCount - 1].CycleCount++;
+		_branchIrqCheck = false;
+	}
+
+	void RecordBranchIrqCheck()
+	{
+		_branchIrqCheck = true;
+	}
+
+	void EndInstruction(uint16_t startPc, bool isJump, NesCpuState& state, uint32_t pageGeneration)
+	{
+		bool isBackwardJump = isJump && state.PC <= startPc && startPc - state.PC < NesIdleLoop::MaxLoopSize;
+		if(!isBackwardJump) {
+			return;
+		}
+
+		if(_state == LoopState::Recording && state.PC == _loopStart && _instructionCount > 0 && pageGeneration == _pageGeneration) {
+			Instruction& first = _instructions[0];
+			if(state.SP == first.SP && state.A == first.A && state.X == first.X && state.Y == first.Y && state.PS == first.PS) {
+				//The iteration ended in the same state it started in, the loop can be replayed
+				_state = LoopState::Skipping;
+				_index = 0;
+				_irqMasked = true;
+				for(uint8_t i = 0; i < _instructionCount; i++) {
+					_irqMasked &= (_instructions[i].PS & PSFlags::Interrupt) != 0;
+				}
+				return;
+			}
+		}
+
+		_state = LoopState::Recording;
+		_loopStart = state.PC;
+		_pageGeneration = pageGeneration;
+		_instructionCount = 0;
+		_cycleCount = 0;
+	}
+
+	//Returns the next instruction to replay, or nullptr if the loop can no longer be skipped
+	Instruction* GetNextInstruction(uint16_t pc, uint32_t pageGeneration)
+	{
+		Instruction& inst = _instructions[_index];
+		if(inst.PC != pc || pageGeneration != _pageGeneration) {
+			_state = LoopState::None;
+			return nullptr;
+		}
+		return &inst;
+	}
+
+	Cycle& GetCycle(uint8_t index)
+	{
+		return _cycles[index];
+	}
+
+	//Moves to the next instruction and restores the registers the CPU had at that point in the recorded iteration
+	void Advance(NesCpuState& state)
+	{
+		_index = _index + 1 == _instructionCount ? 0 : _index + 1;
+
+		Instruction& inst = _instructions[_index];
+		state.PC = inst.PC;
+		state.SP = inst.SP;
+		state.A = inst.A;
+		state.X = inst.X;
+		state.Y = inst.Y;
+		state.PS = inst.PS;
+	}
+};
@@ -73,6 +73,7 @@ void NesMemoryManager::RegisterIODevice(INesMemoryHandler*handler)
 
 	InitializeMemoryHandlers(_ramReadHandlers, handler, ranges.GetRAMReadAddresses(), ranges.GetAllowOverride());
 	InitializeMemoryHandlers(_ramWriteHandlers, handler, ranges.GetRAMWriteAddresses(), ranges.GetAllowOverride());
+	UpdatePageHandlers();
 }
 
 void NesMemoryManager::RegisterWriteHandler(INesMemoryHandler* handler, uint32_t start, uint32_t end)
@@ -80,6 +81,7 @@ void NesMemoryManager::RegisterWriteHandler(INesMemoryHandler* handler, uint32_t
 	for(uint32_t i = start; i <= end; i++) {
 		_ramWriteHandlers[i] = handler;
 	}
+	UpdatePageHandlers();
 }
 
 void NesMemoryManager::RegisterReadHandler(INesMemoryHandler* handler, uint32_t start, uint32_t end)
@@ -87,6 +89,7 @@ void NesMemoryManager::RegisterReadHandler(INesMemoryHandler* handler, uint32_t
 	for(uint32_t i = start; i <= end; i++) {
 		_ramReadHandlers[i] = handler;
 	}
+	UpdatePageHandlers();
 }
 
 void NesMemoryManager::UnregisterIODevice(INesMemoryHandler*handler)
@@ -101,6 +104,53 @@ void NesMemoryManager::UnregisterIODevice(INesMemoryHandler*handler)
 	for(uint16_t address : *ranges.GetRAMWriteAddresses()) {
 		_ramWriteHandlers[address] = &_openBusHandler;
 	}
+	UpdatePageHandlers();
+}
+
+void NesMemoryManager::UpdatePageHandlers()
+{
+	for(int page = 0; page < 0x100; page++) {
+		INesMemoryHandler* readHandler = _ramReadHandlers[page << 8];
+		INesMemoryHandler* writeHandler = _ramWriteHandlers[page << 8];
+		for(int i = 1; i < 0x100; i++) {
+			if(_ramReadHandlers[(page << 8) | i] != readHandler) {
+				readHandler = nullptr;
+			}
+			if(_ramWriteHandlers[(page << 8) | i] != writeHandler) {
+				writeHandler = nullptr;
+			}
+		}
+		_pageReadHandlers[page] = readHandler;
+		_pageWriteHandlers[page] = writeHandler;
+	}
+	UpdateDirectPages(0, 0xFF);
+}
+
+void NesMemoryManager::UpdateDirectPages(uint16_t firstPage, uint16_t lastPage)
+{
+	for(uint16_t page = firstPage; page <= lastPage; page++) {
+		uint8_t* internalRamPage = _internalRam + ((page << 8) & (_internalRamSize - 1));
+
+		INesMemoryHandler* readHandler = _pageReadHandlers[page];
+		if(readHandler == _internalRamHandler.get()) {
+			_directReadPages[page] = internalRamPage;
+		} else if(readHandler == _mapper) {
+			_directReadPages[page] = _mapper->GetDirectReadPage((uint8_t)page);
+		} else {
+			_directReadPages[page] = nullptr;
+		}
+
+		//Mapper writes can have side effects (registers, bus conflicts, etc.), only internal RAM is written directly
+		_directWritePages[page] = _pageWriteHandlers[page] == _internalRamHandler.get() ? internalRamPage : nullptr;
+	}
+	_directPageGeneration++;
+}
+
+void NesMemoryManager::UpdateMapperPages(BaseMapper* mapper, uint16_t firstPage, uint16_t lastPage)
+{
+	if(mapper == _mapper) {
+		UpdateDirectPages(firstPage, lastPage);
+	}
 }
 
 uint8_t* NesMemoryManager::GetInternalRam()
@@ -108,6 +158,15 @@ uint8_t* NesMemoryManager::GetInternalRam()
 	return _internalRam;
 }
 
+bool NesMemoryManager::IsStableRead(uint16_t addr)
+{
+	uint8_t page = addr >> 8;
+	if(!_directReadPages[page]) {
+		return false;
+	}
+	return _pageReadHandlers[page] != _mapper || _mapper->IsCpuOwnedPage(page);
+}
+
 uint8_t NesMemoryManager::DebugRead(uint16_t addr)
 {
 	uint8_t value = _ramReadHandlers[addr]->PeekRam(addr);
@@ -124,7 +183,8 @@ uint16_t NesMemoryManager::DebugReadWord(uint16_t addr)
 
 uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 {
-	uint8_t value = _ramReadHandlers[addr]->ReadRam(addr);
+	uint8_t* page = _directReadPages[addr >> 8];
+	uint8_t value = page ? page[(uint8_t)addr] : _ramReadHandlers[addr]->ReadRam(addr);
 	if(_cheatManager->HasCheats<CpuType::Nes>()) {
 		_cheatManager->ApplyCheat<CpuType::Nes>(addr, value);
 	}
@@ -138,7 +198,12 @@ uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 void NesMemoryManager::Write(uint16_t addr, uint8_t value, MemoryOperationType operationType)
 {
 	if(_emu->ProcessMemoryWrite<CpuType::Nes>(addr, value, operationType)) {
-		_ramWriteHandlers[addr]->WriteRam(addr, value);
+		uint8_t* page = _directWritePages[addr >> 8];
+		if(page) {
+			page[(uint8_t)addr] = value;
+		} else {
+			_ramWriteHandlers[addr]->WriteRam(addr, value);
+		}
 		_openBusHandler.SetOpenBus(value, false);
 	}
 }
@@ -33,7 +33,20 @@ private:
 	INesMemoryHandler** _ramReadHandlers = nullptr;
 	INesMemoryHandler** _ramWriteHandlers = nullptr;
 
+	//Handler that covers an entire 256-byte page (nullptr when the page is split between several handlers)
+	INesMemoryHandler* _pageReadHandlers[0x100] = {};
+	INesMemoryHandler* _pageWriteHandlers[0x100] = {};
+
+	//Pages that can be accessed directly, without calling the handler (nullptr when the handler must be called)
+	uint8_t* _directReadPages[0x100] = {};
+	uint8_t* _directWritePages[0x100] = {};
+
+	//Incremented whenever the direct pages are updated
+	uint32_t _directPageGeneration = 0;
+
 	void InitializeMemoryHandlers(INesMemoryHandler** memoryHandlers, INesMemoryHandler* handler, vector<uint16_t>* addresses, bool allowOverride);
+	void UpdatePageHandlers();
+	void UpdateDirectPages(uint16_t firstPage, uint16_t lastPage);
 
 protected:
 	void Serialize(Serializer& s) override;
@@ -47,6 +60,7 @@ public:
 	void RegisterWriteHandler(INesMemoryHandler* handler, uint32_t start, uint32_t end);
 	void RegisterReadHandler(INesMemoryHandler* handler, uint32_t start, uint32_t end);
 	void UnregisterIODevice(INesMemoryHandler* handler);
+	void UpdateMapperPages(BaseMapper* mapper, uint16_t firstPage, uint16_t lastPage);
 
 	uint8_t DebugRead(uint16_t addr);
 	uint16_t DebugReadWord(uint16_t addr);
@@ -54,6 +68,11 @@ public:
 
 	uint8_t* GetInternalRam();
 
+	//Returns true when reading this address has no side effects, and its value can only be changed by a CPU write
+	bool IsStableRead(uint16_t addr);
+	uint32_t GetDirectPageGeneration() { return _directPageGeneration; }
+	void SetOpenBus(uint8_t value) { _openBusHandler.SetOpenBus(value, false); }
+
 	uint8_t Read(uint16_t addr, MemoryOperationType operationType = MemoryOperationType::Read);
 	void Write(uint16_t addr, uint8_t value, MemoryOperationType operationType);
 
@@ -18,6 +18,26 @@ NesSoundMixer::NesSoundMixer(NesConsole* console)
 	_blipBufLeft = blip_new(NesSoundMixer::MaxSamplesPerFrame);
 	_blipBufRight = blip_new(NesSoundMixer::MaxSamplesPerFrame);
 	_sampleRate = 96000;
+
+	InitMixingTables();
+}
+
+void NesSoundMixer::InitMixingTables()
+{
+	//Uses the exact same calculations as GetOutputVolume, to produce identical results
+	for(int i = 0; i < 31; i++) {
+		double squareOutput = i;
+		_squareTable[i] = (uint16_t)((95.88*5000.0) / (8128.0 / squareOutput + 100.0));
+	}
+
+	for(int triangle = 0; triangle < 16; triangle++) {
+		for(int noise = 0; noise < 16; noise++) {
+			for(int dmc = 0; dmc < 128; dmc++) {
+				double tndOutput = (double)dmc + 2.7516713261 * (double)triangle + 1.8493587125 * (double)noise;
+				_tndTable[triangle][noise][dmc] = (uint16_t)((159.79*5000.0) / (22638.0 / tndOutput + 100.0));
+			}
+		}
+	}
 }
 
 NesSoundMixer::~NesSoundMixer()
@@ -54,6 +74,7 @@ void NesSoundMixer::Reset()
 	blip_clear(_blipBufRight);
 
 	_timestamps.clear();
+	memset(_hasDelta, 0, sizeof(_hasDelta));
 
 	for(uint32_t i = 0; i < MaxChannelCount; i++) {
 		_volumes[i] = 1.0;
@@ -151,6 +172,7 @@ void NesSoundMixer::UpdateRates(bool forceUpdate)
 
 	NesConfig& cfg = _console->GetNesConfig();
 	bool hasPanning = false;
+	bool useMixingTables = true;
 	for(uint32_t i = 0; i < MaxChannelCount; i++) {
 		_volumes[i] = cfg.ChannelVolumes[i] / 100.0;
 		_panning[i] = (cfg.ChannelPanning[i] + 100) / 100.0;
@@ -161,8 +183,12 @@ void NesSoundMixer::UpdateRates(bool forceUpdate)
 			}
 			hasPanning = true;
 		}
+		if(_volumes[i] != 1.0) {
+			useMixingTables = false;
+		}
 	}
 	_hasPanning = hasPanning;
+	_useMixingTables = useMixingTables && !hasPanning;
 }
 
 double NesSoundMixer::GetChannelOutput(AudioChannel channel, bool forRightChannel)
@@ -190,26 +216,56 @@ int16_t NesSoundMixer::GetOutputVolume(bool forRightChannel)
 		GetChannelOutput(AudioChannel::VRC6, forRightChannel) * 5 +
 		GetChannelOutput(AudioChannel::VRC7, forRightChannel));
 }
+
+int16_t NesSoundMixer::GetOutputVolumeFromTables()
+{
+	//Only valid when all volumes are 100% and there is no panning - the expansion audio weights can then be applied with integer math
+	uint32_t squareOutput = (uint16_t)_currentOutput[(int)AudioChannel::Square1] + (uint16_t)_currentOutput[(int)AudioChannel::Square2];
+	uint16_t triangle = _currentOutput[(int)AudioChannel::Triangle];
+	uint16_t noise = _currentOutput[(int)AudioChannel::Noise];
+	uint16_t dmc = _currentOutput[(int)AudioChannel::DMC];
+	if(squareOutput > 30 || triangle > 15 || noise > 15 || dmc > 127) {
+		//Outside of the range of the tables (can't normally happen)
+		return GetOutputVolume(false);
+	}
+
+	return (int16_t)(_squareTable[squareOutput] + _tndTable[triangle][noise][dmc] +
+		_currentOutput[(int)AudioChannel::FDS] * 20 +
+		_currentOutput[(int)AudioChannel::MMC5] * 43 +
+		_currentOutput[(int)AudioChannel::Namco163] * 20 +
+		_currentOutput[(int)AudioChannel::Sunsoft5B] * 15 +
+		_currentOutput[(int)AudioChannel::VRC6] * 5 +
+		_currentOutput[(int)AudioChannel::VRC7]);
+}
+
 void NesSoundMixer::AddDelta(AudioChannel channel, uint32_t time, int16_t delta)
 {
 	if(delta != 0) {
-		_timestamps.push_back(time);
-		_channelOutput[(int)channel][time] += delta;
+		if(!_hasDelta[time]) {
+			_hasDelta[time] = true;
+			_timestamps.push_back(time);
+		}
+		_channelOutput[time][(int)channel] += delta;
 	}
 }
 
 void NesSoundMixer::EndFrame(uint32_t time)
 {
+	//Timestamps are only added once (see AddDelta), and are mostly in order already
 	sort(_timestamps.begin(), _timestamps.end());
-	_timestamps.erase(std::unique(_timestamps.begin(), _timestamps.end()), _timestamps.end());
 
 	for(size_t i = 0, len = _timestamps.size(); i < len; i++) {
 		uint32_t stamp = _timestamps[i];
-		for(uint32_t j = 0; j < MaxChannelCount; j++) {
-			_currentOutput[j] += _channelOutput[j][stamp];
+		int16_t* deltas = _channelOutput[stamp];
+		for(uint32_t j = 0; j < ChannelStride; j++) {
+			_currentOutput[j] += deltas[j];
 		}
 
-		int16_t currentOutput = GetOutputVolume(false) * 4;
+		//Clear the deltas as they are consumed, rather than clearing the entire array at the end of the frame
+		memset(deltas, 0, sizeof(_channelOutput[stamp]));
+		_hasDelta[stamp] = false;
+
+		int16_t currentOutput = (_useMixingTables ? GetOutputVolumeFromTables() : GetOutputVolume(false)) * 4;
 		blip_add_delta(_blipBufLeft, stamp, (int)(currentOutput - _previousOutputLeft));
 		_previousOutputLeft = currentOutput;
 
@@ -225,8 +281,6 @@ void NesSoundMixer::EndFrame(uint32_t time)
 		blip_end_frame(_blipBufRight, time);
 	}
 
-	//Reset everything
 	_timestamps.clear();
-	memset(_channelOutput, 0, sizeof(_channelOutput));
 }
 
@@ -23,6 +23,9 @@ private:
 	static constexpr uint32_t MaxSamplesPerFrame = MaxSampleRate / 60 * 4 * 2; //x4 to allow CPU overclocking up to 10x, x2 for panning stereo
 	static constexpr uint32_t MaxChannelCount = 11;
 
+	//Each timestamp's deltas for all channels are stored contiguously (padded to 16 to allow the compiler to vectorize the sums)
+	static constexpr uint32_t ChannelStride = 16;
+
 	NesConsole* _console = nullptr;
 	SoundMixer* _mixer = nullptr;
 
@@ -34,8 +37,14 @@ private:
 	int16_t _previousOutputRight = 0;
 
 	vector<uint32_t> _timestamps;
-	int16_t _channelOutput[MaxChannelCount][CycleLength] = {};
-	int16_t _currentOutput[MaxChannelCount] = {};
+	bool _hasDelta[CycleLength] = {};
+	alignas(32) int16_t _channelOutput[CycleLength][ChannelStride] = {};
+	alignas(32) int16_t _currentOutput[ChannelStride] = {};
+
+	//Nonlinear mixing lookup tables, used when all APU channels are at 100% volume with no panning
+	uint16_t _squareTable[31] = {};
+	uint16_t _tndTable[16][16][128] = {};
+	bool _useMixingTables = false;
 
 	blip_t* _blipBufLeft = nullptr;
 	blip_t* _blipBufRight = nullptr;
@@ -51,6 +60,8 @@ private:
 
 	__forceinline double GetChannelOutput(AudioChannel channel, bool forRightChannel);
 	__forceinline int16_t GetOutputVolume(bool forRightChannel);
+	__forceinline int16_t GetOutputVolumeFromTables();
+	void InitMixingTables();
 	void EndFrame(uint32_t time);
 
 	void ProcessVsDualSystemAudio();
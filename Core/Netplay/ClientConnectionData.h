@@ -9,11 +9,12 @@ public:
 	uint16_t Port = 0;
 	string Password;
 	bool Spectator = false;
+	uint32_t RollbackFrames = 0;
 
 	ClientConnectionData() {}
 
-	ClientConnectionData(string host, uint16_t port, string password, bool spectator) :
-		Host(host), Port(port), Password(password), Spectator(spectator)
+	ClientConnectionData(string host, uint16_t port, string password, bool spectator, uint32_t rollbackFrames) :
+		Host(host), Port(port), Password(password), Spectator(spectator), RollbackFrames(rollbackFrames)
 	{
 	}
 
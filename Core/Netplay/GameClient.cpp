@@ -2,6 +2,7 @@
 #include "Netplay/GameClient.h"
 #include "Netplay/ClientConnectionData.h"
 #include "Netplay/GameClientConnection.h"
+#include "Netplay/RollbackManager.h"
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/NotificationManager.h"
@@ -30,7 +31,21 @@ void GameClient::Connect(ClientConnectionData &connectionData)
 	_stop = false;
 	unique_ptr<Socket> socket(new Socket());
 	if(socket->Connect(connectionData.Host.c_str(), connectionData.Port)) {
-		_connection.reset(new GameClientConnection(_emu, std::move(socket), connectionData));
+		shared_ptr<RollbackManager> rollback;
+		if(connectionData.RollbackFrames > 0) {
+			rollback.reset(new RollbackManager(_emu, connectionData.RollbackFrames));
+		}
+
+		{
+			auto lock = _rollbackLock.AcquireSafe();
+			_rollback = rollback;
+		}
+
+		if(_connection) {
+			_poller.Remove(_connection->GetSocket());
+		}
+		_poller.Add(socket.get());
+		_connection.reset(new GameClientConnection(_emu, std::move(socket), connectionData, rollback, &_poller));
 		_connected = true;
 		_clientThread.reset(new thread(&GameClient::Exec, this));
 		_emu->GetNotificationManager()->RegisterNotificationListener(shared_from_this());
@@ -44,10 +59,14 @@ void GameClient::Disconnect()
 {
 	_stop = true;
 	_connected = false;
+	_poller.Wake();
 	if(_clientThread) {
 		_clientThread->join();
 		_clientThread.reset();
 	}
+
+	auto lock = _rollbackLock.AcquireSafe();
+	_rollback.reset();
 }
 
 void GameClient::Exec()
@@ -60,7 +79,9 @@ void GameClient::Exec()
 			} else {
 				break;
 			}
-			std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+
+			//Sleep until a message is received, or until the emulation polls the input (see GameClientConnection::SetInput)
+			_poller.Wait(GameClient::MaxWaitTime);
 		}
 		_connected = false;
 		_connection->Shutdown();
@@ -99,6 +120,19 @@ vector<NetplayControllerUsageInfo> GameClient::GetControllerList()
 	return _connection ? _connection->GetControllerList() : vector<NetplayControllerUsageInfo>();
 }
 
+shared_ptr<RollbackManager> GameClient::GetRollbackManager()
+{
+	auto lock = _rollbackLock.AcquireSafe();
+	return _rollback;
+}
+
+void GameClient::RequestResync()
+{
+	if(_connection) {
+		_connection->RequestResync();
+	}
+}
+
 NetplayControllerInfo GameClient::GetControllerPort()
 {
 	return _connection ? _connection->GetControllerPort() : NetplayControllerInfo { GameConnection::SpectatorPort, 0 };
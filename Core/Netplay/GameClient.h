@@ -2,18 +2,26 @@
 #include "pch.h"
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Netplay/NetplayTypes.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/Socket.h"
 
-class Socket;
 class GameClientConnection;
+class RollbackManager;
 class ClientConnectionData;
 class Emulator;
 
 class GameClient : public INotificationListener, public std::enable_shared_from_this<GameClient>
 {
 private:
+	static constexpr int MaxWaitTime = 100;
+
 	Emulator* _emu;
 	unique_ptr<thread> _clientThread;
 	unique_ptr<GameClientConnection> _connection;
+	SocketPoller _poller;
+
+	SimpleLock _rollbackLock;
+	shared_ptr<RollbackManager> _rollback;
 
 	atomic<bool> _stop;
 	atomic<bool> _connected;
@@ -32,5 +40,8 @@ public:
 	NetplayControllerInfo GetControllerPort();
 	vector<NetplayControllerUsageInfo> GetControllerList();
 
+	shared_ptr<RollbackManager> GetRollbackManager();
+	void RequestResync();
+
 	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
 };
\ No newline at end of file
@@ -10,16 +10,23 @@
 #include "Netplay/PlayerListMessage.h"
 #include "Netplay/ForceDisconnectMessage.h"
 #include "Netplay/ServerInformationMessage.h"
+#include "Netplay/StateChecksumMessage.h"
+#include "Netplay/ResyncRequestMessage.h"
 #include "Netplay/GameServer.h"
+#include "Netplay/RollbackManager.h"
 #include "Shared/BaseControlManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/NotificationManager.h"
 #include "Shared/RomFinder.h"
+#include "Utilities/Socket.h"
+#include "Utilities/CRC32.h"
 
-GameClientConnection::GameClientConnection(Emulator* emu, unique_ptr<Socket> socket, ClientConnectionData &connectionData) : GameConnection(emu, std::move(socket))
+GameClientConnection::GameClientConnection(Emulator* emu, unique_ptr<Socket> socket, ClientConnectionData &connectionData, shared_ptr<RollbackManager> rollback, SocketPoller* poller) : GameConnection(emu, std::move(socket))
 {
 	_connectionData = connectionData;
+	_rollback = rollback;
+	_poller = poller;
 	_shutdown = false;
 	_enableControllers = false;
 	_minimumQueueSize = 3;
@@ -66,6 +73,63 @@ void GameClientConnection::ClearInputData()
 		_inputSize[i] = 0;
 		_inputData[i].clear();
 	}
+	_localInputs.clear();
+	_pendingInputs.clear();
+	_stateChecksums.clear();
+	_resyncRequested = false;
+}
+
+void GameClientConnection::VerifyStateChecksum()
+{
+	if(_rollback) {
+		//Frames run with predicted input (including the frames run again after a rollback) are compared with
+		//the server's state by the emulation loop once their input is confirmed (see RollbackManager::VerifyChecksums)
+		uint32_t frameCount = _emu->GetFrameCount();
+		if(_enableControllers && frameCount % GameServer::ChecksumInterval == 0) {
+			stringstream state;
+			_emu->Serialize(state, false, 0);
+			string data = state.str();
+			_rollback->AddLocalChecksum(frameCount, CRC32::GetCRC((uint8_t*)data.data(), data.size()));
+		}
+		return;
+	}
+
+	if(_emu->IsRunAheadFrame() || !_enableControllers) {
+		//Only frames that were run with the server's input can be compared with the server's state
+		return;
+	}
+
+	uint32_t frameCount = _emu->GetFrameCount();
+	uint32_t expectedChecksum = 0;
+	{
+		LockHandler lock = _writeLock.AcquireSafe();
+		while(!_stateChecksums.empty() && _stateChecksums.front().first < frameCount) {
+			_stateChecksums.pop_front();
+		}
+
+		if(_resyncRequested || _stateChecksums.empty() || _stateChecksums.front().first != frameCount) {
+			return;
+		}
+		expectedChecksum = _stateChecksums.front().second;
+		_stateChecksums.pop_front();
+	}
+
+	stringstream state;
+	_emu->Serialize(state, false, 0);
+	string data = state.str();
+	if(CRC32::GetCRC((uint8_t*)data.data(), data.size()) != expectedChecksum) {
+		RequestResync();
+	}
+}
+
+void GameClientConnection::RequestResync()
+{
+	if(!_resyncRequested) {
+		MessageManager::Log("[Netplay] Client is desynchronized, requesting state from server.");
+		_resyncRequested = true;
+		ResyncRequestMessage resync;
+		SendNetMessage(resync);
+	}
 }
 
 void GameClientConnection::ProcessMessage(NetMessage* message)
@@ -84,15 +148,45 @@ void GameClientConnection::ProcessMessage(NetMessage* message)
 
 				auto lock = _emu->AcquireLock();
 				ClearInputData();
-				((SaveStateMessage*)message)->LoadState(_emu);
-				_enableControllers = true;
-				InitControlDevice();
+				if(((SaveStateMessage*)message)->LoadState(_emu, _stateBase, _stateBaseId)) {
+					if(_rollback) {
+						_rollback->Reset();
+					}
+					_enableControllers = true;
+					InitControlDevice();
+				} else {
+					//Received the difference with a state this client does not have, ask for a full state
+					_stateBaseId = 0;
+					ResyncRequestMessage resync;
+					SendNetMessage(resync);
+				}
 			}
 			break;
 
 		case MessageType::MovieData:
 			if(_gameLoaded) {
-				PushControllerState(((MovieDataMessage*)message)->GetPortNumber(), ((MovieDataMessage*)message)->GetInputState());
+				MovieDataMessage* movieData = (MovieDataMessage*)message;
+				for(uint32_t i = 0, len = movieData->GetPortCount(); i < len; i++) {
+					if(movieData->GetPortNumber(i) < BaseControlDevice::PortCount) {
+						PushControllerState(movieData->GetPortNumber(i), movieData->GetInputState(i));
+					}
+				}
+			}
+			break;
+
+		case MessageType::StateChecksum:
+			if(_gameLoaded) {
+				StateChecksumMessage* checksum = (StateChecksumMessage*)message;
+				if(_rollback) {
+					_rollback->AddServerChecksum(checksum->GetFrameCount(), checksum->GetChecksum());
+					break;
+				}
+
+				LockHandler lock = _writeLock.AcquireSafe();
+				_stateChecksums.push_back({ checksum->GetFrameCount(), checksum->GetChecksum() });
+				if(_stateChecksums.size() > 10) {
+					_stateChecksums.pop_front();
+				}
 			}
 			break;
 
@@ -150,6 +244,11 @@ bool GameClientConnection::AttemptLoadGame(string filename, uint32_t crc32)
 
 void GameClientConnection::PushControllerState(uint8_t port, ControlDeviceState state)
 {
+	if(_rollback) {
+		_rollback->AddConfirmedInput(port, state);
+		return;
+	}
+
 	LockHandler lock = _writeLock.AcquireSafe();
 	_inputData[port].push_back(state);
 	_inputSize[port]++;
@@ -163,14 +262,89 @@ void GameClientConnection::DisableControllers()
 {
 	//Used to prevent deadlocks when client is trying to fill its buffer while the host changes the current game/settings/etc. (i.e situations where we need to call Console::Pause())
 	_enableControllers = false;
+	if(_rollback) {
+		_rollback->Disable();
+	}
 	ClearInputData();
 	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
 		_waitForInput[i].Signal();
 	}
 }
 
+void GameClientConnection::SetRollbackInput(BaseControlDevice* device)
+{
+	//The input is predicted if the server's input has not been received yet (unless the rollback loop is not running)
+	uint8_t port = device->GetPort();
+	uint8_t localPort = _controllerPort.SubPort == 0 ? _controllerPort.Port : GameConnection::SpectatorPort;
+	if(port == localPort) {
+		shared_ptr<IConsole> console = _emu->GetConsole();
+		if(console) {
+			_rollback->SetLocalInput(port, GetLocalInput(port, console->GetControlManager()->GetPollCounter()));
+		}
+	}
+
+	ControlDeviceState state;
+	if(_rollback->GetInput(port, state)) {
+		device->SetRawState(state);
+	}
+
+	if(_rollback->GetBufferedInputCount(port) > _minimumQueueSize) {
+		//Too much data, catch up
+		_emu->GetSettings()->SetFlag(EmulationFlags::MaximumSpeed);
+	} else {
+		_emu->GetSettings()->ClearFlag(EmulationFlags::MaximumSpeed);
+	}
+}
+
+ControlDeviceState GameClientConnection::GetLocalInput(uint8_t port, uint32_t pollCounter)
+{
+	LockHandler lock = _writeLock.AcquireSafe();
+
+	//Sample the player's input for the poll that will run InputDelay polls from now (unless it was already done
+	//before a rollback) and queue it, the server applies it on that poll instead of on the poll it is received on
+	uint32_t targetPoll = pollCounter + GameClientConnection::InputDelay;
+	if(_localInputs.empty() || _localInputs.back().PollCounter < targetPoll) {
+		if(!_localDevice || _controllerType != _localDevice->GetControllerType()) {
+			//Uses port 0's keybindings, like the device used by SendInput
+			shared_ptr<IConsole> console = _emu->GetConsole();
+			_localDevice = console ? console->GetControlManager()->CreateControllerDevice(_controllerType, 0) : nullptr;
+		}
+
+		ControlDeviceState state;
+		if(_localDevice) {
+			_localDevice->ClearState();
+			_localDevice->SetStateFromInput();
+			state = _localDevice->GetRawState();
+		}
+
+		_localInputs.push_back({ targetPoll, _stateBaseId, state });
+		_pendingInputs.push_back(_localInputs.back());
+		if(_localInputs.size() > GameClientConnection::MaxLocalInputs) {
+			_localInputs.pop_front();
+		}
+	}
+
+	//Find the input the server applies on this poll - the input for the first few polls after a state is loaded is not known
+	for(auto it = _localInputs.rbegin(); it != _localInputs.rend(); it++) {
+		if(it->PollCounter <= pollCounter) {
+			return it->State;
+		}
+	}
+	return {};
+}
+
 bool GameClientConnection::SetInput(BaseControlDevice *device)
 {
+	//Wake up the network thread to send the player's current input to the server
+	_poller->Wake();
+
+	if(_rollback) {
+		if(_enableControllers) {
+			SetRollbackInput(device);
+		}
+		return true;
+	}
+
 	if(_enableControllers) {
 		uint8_t port = device->GetPort();
 		while(_inputSize[port] == 0) {
@@ -227,13 +401,36 @@ void GameClientConnection::ProcessNotification(ConsoleNotificationType type, voi
 {
 	if(type == ConsoleNotificationType::ConfigChanged) {
 		InitControlDevice();
+	} else if(type == ConsoleNotificationType::PpuFrameDone) {
+		VerifyStateChecksum();
 	} else if(type == ConsoleNotificationType::GameLoaded) {
 		_emu->RegisterInputProvider(this);
+	} else if(type == ConsoleNotificationType::BeforeGameUnload && _rollback) {
+		//Prevent the emulation thread from waiting for the server's input while the emulation is stopped
+		_rollback->Disable();
 	}
 }
 
 void GameClientConnection::SendInput()
 {
+	if(_rollback) {
+		//Send the inputs sampled by the emulation thread, tagged with the poll they must be applied on
+		std::deque<LocalInput> inputs;
+		{
+			LockHandler lock = _writeLock.AcquireSafe();
+			inputs.swap(_pendingInputs);
+		}
+
+		for(LocalInput& input : inputs) {
+			if(_lastInputSent != input.State) {
+				InputDataMessage message(input.State, input.PollCounter, input.StateId);
+				SendNetMessage(message);
+				_lastInputSent = input.State;
+			}
+		}
+		return;
+	}
+
 	if(_gameLoaded) {
 		if(!_controlDevice || _controllerType != _controlDevice->GetControllerType()) {
 			//Pretend we are using port 0 (to use player 1's keybindings during netplay)
@@ -12,10 +12,24 @@
 #include "Netplay/NetplayTypes.h"
 
 class Emulator;
+class RollbackManager;
+class SocketPoller;
 
 class GameClientConnection final : public GameConnection, public INotificationListener, public IInputProvider
 {
 private:
+	//With rollback, the player's input is sent to the server this many input polls ahead of time, so that it
+	//reaches the server before it is needed (the player's own input is never predicted)
+	static constexpr uint32_t InputDelay = 2;
+	static constexpr uint32_t MaxLocalInputs = 600;
+
+	struct LocalInput
+	{
+		uint32_t PollCounter;
+		uint32_t StateId;
+		ControlDeviceState State;
+	};
+
 	std::deque<ControlDeviceState> _inputData[BaseControlDevice::PortCount];
 	atomic<uint32_t> _inputSize[BaseControlDevice::PortCount];
 	AutoResetEvent _waitForInput[BaseControlDevice::PortCount];
@@ -27,6 +41,7 @@ private:
 	vector<PlayerInfo> _playerList;
 
 	shared_ptr<BaseControlDevice> _controlDevice;
+	shared_ptr<BaseControlDevice> _localDevice;
 	atomic<ControllerType> _controllerType;
 	ControlDeviceState _lastInputSent = {};
 	bool _gameLoaded = false;
@@ -34,11 +49,29 @@ private:
 	ClientConnectionData _connectionData = {};
 	string _serverSalt;
 
+	shared_ptr<RollbackManager> _rollback;
+	SocketPoller* _poller = nullptr;
+
+	//Last state received from the server, the server can send the difference between it and the next state
+	string _stateBase;
+	uint32_t _stateBaseId = 0;
+
+	//Player's input for each input poll (kept to run frames again after a rollback), and the inputs that have not been sent yet
+	std::deque<LocalInput> _localInputs;
+	std::deque<LocalInput> _pendingInputs;
+
+	//Checksums sent by the server, used to detect desyncs
+	std::deque<std::pair<uint32_t, uint32_t>> _stateChecksums;
+	bool _resyncRequested = false;
+
 private:
 	void SendHandshake();
 	void SendControllerSelection(NetplayControllerInfo controller);
 	void ClearInputData();
 	void PushControllerState(uint8_t port, ControlDeviceState state);
+	void SetRollbackInput(BaseControlDevice* device);
+	ControlDeviceState GetLocalInput(uint8_t port, uint32_t pollCounter);
+	void VerifyStateChecksum();
 	void DisableControllers();
 	bool AttemptLoadGame(string filename, uint32_t crc32);
 
@@ -46,12 +79,13 @@ protected:
 	void ProcessMessage(NetMessage* message) override;
 
 public:
-	GameClientConnection(Emulator* emu, unique_ptr<Socket> socket, ClientConnectionData &connectionData);
+	GameClientConnection(Emulator* emu, unique_ptr<Socket> socket, ClientConnectionData &connectionData, shared_ptr<RollbackManager> rollback, SocketPoller* poller);
 	virtual ~GameClientConnection();
 
 	void Shutdown();
 
 	void ProcessNotification(ConsoleNotificationType type, void* parameter) override;
+	void RequestResync();
 
 	bool SetInput(BaseControlDevice *device) override;
 	void InitControlDevice();
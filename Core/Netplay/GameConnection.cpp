@@ -10,11 +10,14 @@
 #include "Netplay/ClientConnectionData.h"
 #include "Netplay/ForceDisconnectMessage.h"
 #include "Netplay/ServerInformationMessage.h"
+#include "Netplay/StateChecksumMessage.h"
+#include "Netplay/ResyncRequestMessage.h"
 
 GameConnection::GameConnection(Emulator* emu, unique_ptr<Socket> socket)
 {
 	_emu = emu;
 	_socket.swap(socket);
+	_readBuffer.resize(GameConnection::DefaultBufferSize);
 }
 
 GameConnection::~GameConnection()
@@ -25,31 +28,65 @@ GameConnection::~GameConnection()
 void GameConnection::ReadSocket()
 {
 	auto lock = _socketLock.AcquireSafe();
-	int bytesReceived = _socket->Recv((char*)_readBuffer + _readPosition, GameConnection::MaxMsgLength - _readPosition, 0);
-	if(bytesReceived > 0) {
-		_readPosition += bytesReceived;
+	int bufferSize = (int)_readBuffer.size();
+	if(_readPosition >= 4) {
+		//Make room for the entire message
+		uint32_t messageLength = _readBuffer[0] | (_readBuffer[1] << 8) | (_readBuffer[2] << 16) | (_readBuffer[3] << 24);
+		if(messageLength <= GameConnection::MaxMsgLength && (int)messageLength + 4 > bufferSize) {
+			_readBuffer.resize(std::min<int>(messageLength + 4, GameConnection::MaxMsgLength));
+		}
+	}
+
+	int freeSpace = (int)_readBuffer.size() - _readPosition;
+	if(freeSpace > 0) {
+		int bytesReceived = _socket->Recv((char*)_readBuffer.data() + _readPosition, freeSpace, 0);
+		if(bytesReceived > 0) {
+			_readPosition += bytesReceived;
+		}
 	}
 }
 
-bool GameConnection::ExtractMessage(void *buffer, uint32_t &messageLength)
+NetMessage* GameConnection::ExtractMessage()
 {
-	messageLength = _readBuffer[0] | (_readBuffer[1] << 8) | (_readBuffer[2] << 16) | (_readBuffer[3] << 24);
+	uint32_t messageLength = _readBuffer[0] | (_readBuffer[1] << 8) | (_readBuffer[2] << 16) | (_readBuffer[3] << 24);
 
-	if(messageLength > GameConnection::MaxMsgLength) {
+	if(messageLength == 0 || messageLength > GameConnection::MaxMsgLength - sizeof(messageLength)) {
 		MessageManager::Log("[Netplay] Invalid data received, closing connection.");
 		Disconnect();
-		return false;
+		return nullptr;
 	}
 
 	int packetLength = messageLength + sizeof(messageLength);
+	if(_readPosition < packetLength) {
+		return nullptr;
+	}
 
-	if(_readPosition >= packetLength) {
-		memcpy(buffer, _readBuffer+sizeof(messageLength), messageLength);
-		memmove(_readBuffer, _readBuffer + packetLength, _readPosition - packetLength);
-		_readPosition -= packetLength;
-		return true;
+	uint8_t* messageData = _readBuffer.data() + sizeof(messageLength);
+	NetMessage* message = nullptr;
+	switch((MessageType)messageData[0]) {
+		case MessageType::HandShake: message = new HandShakeMessage(messageData, messageLength); break;
+		case MessageType::SaveState: message = new SaveStateMessage(messageData, messageLength); break;
+		case MessageType::InputData: message = new InputDataMessage(messageData, messageLength); break;
+		case MessageType::MovieData: message = new MovieDataMessage(messageData, messageLength); break;
+		case MessageType::GameInformation: message = new GameInformationMessage(messageData, messageLength); break;
+		case MessageType::PlayerList: message = new PlayerListMessage(messageData, messageLength); break;
+		case MessageType::SelectController: message = new SelectControllerMessage(messageData, messageLength); break;
+		case MessageType::ForceDisconnect: message = new ForceDisconnectMessage(messageData, messageLength); break;
+		case MessageType::ServerInformation: message = new ServerInformationMessage(messageData, messageLength); break;
+		case MessageType::StateChecksum: message = new StateChecksumMessage(messageData, messageLength); break;
+		case MessageType::ResyncRequest: message = new ResyncRequestMessage(messageData, messageLength); break;
 	}
-	return false;
+
+	memmove(_readBuffer.data(), _readBuffer.data() + packetLength, _readPosition - packetLength);
+	_readPosition -= packetLength;
+
+	if(_readBuffer.size() > GameConnection::DefaultBufferSize && _readPosition <= GameConnection::DefaultBufferSize) {
+		//Release the memory used by large messages
+		_readBuffer.resize(GameConnection::DefaultBufferSize);
+		_readBuffer.shrink_to_fit();
+	}
+
+	return message;
 }
 
 NetMessage* GameConnection::ReadMessage()
@@ -57,28 +94,21 @@ NetMessage* GameConnection::ReadMessage()
 	ReadSocket();
 
 	if(_readPosition > 4) {
-		uint32_t messageLength;
-		if(ExtractMessage(_messageBuffer, messageLength)) {
-			switch((MessageType)_messageBuffer[0]) {
-				case MessageType::HandShake: return new HandShakeMessage(_messageBuffer, messageLength);
-				case MessageType::SaveState: return new SaveStateMessage(_messageBuffer, messageLength);
-				case MessageType::InputData: return new InputDataMessage(_messageBuffer, messageLength);
-				case MessageType::MovieData: return new MovieDataMessage(_messageBuffer, messageLength);
-				case MessageType::GameInformation: return new GameInformationMessage(_messageBuffer, messageLength);
-				case MessageType::PlayerList: return new PlayerListMessage(_messageBuffer, messageLength);
-				case MessageType::SelectController: return new SelectControllerMessage(_messageBuffer, messageLength);
-				case MessageType::ForceDisconnect: return new ForceDisconnectMessage(_messageBuffer, messageLength);
-				case MessageType::ServerInformation: return new ServerInformationMessage(_messageBuffer, messageLength);
-			}
-		}
+		return ExtractMessage();
 	}
 	return nullptr;
 }
 
 void GameConnection::SendNetMessage(NetMessage &message)
+{
+	string packet = message.GetPacket();
+	SendPacket(packet);
+}
+
+void GameConnection::SendPacket(string& packet)
 {
 	auto lock = _socketLock.AcquireSafe();
-	message.Send(*_socket.get());
+	_socket->Send((char*)packet.data(), (int)packet.size(), 0);
 }
 
 void GameConnection::Disconnect()
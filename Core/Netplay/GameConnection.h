@@ -10,19 +10,20 @@ class GameConnection
 {
 protected:
 	static constexpr int MaxMsgLength = 1500000;
+	static constexpr int DefaultBufferSize = 0x4000;
 
 	unique_ptr<Socket> _socket;
 	Emulator* _emu;
 
-	uint8_t _readBuffer[GameConnection::MaxMsgLength] = {};
-	uint8_t _messageBuffer[GameConnection::MaxMsgLength] = {};
+	//Grows when large messages (e.g save states) are received, and shrinks back once they have been processed
+	vector<uint8_t> _readBuffer;
 	int _readPosition = 0;
 	SimpleLock _socketLock;
 
 private:
 	void ReadSocket();
 
-	bool ExtractMessage(void *buffer, uint32_t &messageLength);
+	NetMessage* ExtractMessage();
 	NetMessage* ReadMessage();
 
 	virtual void ProcessMessage(NetMessage* message) = 0;
@@ -36,6 +37,8 @@ public:
 	virtual ~GameConnection();
 
 	bool ConnectionError();
+	Socket* GetSocket() { return _socket.get(); }
 	void ProcessMessages();
 	void SendNetMessage(NetMessage &message);
+	void SendPacket(string& packet);
 };
\ No newline at end of file
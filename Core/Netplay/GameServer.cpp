@@ -2,12 +2,18 @@
 #include "Netplay/GameServer.h"
 #include "Netplay/GameServerConnection.h"
 #include "Netplay/PlayerListMessage.h"
+#include "Netplay/MovieDataMessage.h"
+#include "Netplay/SaveStateMessage.h"
+#include "Netplay/StateChecksumMessage.h"
 #include "Shared/Emulator.h"
 #include "Shared/BaseControlManager.h"
 #include "Shared/NotificationManager.h"
 #include "Shared/MessageManager.h"
 #include "Utilities/Socket.h"
 #include "Shared/ControllerHub.h"
+#include "Shared/CheatManager.h"
+#include "Shared/EmuSettings.h"
+#include "Utilities/CRC32.h"
 
 GameServer::GameServer(Emulator* emu)
 {
@@ -32,6 +38,7 @@ void GameServer::AcceptConnections()
 	while(true) {
 		unique_ptr<Socket> socket = _listener->Accept();
 		if(!socket->ConnectionError()) {
+			_poller.Add(socket.get());
 			_openConnections.push_back(unique_ptr<GameServerConnection>(new GameServerConnection(this, _emu, std::move(socket), _password)));
 		} else {
 			break;
@@ -47,6 +54,7 @@ void GameServer::UpdateConnections()
 		if(_openConnections[i]->ConnectionError()) {
 			//Pause emu thread to ensure nothing else modifies/accesses the _openConnections list while removing dead connections
 			auto lock = _emu->AcquireLock();
+			_poller.Remove(_openConnections[i]->GetSocket());
 			_openConnections.erase(_openConnections.begin() + i);
 		} else {
 			_openConnections[i]->ProcessMessages();
@@ -56,6 +64,10 @@ void GameServer::UpdateConnections()
 
 bool GameServer::SetInput(BaseControlDevice *device)
 {
+	//Clients can send their input ahead of time, tagged with the input poll it must be applied to
+	shared_ptr<IConsole> console = _emu->GetConsole();
+	uint32_t pollCounter = console ? console->GetControlManager()->GetPollCounter() : 0;
+
 	uint8_t port = device->GetPort();
 	IControllerHub* hub = dynamic_cast<IControllerHub*>(device);
 	if(hub) {
@@ -65,7 +77,7 @@ bool GameServer::SetInput(BaseControlDevice *device)
 			if(connection) {
 				shared_ptr<BaseControlDevice> hubController = hub->GetController(i);
 				if(hubController) {
-					hubController->SetRawState(connection->GetState());
+					hubController->SetRawState(connection->GetState(pollCounter));
 				}
 			}
 		}
@@ -75,7 +87,7 @@ bool GameServer::SetInput(BaseControlDevice *device)
 		GameServerConnection* connection = GetNetPlayDevice(controller);
 		if(connection) {
 			//Device is controlled by a client
-			device->SetRawState(connection->GetState());
+			device->SetRawState(connection->GetState(pollCounter));
 			return true;
 		}
 	}
@@ -86,13 +98,85 @@ bool GameServer::SetInput(BaseControlDevice *device)
 
 void GameServer::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
-	for(shared_ptr<BaseControlDevice> &device : devices) {
-		for(unique_ptr<GameServerConnection>& connection : _openConnections) {
-			if(!connection->ConnectionError()) {
-				//Send movie stream
-				connection->SendMovieData(device->GetPort(), device->GetRawState());
+	if(_openConnections.empty()) {
+		return;
+	}
+
+	//Send the input for all ports in a single message, serialized once for all clients
+	MovieDataMessage message(devices);
+	string packet = message.GetPacket();
+	for(unique_ptr<GameServerConnection>& connection : _openConnections) {
+		if(!connection->ConnectionError()) {
+			connection->SendMovieData(packet);
+		}
+	}
+}
+
+vector<GameServerConnection*> GameServer::GetActiveConnections()
+{
+	vector<GameServerConnection*> connections;
+	for(unique_ptr<GameServerConnection>& connection : _openConnections) {
+		if(connection->IsHandshakeCompleted() && !connection->ConnectionError()) {
+			connections.push_back(connection.get());
+		}
+	}
+	return connections;
+}
+
+void GameServer::SendGameState(vector<GameServerConnection*> connections)
+{
+	auto lock = _emu->AcquireLock();
+
+	stringstream stateStream;
+	_emu->Serialize(stateStream, true, 0);
+	string state = stateStream.str();
+	vector<CheatCode> cheats = _emu->GetCheatManager()->GetCheats();
+
+	_lastStateId++;
+	if(_lastStateId == 0) {
+		_lastStateId++;
+	}
+
+	//The full message and the delta message for each base state are only built once, no matter how many clients need them
+	string fullPacket;
+	unordered_map<uint32_t, string> deltaPackets;
+	for(GameServerConnection* connection : connections) {
+		connection->SendGameInformation();
+
+		uint32_t baseId = connection->GetStateId();
+		if(baseId != 0) {
+			string& deltaPacket = deltaPackets[baseId];
+			if(deltaPacket.empty()) {
+				SaveStateMessage message(state, _lastStateId, cheats, &connection->GetStateBase(), baseId);
+				deltaPacket = message.GetPacket();
+			}
+			connection->SendPacket(deltaPacket);
+		} else {
+			if(fullPacket.empty()) {
+				SaveStateMessage message(state, _lastStateId, cheats);
+				fullPacket = message.GetPacket();
 			}
+			connection->SendPacket(fullPacket);
 		}
+		connection->SetStateBase(state, _lastStateId);
+	}
+}
+
+void GameServer::SendStateChecksum()
+{
+	vector<GameServerConnection*> connections = GetActiveConnections();
+	if(connections.empty()) {
+		return;
+	}
+
+	stringstream state;
+	_emu->Serialize(state, false, 0);
+	string data = state.str();
+
+	StateChecksumMessage message(_emu->GetFrameCount(), CRC32::GetCRC((uint8_t*)data.data(), data.size()));
+	string packet = message.GetPacket();
+	for(GameServerConnection* connection : connections) {
+		connection->SendPacket(packet);
 	}
 }
 
@@ -102,6 +186,43 @@ void GameServer::ProcessNotification(ConsoleNotificationType type, void * parame
 		connection->ProcessNotification(type, parameter);
 	}
 
+	switch(type) {
+		case ConsoleNotificationType::GamePaused:
+		case ConsoleNotificationType::GameLoaded:
+		case ConsoleNotificationType::GameResumed:
+		case ConsoleNotificationType::GameReset:
+		case ConsoleNotificationType::StateLoaded:
+		case ConsoleNotificationType::CheatsChanged:
+		case ConsoleNotificationType::ConfigChanged:
+			SendGameState(GetActiveConnections());
+			break;
+
+		case ConsoleNotificationType::PpuFrameDone: {
+			if(_openConnections.empty()) {
+				break;
+			}
+
+			//Detect any configuration change that impacts emulation
+			//Send a save state to clients if any change is done
+			Serializer s(0, true);
+			EmuSettings* settings = _emu->GetSettings();
+			s.Stream(*settings, "", -1);
+			stringstream currentConfig;
+			s.SaveTo(currentConfig, 0);
+
+			if(_previousConfig != currentConfig.str()) {
+				SendGameState(GetActiveConnections());
+			} else if(_emu->GetFrameCount() % GameServer::ChecksumInterval == 0) {
+				SendStateChecksum();
+			}
+			_previousConfig = currentConfig.str();
+			break;
+		}
+
+		default:
+			break;
+	}
+
 	if(type == ConsoleNotificationType::GameLoaded) {
 		//Register the server as an input provider/recorder
 		RegisterServerInput();
@@ -113,6 +234,7 @@ void GameServer::Exec()
 	_listener.reset(new Socket());
 	_listener->Bind(_port);
 	_listener->Listen(10);
+	_poller.Add(_listener.get());
 	_stop = false;
 	_initialized = true;
 	MessageManager::DisplayMessage("NetPlay" , "ServerStarted", std::to_string(_port));
@@ -121,7 +243,13 @@ void GameServer::Exec()
 		AcceptConnections();
 		UpdateConnections();
 
-		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+		//Sleep until a connection attempt or a message is received
+		_poller.Wait(GameServer::MaxWaitTime);
+	}
+
+	_poller.Remove(_listener.get());
+	for(unique_ptr<GameServerConnection>& connection : _openConnections) {
+		_poller.Remove(connection->GetSocket());
 	}
 }
 
@@ -145,6 +273,7 @@ void GameServer::StopServer()
 	}
 
 	_stop = true;
+	_poller.Wake();
 
 	if(_serverThread) {
 		_serverThread->join();
@@ -7,15 +7,19 @@
 #include "Shared/Interfaces/IInputProvider.h"
 #include "Shared/Interfaces/IInputRecorder.h"
 #include "Shared/IControllerHub.h"
+#include "Utilities/Socket.h"
 
 class Emulator;
 
 class GameServer : public IInputRecorder, public IInputProvider, public INotificationListener, public std::enable_shared_from_this<GameServer>
 {
 private:
+	static constexpr int MaxWaitTime = 100;
+
 	Emulator* _emu;
 	unique_ptr<thread> _serverThread;
 	unique_ptr<Socket> _listener;
+	SocketPoller _poller;
 	atomic<bool> _stop;
 	uint16_t _port = 0;
 	string _password;
@@ -26,12 +30,23 @@ private:
 
 	NetplayControllerInfo _hostControllerPort = {};
 
+	//Each connection keeps the last state it received, the next state sent to it only contains the difference
+	uint32_t _lastStateId = 0;
+
+	string _previousConfig;
+
+	vector<GameServerConnection*> GetActiveConnections();
+	void SendStateChecksum();
+
 	void AcceptConnections();
 	void UpdateConnections();
 
 	void Exec();
 
 public:
+	//Also used by rollback clients to know which frames the server sends a checksum for
+	static constexpr uint32_t ChecksumInterval = 300;
+
 	GameServer(Emulator* emu);
 	virtual ~GameServer();
 
@@ -46,6 +61,7 @@ public:
 	vector<NetplayControllerUsageInfo> GetControllerList();
 	vector<PlayerInfo> GetPlayerList();
 	void SendPlayerList();
+	void SendGameState(vector<GameServerConnection*> connections);
 	
 	static vector<NetplayControllerUsageInfo> GetControllerList(Emulator* emu, vector<PlayerInfo>& players);
 
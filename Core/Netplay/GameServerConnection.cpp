@@ -3,9 +3,7 @@
 #include "Netplay/GameServerConnection.h"
 #include "Netplay/HandShakeMessage.h"
 #include "Netplay/InputDataMessage.h"
-#include "Netplay/MovieDataMessage.h"
 #include "Netplay/GameInformationMessage.h"
-#include "Netplay/SaveStateMessage.h"
 #include "Netplay/ClientConnectionData.h"
 #include "Netplay/SelectControllerMessage.h"
 #include "Netplay/PlayerListMessage.h"
@@ -24,6 +22,7 @@ GameServerConnection::GameServerConnection(GameServer* gameServer, Emulator* emu
 	_server = gameServer;
 	_serverPassword = serverPassword;
 	_controllerPort = NetplayControllerInfo { GameConnection::SpectatorPort, 0 };
+	_stateId = 0;
 	SendServerInformation();
 }
 
@@ -52,19 +51,16 @@ void GameServerConnection::SendServerInformation()
 
 void GameServerConnection::SendGameInformation()
 {
-	auto lock = _emu->AcquireLock();
+	//The save state is sent by GameServer::SendGameState
 	RomInfo romInfo = _emu->GetRomInfo();
 	GameInformationMessage gameInfo(romInfo.RomFile.GetFileName(), _emu->GetCrc32(), _controllerPort, _emu->IsPaused());
 	SendNetMessage(gameInfo);
-	SaveStateMessage saveState(_emu);
-	SendNetMessage(saveState);
 }
 
-void GameServerConnection::SendMovieData(uint8_t port, ControlDeviceState state)
+void GameServerConnection::SendMovieData(string& packet)
 {
 	if(_handshakeCompleted) {
-		MovieDataMessage message(state, port);
-		SendNetMessage(message);
+		SendPacket(packet);
 	}
 }
 
@@ -75,17 +71,30 @@ void GameServerConnection::SendForceDisconnectMessage(string disconnectMessage)
 	Disconnect();
 }
 
-void GameServerConnection::PushState(ControlDeviceState state)
+void GameServerConnection::PushState(InputDataMessage* message)
 {
+	//Inputs tagged for an older state (sent before the client received the current state) are applied right away
+	uint32_t stateId = message->GetStateId();
+	uint32_t pollCounter = stateId != 0 && stateId == _stateId ? message->GetPollCounter() : 0;
+
 	auto lock = _inputLock.AcquireSafe();
-	_inputData = state;
+	_pendingInputs.push_back({ pollCounter, message->GetInputState() });
+	if(_pendingInputs.size() > GameServerConnection::MaxPendingInputs) {
+		_inputData = _pendingInputs.front().second;
+		_pendingInputs.pop_front();
+	}
 }
 
-ControlDeviceState GameServerConnection::GetState()
+ControlDeviceState GameServerConnection::GetState(uint32_t pollCounter)
 {
 	ControlDeviceState stateData;
 	{
 		auto lock = _inputLock.AcquireSafe();
+		//Inputs that arrive after the poll they were meant for are applied on the next poll (the client rolls back when it receives the actual input)
+		while(!_pendingInputs.empty() && _pendingInputs.front().first <= pollCounter) {
+			_inputData = _pendingInputs.front().second;
+			_pendingInputs.pop_front();
+		}
 		stateData = _inputData;
 	}
 	return stateData;
@@ -103,7 +112,7 @@ void GameServerConnection::ProcessHandshakeResponse(HandShakeMessage* message)
 			MessageManager::DisplayMessage("NetPlay", "Player connected.");
 
 			if(_emu->IsRunning()) {
-				SendGameInformation();
+				_server->SendGameState({ this });
 			}
 
 			_handshakeCompleted = true;
@@ -130,7 +139,7 @@ void GameServerConnection::ProcessMessage(NetMessage* message)
 				SendForceDisconnectMessage("Handshake has not been completed - invalid packet");
 				return;
 			}
-			PushState(((InputDataMessage*)message)->GetInputState());
+			PushState((InputDataMessage*)message);
 			break;
 
 		case MessageType::SelectController:
@@ -141,6 +150,17 @@ void GameServerConnection::ProcessMessage(NetMessage* message)
 			SelectControllerPort(((SelectControllerMessage*)message)->GetController());
 			break;
 
+		case MessageType::ResyncRequest:
+			if(!_handshakeCompleted) {
+				SendForceDisconnectMessage("Handshake has not been completed - invalid packet");
+				return;
+			}
+			//The client's state does not match the server's, send a full state
+			_stateBase.clear();
+			_stateId = 0;
+			_server->SendGameState({ this });
+			break;
+
 		default:
 			break;
 	}
@@ -166,48 +186,17 @@ void GameServerConnection::SelectControllerPort(NetplayControllerInfo controller
 			//Another player is using this port, we can't use it
 		}
 	}
-	SendGameInformation();
+	_server->SendGameState({ this });
 	_server->SendPlayerList();
 }
 
 void GameServerConnection::ProcessNotification(ConsoleNotificationType type, void* parameter)
 {
-	switch(type) {
-		case ConsoleNotificationType::GamePaused:
-		case ConsoleNotificationType::GameLoaded:
-		case ConsoleNotificationType::GameResumed:
-		case ConsoleNotificationType::GameReset:
-		case ConsoleNotificationType::StateLoaded:
-		case ConsoleNotificationType::CheatsChanged:
-		case ConsoleNotificationType::ConfigChanged:
-			SendGameInformation();
-			break;
-		
-		case ConsoleNotificationType::PpuFrameDone: {
-			//Detect any configuration change that impacts emulation
-			//Send a save state to clients if any change is done
-			Serializer s(0, true);
-			EmuSettings* settings = _emu->GetSettings();
-			s.Stream(*settings, "", -1);
-			stringstream currentConfig;
-			s.SaveTo(currentConfig, 0);
-
-			if(_previousConfig != currentConfig.str()) {
-				SendGameInformation();
-			}
-			_previousConfig = currentConfig.str();
-			break;
-		}
-
-		case ConsoleNotificationType::BeforeEmulationStop: {
-			//Make clients unload the current game
-			GameInformationMessage gameInfo("", 0, _controllerPort, true);
-			SendNetMessage(gameInfo);
-			break;
-		}
-
-		default:
-			break;
+	//Notifications that require sending the game's state are processed by GameServer
+	if(type == ConsoleNotificationType::BeforeEmulationStop) {
+		//Make clients unload the current game
+		GameInformationMessage gameInfo("", 0, _controllerPort, true);
+		SendNetMessage(gameInfo);
 	}
 }
 
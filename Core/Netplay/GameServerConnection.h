@@ -9,6 +9,7 @@
 #include "Utilities/SimpleLock.h"
 
 class HandShakeMessage;
+class InputDataMessage;
 class GameServer;
 
 class GameServerConnection final : public GameConnection, public INotificationListener
@@ -16,19 +17,25 @@ class GameServerConnection final : public GameConnection, public INotificationLi
 private:
 	GameServer* _server = nullptr;
 
+	static constexpr uint32_t MaxPendingInputs = 60;
+
 	SimpleLock _inputLock;
 	ControlDeviceState _inputData = {};
 
-	string _previousConfig = "";
+	//Inputs received from the client that must be applied on a later input poll (poll counter, state), in the order they were received
+	std::deque<std::pair<uint32_t, ControlDeviceState>> _pendingInputs;
 
 	NetplayControllerInfo _controllerPort = {};
 	string _connectionHash;
 	string _serverPassword;
 	bool _handshakeCompleted = false;
 
-	void PushState(ControlDeviceState state);
+	//Last state sent to the client (and its ID), used to send the difference between it and the next state
+	string _stateBase;
+	atomic<uint32_t> _stateId;
+
+	void PushState(InputDataMessage* message);
 	void SendServerInformation();
-	void SendGameInformation();
 	void SelectControllerPort(NetplayControllerInfo port);
 
 	void SendForceDisconnectMessage(string disconnectMessage);
@@ -42,8 +49,15 @@ public:
 	GameServerConnection(GameServer* gameServer, Emulator* emu, unique_ptr<Socket> socket, string serverPassword);
 	virtual ~GameServerConnection();
 
-	ControlDeviceState GetState();
-	void SendMovieData(uint8_t port, ControlDeviceState state);
+	//Returns the client's input for the given input poll
+	ControlDeviceState GetState(uint32_t pollCounter);
+	void SendMovieData(string& packet);
+	void SendGameInformation();
+
+	bool IsHandshakeCompleted() { return _handshakeCompleted; }
+	uint32_t GetStateId() { return _stateId; }
+	string& GetStateBase() { return _stateBase; }
+	void SetStateBase(const string& state, uint32_t stateId) { _stateBase = state; _stateId = stateId; }
 
 	NetplayControllerInfo GetControllerPort();
 
@@ -8,22 +8,34 @@ class InputDataMessage : public NetMessage
 private:
 	ControlDeviceState _inputState;
 
+	//Input poll the server must apply the input to (0 = as soon as it is received)
+	//The poll counter is only meaningful for the state the client is running (the last state it received from the server)
+	uint32_t _pollCounter = 0;
+	uint32_t _stateId = 0;
+
 protected:	
 	void Serialize(Serializer &s) override
 	{
 		SVVector(_inputState.State);
+		SV(_pollCounter);
+		SV(_stateId);
 	}
 
 public:
 	InputDataMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
 
-	InputDataMessage(ControlDeviceState inputState) : NetMessage(MessageType::InputData)
+	InputDataMessage(ControlDeviceState inputState, uint32_t pollCounter = 0, uint32_t stateId = 0) : NetMessage(MessageType::InputData)
 	{
 		_inputState = inputState;
+		_pollCounter = pollCounter;
+		_stateId = stateId;
 	}
 
 	ControlDeviceState GetInputState()
 	{
 		return _inputState;
 	}
+
+	uint32_t GetPollCounter() { return _pollCounter; }
+	uint32_t GetStateId() { return _stateId; }
 };
\ No newline at end of file
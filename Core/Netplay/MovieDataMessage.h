@@ -1,37 +1,56 @@
 #pragma once
 #include "pch.h"
 #include "Netplay/NetMessage.h"
+#include "Shared/BaseControlDevice.h"
 #include "Shared/ControlDeviceState.h"
 
+//Contains the input of all ports for a single input poll
 class MovieDataMessage : public NetMessage
 {
 private:
-	uint8_t _portNumber = 0;
-	ControlDeviceState _inputState = {};
+	vector<uint8_t> _ports;
+	vector<ControlDeviceState> _inputStates;
 
 protected:
 	void Serialize(Serializer &s) override
 	{
-		SV(_portNumber);
-		SVVector(_inputState.State);
+		uint32_t portCount = (uint32_t)_ports.size();
+		SV(portCount);
+		if(!s.IsSaving()) {
+			portCount = std::min<uint32_t>(portCount, BaseControlDevice::PortCount);
+			_ports.resize(portCount);
+			_inputStates.resize(portCount);
+		}
+
+		for(uint32_t i = 0; i < portCount; i++) {
+			SVI(_ports[i]);
+			SVVectorI(_inputStates[i].State);
+		}
 	}
 
 public:
 	MovieDataMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
 
-	MovieDataMessage(ControlDeviceState state, uint8_t port) : NetMessage(MessageType::MovieData)
+	MovieDataMessage(vector<shared_ptr<BaseControlDevice>>& devices) : NetMessage(MessageType::MovieData)
+	{
+		for(shared_ptr<BaseControlDevice>& device : devices) {
+			_ports.push_back(device->GetPort());
+			_inputStates.push_back(device->GetRawState());
+		}
+	}
+
+	uint32_t GetPortCount()
 	{
-		_portNumber = port;
-		_inputState = state;
+		return (uint32_t)_ports.size();
 	}
 
-	uint8_t GetPortNumber()
+	uint8_t GetPortNumber(uint32_t index)
 	{
-		return _portNumber;
+		return _ports[index];
 	}
 
-	ControlDeviceState GetInputState()
+	ControlDeviceState GetInputState(uint32_t index)
 	{
-		return _inputState;
+		return _inputStates[index];
 	}
-};
\ No newline at end of file
+};
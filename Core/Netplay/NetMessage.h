@@ -40,7 +40,8 @@ public:
 		return _type;
 	}
 
-	void Send(Socket &socket)
+	//Returns the data to send over the network (can be sent to several connections)
+	string GetPacket()
 	{
 		Serializer s(SaveStateManager::FileFormatVersion, true);
 		Serialize(s);
@@ -50,8 +51,7 @@ public:
 
 		string data = out.str();
 		uint32_t messageLength = (uint32_t)data.size() + 1;
-		data = string((char*)&messageLength, 4) + (char)_type + data;
-		socket.Send((char*)data.c_str(), (int)data.size(), 0);
+		return string((char*)&messageLength, 4) + (char)_type + data;
 	}
 
 protected:
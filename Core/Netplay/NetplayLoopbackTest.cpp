@@ -0,0 +1,188 @@
+#include "pch.h"
+#include "Netplay/NetplayLoopbackTest.h"
+#include "Netplay/GameServer.h"
+#include "Netplay/GameClient.h"
+#include "Netplay/ClientConnectionData.h"
+#include "Netplay/RollbackManager.h"
+#include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
+#include "Shared/BaseControlDevice.h"
+#include "Shared/IControllerHub.h"
+#include "Utilities/VirtualFile.h"
+
+NetplayLoopbackTest::NetplayLoopbackTest(uint32_t latency, uint32_t jitter)
+{
+	_latency = latency;
+	_jitter = jitter;
+	_random.seed(0x4E455450);
+	_stopProxy = false;
+}
+
+NetplayLoopbackTest::~NetplayLoopbackTest()
+{
+	_stopProxy = true;
+	if(_proxyThread) {
+		_proxyThread->join();
+	}
+}
+
+unique_ptr<Emulator> NetplayLoopbackTest::CreateEmulator(string romPath)
+{
+	unique_ptr<Emulator> emu(new Emulator());
+	emu->Initialize(false);
+	emu->GetSettings()->SetFlag(EmulationFlags::ConsoleMode);
+	if(!emu->LoadRom((VirtualFile)romPath, VirtualFile())) {
+		emu->Release();
+		return nullptr;
+	}
+	return emu;
+}
+
+NetplayLoopbackTestResult NetplayLoopbackTest::Run(string romPath, uint32_t rollbackFrames, uint32_t frameCount, uint16_t port)
+{
+	NetplayLoopbackTestResult result = {};
+
+	unique_ptr<Emulator> server = CreateEmulator(romPath);
+	unique_ptr<Emulator> client = server ? CreateEmulator(romPath) : nullptr;
+	if(!server || !client) {
+		if(server) {
+			server->Stop(false);
+			server->Release();
+		}
+		return result;
+	}
+
+	server->GetGameServer()->StartServer(port, "");
+	_hostPort = server->GetGameServer()->GetHostControllerPort().Port;
+	server->RegisterInputProvider(this);
+
+	//The client connects to the proxy, which connects to the server once the client's connection is accepted
+	uint16_t proxyPort = port + 1;
+	_listener.reset(new Socket());
+	_listener->Bind(proxyPort);
+	_listener->Listen(1);
+	_stopProxy = false;
+	_proxyThread.reset(new std::thread(&NetplayLoopbackTest::RunProxy, this, port));
+
+	ClientConnectionData connectionData("127.0.0.1", proxyPort, "", false, rollbackFrames);
+	client->GetGameClient()->Connect(connectionData);
+
+	//Count the frames once the client has received the game state from the server
+	double fps = server->GetFps();
+	double timeout = (frameCount * 1000.0 / fps) * 2 + 10000;
+	uint32_t startFrame = 0;
+	bool started = false;
+	Timer timer;
+	while(timer.GetElapsedMS() < timeout) {
+		shared_ptr<RollbackManager> rollback = client->GetGameClient()->GetRollbackManager();
+		if(rollback && rollback->IsEnabled()) {
+			if(!started) {
+				startFrame = client->GetFrameCount();
+				started = true;
+			} else if(client->GetFrameCount() - startFrame >= frameCount) {
+				RollbackStats stats = rollback->GetStats();
+				result.FrameCount = client->GetFrameCount() - startFrame;
+				result.RollbackCount = stats.RollbackCount;
+				result.MaxDepth = stats.MaxDepth;
+				result.AverageDepth = stats.RollbackCount ? (double)stats.TotalDepth / stats.RollbackCount : 0;
+				result.StallCount = stats.StallCount;
+				break;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(10));
+	}
+
+	//The host's input reaches the client after the one-way latency (+ jitter), the client should never have to
+	//run more frames than that again (+2 frames for the input poll and the frame that was in progress)
+	uint32_t expectedDepth = (uint32_t)std::ceil((_latency + _jitter) * fps / 1000) + 2;
+	result.MaxExpectedDepth = std::min(expectedDepth, std::max<uint32_t>(rollbackFrames, 1));
+	result.Passed = result.FrameCount >= frameCount && result.MaxDepth <= result.MaxExpectedDepth;
+
+	client->GetGameClient()->Disconnect();
+	server->UnregisterInputProvider(this);
+	server->GetGameServer()->StopServer();
+
+	_stopProxy = true;
+	_proxyThread->join();
+	_proxyThread.reset();
+	_listener.reset();
+
+	client->Stop(false);
+	client->Release();
+	server->Stop(false);
+	server->Release();
+
+	return result;
+}
+
+void NetplayLoopbackTest::RunProxy(uint16_t serverPort)
+{
+	//Accessed by the proxy thread only
+	std::mt19937 random(0x4C4F4F50);
+
+	unique_ptr<Socket> clientSocket;
+	while(!_stopProxy) {
+		clientSocket = _listener->Accept();
+		if(!clientSocket->ConnectionError()) {
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+	}
+
+	if(_stopProxy) {
+		return;
+	}
+
+	unique_ptr<Socket> serverSocket(new Socket());
+	if(!serverSocket->Connect("127.0.0.1", serverPort)) {
+		return;
+	}
+
+	std::deque<DelayedData> toServer;
+	std::deque<DelayedData> toClient;
+	while(!_stopProxy && !clientSocket->ConnectionError() && !serverSocket->ConnectionError()) {
+		ForwardData(clientSocket.get(), serverSocket.get(), toServer, random);
+		ForwardData(serverSocket.get(), clientSocket.get(), toClient, random);
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+	}
+}
+
+void NetplayLoopbackTest::ForwardData(Socket* src, Socket* dst, std::deque<DelayedData>& queue, std::mt19937& random)
+{
+	char buffer[0x10000];
+	int bytesReceived;
+	while((bytesReceived = src->Recv(buffer, sizeof(buffer), 0)) > 0) {
+		double sendTime = _timer.GetElapsedMS() + _latency + (_jitter ? random() % (_jitter + 1) : 0);
+		if(!queue.empty()) {
+			//Jitter can't reorder the data (this is a TCP stream)
+			sendTime = std::max(sendTime, queue.back().SendTime);
+		}
+		queue.push_back({ sendTime, vector<char>(buffer, buffer + bytesReceived) });
+	}
+
+	double now = _timer.GetElapsedMS();
+	while(!queue.empty() && queue.front().SendTime <= now) {
+		dst->Send(queue.front().Data.data(), (int)queue.front().Data.size(), 0);
+		queue.pop_front();
+	}
+}
+
+bool NetplayLoopbackTest::SetInput(BaseControlDevice* device)
+{
+	//Randomize the host's input every few polls, the client has to predict it
+	if(device->GetPort() != _hostPort || dynamic_cast<IControllerHub*>(device)) {
+		return false;
+	}
+
+	if(_hostInputPolls == 0 || _hostInput.State.size() != device->GetRawState().State.size()) {
+		_hostInput = device->GetRawState();
+		for(uint8_t& value : _hostInput.State) {
+			value = (uint8_t)_random();
+		}
+		_hostInputPolls = 5 + _random() % 30;
+	}
+	_hostInputPolls--;
+
+	device->SetRawState(_hostInput);
+	return true;
+}
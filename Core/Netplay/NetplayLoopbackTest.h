@@ -0,0 +1,61 @@
+#pragma once
+#include "pch.h"
+#include <deque>
+#include <random>
+#include <thread>
+#include "Shared/Interfaces/IInputProvider.h"
+#include "Shared/ControlDeviceState.h"
+#include "Utilities/Socket.h"
+#include "Utilities/Timer.h"
+
+class Emulator;
+
+struct NetplayLoopbackTestResult
+{
+	bool Passed;
+	uint32_t FrameCount;
+	uint32_t RollbackCount;
+	uint32_t MaxDepth;
+	double AverageDepth;
+	uint32_t StallCount;
+	uint32_t MaxExpectedDepth;
+};
+
+//Runs a netplay server and a rollback client in the same process (two background emulator instances), connected
+//through a proxy that delays the data sent in both directions by the given latency (plus random jitter).
+//The host's input is randomized to force mispredictions, the test passes if the rollback depth stays bounded
+//by the amount of frames needed for the host's input to reach the client.
+class NetplayLoopbackTest : public IInputProvider
+{
+private:
+	struct DelayedData
+	{
+		double SendTime;
+		vector<char> Data;
+	};
+
+	uint32_t _latency = 0;
+	uint32_t _jitter = 0;
+	std::mt19937 _random;
+
+	unique_ptr<std::thread> _proxyThread;
+	atomic<bool> _stopProxy;
+	unique_ptr<Socket> _listener;
+	Timer _timer;
+
+	uint8_t _hostPort = 0;
+	ControlDeviceState _hostInput;
+	uint32_t _hostInputPolls = 0;
+
+	unique_ptr<Emulator> CreateEmulator(string romPath);
+	void RunProxy(uint16_t serverPort);
+	void ForwardData(Socket* src, Socket* dst, std::deque<DelayedData>& queue, std::mt19937& random);
+
+public:
+	NetplayLoopbackTest(uint32_t latency, uint32_t jitter);
+	virtual ~NetplayLoopbackTest();
+
+	NetplayLoopbackTestResult Run(string romPath, uint32_t rollbackFrames, uint32_t frameCount, uint16_t port = 8889);
+
+	bool SetInput(BaseControlDevice* device) override;
+};
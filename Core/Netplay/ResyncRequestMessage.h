@@ -0,0 +1,16 @@
+#pragma once
+#include "pch.h"
+#include "Netplay/NetMessage.h"
+
+//Sent by clients when their state does not match the server's checksum, the server replies with a full state
+class ResyncRequestMessage : public NetMessage
+{
+protected:
+	void Serialize(Serializer &s) override
+	{
+	}
+
+public:
+	ResyncRequestMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
+	ResyncRequestMessage() : NetMessage(MessageType::ResyncRequest) { }
+};
@@ -0,0 +1,328 @@
+#include "pch.h"
+#include "Netplay/RollbackManager.h"
+#include "Shared/Emulator.h"
+#include "Shared/MessageManager.h"
+#include "Shared/SaveStateManager.h"
+
+RollbackManager::RollbackManager(Emulator* emu, uint32_t maxFrames)
+{
+	_emu = emu;
+	_maxFrames = std::max<uint32_t>(maxFrames, 1);
+	_enabled = false;
+}
+
+void RollbackManager::Reset()
+{
+	auto lock = _lock.AcquireSafe();
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		_inputs[i].clear();
+		_inputOffset[i] = 0;
+		_confirmedCount[i] = 0;
+		_readIndex[i] = 0;
+		_mispredictIndex[i] = RollbackManager::NoMisprediction;
+		_lastConfirmed[i] = {};
+	}
+
+	_frames.clear();
+	_frames.resize(_maxFrames);
+	_frameIndex = 0;
+	_predictInput = false;
+	_localChecksums.clear();
+	_serverChecksums.clear();
+	_enabled = true;
+	_inputSignal.Signal();
+}
+
+void RollbackManager::Disable()
+{
+	_enabled = false;
+	_inputSignal.Signal();
+}
+
+void RollbackManager::SetLocalInput(uint8_t port, ControlDeviceState state)
+{
+	auto lock = _lock.AcquireSafe();
+	_localPort = port;
+	_localInput = state;
+}
+
+void RollbackManager::AddConfirmedInput(uint8_t port, ControlDeviceState state)
+{
+	auto lock = _lock.AcquireSafe();
+	uint32_t index = _confirmedCount[port]++;
+	uint32_t pos = index - _inputOffset[port];
+	if(pos < _inputs[port].size()) {
+		//The client already predicted this input, rollback if it has been used and was wrong
+		RollbackInput& input = _inputs[port][pos];
+		if(index < _readIndex[port] && input.State != state) {
+			_mispredictIndex[port] = std::min(_mispredictIndex[port], index);
+		}
+		input.State = state;
+		input.Confirmed = true;
+	} else {
+		_inputs[port].push_back({ state, true });
+	}
+	_lastConfirmed[port] = state;
+	_inputSignal.Signal();
+}
+
+bool RollbackManager::GetInput(uint8_t port, ControlDeviceState& state)
+{
+	while(true) {
+		{
+			auto lock = _lock.AcquireSafe();
+			if(!_enabled) {
+				return false;
+			}
+
+			uint32_t index = _readIndex[port];
+			uint32_t pos = index - _inputOffset[port];
+			if(pos < _inputs[port].size() && _inputs[port][pos].Confirmed) {
+				_readIndex[port]++;
+				state = _inputs[port][pos].State;
+				return true;
+			}
+
+			if(_predictInput) {
+				//The player's own input for this poll is already known (the server applies it on the poll it was sent for),
+				//only the other ports are predicted, using the last input received from the server
+				_readIndex[port]++;
+				ControlDeviceState& lastConfirmed = _lastConfirmed[port];
+				bool useLocalInput = port == _localPort && !_localInput.State.empty() && (lastConfirmed.State.empty() || lastConfirmed.State.size() == _localInput.State.size());
+				state = useLocalInput ? _localInput : lastConfirmed;
+
+				if(pos < _inputs[port].size()) {
+					_inputs[port][pos].State = state;
+				} else {
+					_inputs[port].push_back({ state, false });
+				}
+				return !state.State.empty();
+			}
+		}
+
+		//The rollback loop is not running (e.g while debugging), so a misprediction could not be
+		//corrected - wait for the server's input instead
+		_inputSignal.Wait(50);
+	}
+}
+
+uint32_t RollbackManager::GetBufferedInputCount(uint8_t port)
+{
+	auto lock = _lock.AcquireSafe();
+	return _confirmedCount[port] > _readIndex[port] ? _confirmedCount[port] - _readIndex[port] : 0;
+}
+
+uint32_t* RollbackManager::GetFrameReadIndex(uint32_t frame)
+{
+	//The read index at the start of the frame that is about to run is not saved yet
+	return frame == _frameIndex ? _readIndex : _frames[frame % _maxFrames].ReadIndex;
+}
+
+bool RollbackManager::CanReleaseOldestFrame()
+{
+	if(_frameIndex < _maxFrames) {
+		return true;
+	}
+
+	//The oldest frame's state can only be discarded once all of the inputs it used have been received
+	uint32_t* readIndex = GetFrameReadIndex(_frameIndex - _maxFrames + 1);
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		if(readIndex[i] > _confirmedCount[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void RollbackManager::TrimInputs()
+{
+	uint32_t oldestFrame = _frameIndex > _maxFrames ? _frameIndex - _maxFrames : 0;
+	uint32_t* readIndex = _frames[oldestFrame % _maxFrames].ReadIndex;
+	bool inputRead = false;
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		inputRead |= readIndex[i] != _readIndex[i];
+	}
+
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		if(inputRead && readIndex[i] == _readIndex[i]) {
+			//All devices are read on each input poll - a port that was not read while other ports were has no
+			//device connected to it on this client, skip the inputs the server sent for it so they don't pile up
+			uint32_t skipIndex = std::max(_readIndex[i], _confirmedCount[i]);
+			for(RollbackFrame& frame : _frames) {
+				if(frame.ReadIndex[i] == _readIndex[i]) {
+					frame.ReadIndex[i] = skipIndex;
+				}
+			}
+			_readIndex[i] = skipIndex;
+		}
+
+		while(_inputOffset[i] < readIndex[i] && !_inputs[i].empty() && _inputs[i].front().Confirmed) {
+			_inputs[i].pop_front();
+			_inputOffset[i]++;
+		}
+	}
+}
+
+uint32_t RollbackManager::Rollback()
+{
+	bool stalled = false;
+	while(true) {
+		{
+			auto lock = _lock.AcquireSafe();
+			if(!_enabled) {
+				return 0;
+			} else if(CanReleaseOldestFrame()) {
+				break;
+			} else if(!stalled) {
+				//Too far ahead of the server, wait for its input
+				stalled = true;
+				_stats.StallCount++;
+			}
+		}
+		_inputSignal.Wait(50);
+	}
+
+	RollbackFrame* frame = nullptr;
+	uint32_t frameCount = 0;
+	{
+		auto lock = _lock.AcquireSafe();
+		bool mispredicted = false;
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			mispredicted |= _mispredictIndex[i] != RollbackManager::NoMisprediction;
+		}
+
+		if(!mispredicted) {
+			return 0;
+		}
+
+		//Find the most recent frame that started before the first mispredicted input (for all ports)
+		uint32_t oldestFrame = _frameIndex > _maxFrames ? _frameIndex - _maxFrames : 0;
+		for(int64_t i = (int64_t)_frameIndex - 1; i >= oldestFrame; i--) {
+			RollbackFrame& candidate = _frames[i % _maxFrames];
+			bool isValid = !candidate.State.empty();
+			for(int j = 0; j < BaseControlDevice::PortCount; j++) {
+				if(candidate.ReadIndex[j] > _mispredictIndex[j]) {
+					isValid = false;
+					break;
+				}
+			}
+
+			if(isValid) {
+				frame = &candidate;
+				frameCount = _frameIndex - (uint32_t)i;
+				_frameIndex = (uint32_t)i;
+				break;
+			}
+		}
+
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			_mispredictIndex[i] = RollbackManager::NoMisprediction;
+		}
+
+		if(!frame) {
+			MessageManager::Log("[Netplay] Input received too late to rollback, client may be desynchronized.");
+			return 0;
+		}
+
+		memcpy(_readIndex, frame->ReadIndex, sizeof(_readIndex));
+	}
+
+	stringstream state(frame->State);
+	_emu->Deserialize(state, SaveStateManager::FileFormatVersion, false, std::nullopt, false);
+	return frameCount;
+}
+
+bool RollbackManager::SaveFrame(bool saveState)
+{
+	if(!_enabled) {
+		return false;
+	}
+
+	RollbackFrame& frame = _frames[_frameIndex % _maxFrames];
+	if(saveState) {
+		stringstream state;
+		_emu->Serialize(state, false, 0);
+		frame.State = state.str();
+	} else {
+		//The rollback loop is not running, this frame can't be used to rollback
+		frame.State.clear();
+	}
+
+	auto lock = _lock.AcquireSafe();
+	memcpy(frame.ReadIndex, _readIndex, sizeof(_readIndex));
+	_frameIndex++;
+	_predictInput = saveState;
+	TrimInputs();
+	return true;
+}
+
+void RollbackManager::AddLocalChecksum(uint32_t frameCount, uint32_t checksum)
+{
+	auto lock = _lock.AcquireSafe();
+
+	//Frames that are run again after a rollback replace the checksums calculated with the mispredicted input
+	while(!_localChecksums.empty() && _localChecksums.back().FrameCount >= frameCount) {
+		_localChecksums.pop_back();
+	}
+
+	RollbackChecksum entry = { frameCount, checksum };
+	memcpy(entry.ReadIndex, _readIndex, sizeof(_readIndex));
+	_localChecksums.push_back(entry);
+	if(_localChecksums.size() > 10) {
+		_localChecksums.pop_front();
+	}
+}
+
+void RollbackManager::AddServerChecksum(uint32_t frameCount, uint32_t checksum)
+{
+	auto lock = _lock.AcquireSafe();
+	_serverChecksums.push_back({ frameCount, checksum });
+	if(_serverChecksums.size() > 10) {
+		_serverChecksums.pop_front();
+	}
+}
+
+bool RollbackManager::VerifyChecksums()
+{
+	auto lock = _lock.AcquireSafe();
+	bool match = true;
+	while(!_localChecksums.empty()) {
+		RollbackChecksum& local = _localChecksums.front();
+		for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+			if(local.ReadIndex[i] > _confirmedCount[i]) {
+				//The frame was run with predicted input, it can only be compared once the server's input is received
+				return match;
+			}
+		}
+
+		while(!_serverChecksums.empty() && _serverChecksums.front().first < local.FrameCount) {
+			_serverChecksums.pop_front();
+		}
+
+		if(_serverChecksums.empty()) {
+			//The server's checksum for this frame has not been received yet
+			return match;
+		} else if(_serverChecksums.front().first == local.FrameCount) {
+			match &= _serverChecksums.front().second == local.Checksum;
+			_serverChecksums.pop_front();
+		}
+		_localChecksums.pop_front();
+	}
+	return match;
+}
+
+void RollbackManager::AddRollbackStats(uint32_t frameCount, double time)
+{
+	auto lock = _lock.AcquireSafe();
+	_stats.RollbackCount++;
+	_stats.TotalDepth += frameCount;
+	_stats.MaxDepth = std::max(_stats.MaxDepth, frameCount);
+	_stats.TotalTime += time;
+	_stats.MaxTime = std::max(_stats.MaxTime, time);
+}
+
+RollbackStats RollbackManager::GetStats()
+{
+	auto lock = _lock.AcquireSafe();
+	return _stats;
+}
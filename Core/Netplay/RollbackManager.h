@@ -0,0 +1,115 @@
+#pragma once
+#include "pch.h"
+#include <deque>
+#include "Shared/BaseControlDevice.h"
+#include "Shared/ControlDeviceState.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
+
+class Emulator;
+
+struct RollbackStats
+{
+	uint32_t RollbackCount;
+	uint32_t TotalDepth;
+	uint32_t MaxDepth;
+	double TotalTime;
+	double MaxTime;
+	uint32_t StallCount;
+};
+
+//Used by netplay clients to hide the latency between the server and the client.
+//Instead of waiting for the server's input for each frame, the client predicts it (the last input received
+//for the port - the local player's own input is sent a few input polls ahead of time, so it is already known)
+//and keeps a save state for each of the last few frames. When the server's input arrives and does not match
+//the prediction, the client loads the state for the first frame that used a mispredicted input and runs the
+//following frames again (without audio/video) with the correct input. If the client gets too far ahead of the server, it waits for the server's input.
+class RollbackManager
+{
+private:
+	struct RollbackInput
+	{
+		ControlDeviceState State;
+		bool Confirmed;
+	};
+
+	struct RollbackFrame
+	{
+		string State;
+		uint32_t ReadIndex[BaseControlDevice::PortCount];
+	};
+
+	struct RollbackChecksum
+	{
+		uint32_t FrameCount;
+		uint32_t Checksum;
+		uint32_t ReadIndex[BaseControlDevice::PortCount];
+	};
+
+	static constexpr uint32_t NoMisprediction = UINT32_MAX;
+
+	Emulator* _emu = nullptr;
+	uint32_t _maxFrames = 0;
+
+	SimpleLock _lock;
+	AutoResetEvent _inputSignal;
+	atomic<bool> _enabled;
+
+	//Inputs received from the server (confirmed) or predicted by the client, for each port
+	std::deque<RollbackInput> _inputs[BaseControlDevice::PortCount];
+	uint32_t _inputOffset[BaseControlDevice::PortCount] = {};
+	uint32_t _confirmedCount[BaseControlDevice::PortCount] = {};
+	uint32_t _readIndex[BaseControlDevice::PortCount] = {};
+	uint32_t _mispredictIndex[BaseControlDevice::PortCount] = {};
+	ControlDeviceState _lastConfirmed[BaseControlDevice::PortCount];
+
+	uint8_t _localPort = 0xFF;
+	ControlDeviceState _localInput;
+
+	vector<RollbackFrame> _frames;
+	uint32_t _frameIndex = 0;
+
+	//Inputs are only predicted while the rollback loop is running (it is disabled while debugging)
+	bool _predictInput = false;
+
+	//Checksums of the client's state (calculated when the frame is run) and of the server's state (received from the server)
+	std::deque<RollbackChecksum> _localChecksums;
+	std::deque<std::pair<uint32_t, uint32_t>> _serverChecksums;
+
+	RollbackStats _stats = {};
+
+	uint32_t* GetFrameReadIndex(uint32_t frame);
+	bool CanReleaseOldestFrame();
+	void TrimInputs();
+
+public:
+	RollbackManager(Emulator* emu, uint32_t maxFrames);
+
+	bool IsEnabled() { return _enabled; }
+	void Reset();
+	void Disable();
+
+	//Sets the local player's input for the next input poll (an empty state if it is not known)
+	void SetLocalInput(uint8_t port, ControlDeviceState state);
+	void AddConfirmedInput(uint8_t port, ControlDeviceState state);
+	bool GetInput(uint8_t port, ControlDeviceState& state);
+	uint32_t GetBufferedInputCount(uint8_t port);
+
+	//Called by the emulation thread before each frame
+	//Returns the number of frames that must be run again (the state for the oldest of these frames is loaded)
+	uint32_t Rollback();
+
+	//Called by the emulation thread at the start of each frame - saveState is false when the rollback loop is not running,
+	//in which case GetInput waits for the server's input instead of predicting it
+	bool SaveFrame(bool saveState = true);
+
+	void AddLocalChecksum(uint32_t frameCount, uint32_t checksum);
+	void AddServerChecksum(uint32_t frameCount, uint32_t checksum);
+
+	//Compares the checksums of the frames whose inputs have all been received from the server
+	//Returns false if the client's state did not match the server's state
+	bool VerifyChecksums();
+	void AddRollbackStats(uint32_t frameCount, double time);
+
+	RollbackStats GetStats();
+};
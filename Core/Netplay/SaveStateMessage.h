@@ -5,44 +5,78 @@
 #include "Shared/EmuSettings.h"
 #include "Shared/CheatManager.h"
 #include "Shared/SaveStateManager.h"
+#include "Utilities/CompressionHelper.h"
 
 class SaveStateMessage : public NetMessage
 {
 private:
 	vector<CheatCode> _activeCheats;
 	vector<uint8_t> _stateData;
+	uint32_t _stateId = 0;
+
+	//ID of the state that was XORed with this state before compressing it (0 = full state)
+	uint32_t _baseStateId = 0;
+
+	static void XorState(string& data, string& baseState)
+	{
+		for(size_t i = 0, len = std::min(baseState.size(), data.size()); i < len; i++) {
+			data[i] ^= baseState[i];
+		}
+	}
 
 protected:
 	void Serialize(Serializer &s) override
 	{
 		SVVector(_stateData);
 		SVVector(_activeCheats);
+		SV(_stateId);
+		SV(_baseStateId);
 	}
 
 public:
 	SaveStateMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
 	
-	SaveStateMessage(Emulator* emu) : NetMessage(MessageType::SaveState)
+	//Used when sending state to clients - when a base state is given, only the difference with it is sent
+	SaveStateMessage(string state, uint32_t stateId, vector<CheatCode>& activeCheats, string* baseState = nullptr, uint32_t baseStateId = 0) : NetMessage(MessageType::SaveState)
 	{
-		//Used when sending state to clients
-		stringstream state;
-		{
-			auto lock = emu->AcquireLock();
-			_activeCheats = emu->GetCheatManager()->GetCheats();
-			emu->Serialize(state, true);
+		if(baseState) {
+			XorState(state, *baseState);
+			_baseStateId = baseStateId;
 		}
 
-		uint32_t dataSize = (uint32_t)state.tellp();
-		_stateData.resize(dataSize);
-		state.read((char*)_stateData.data(), dataSize);
+		_stateId = stateId;
+		_activeCheats = activeCheats;
+		CompressionHelper::Compress(state, 1, _stateData);
 	}
-	
-	void LoadState(Emulator* emu)
+
+	//Returns false if the message only contains the difference with a state the client doesn't have, or if the state could not be loaded
+	bool LoadState(Emulator* emu, string& baseState, uint32_t& baseStateId)
 	{
+		if(_baseStateId != 0 && _baseStateId != baseStateId) {
+			return false;
+		}
+
+		vector<uint8_t> data;
+		if(_stateData.empty() || !CompressionHelper::Decompress(_stateData, data)) {
+			return false;
+		}
+
+		string state((char*)data.data(), data.size());
+		if(_baseStateId != 0) {
+			XorState(state, baseState);
+		}
+
 		std::stringstream ss;
-		ss.write((char*)_stateData.data(), _stateData.size());
-		emu->Deserialize(ss, SaveStateManager::FileFormatVersion, true);
+		ss.write(state.data(), state.size());
+		if(emu->Deserialize(ss, SaveStateManager::FileFormatVersion, true) != DeserializeResult::Success) {
+			//The base state is left untouched, the server will send a full state
+			return false;
+		}
 
 		emu->GetCheatManager()->SetCheats(_activeCheats);
+
+		baseState = std::move(state);
+		baseStateId = _stateId;
+		return true;
 	}
-};
\ No newline at end of file
+};
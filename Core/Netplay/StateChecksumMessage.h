@@ -0,0 +1,37 @@
+#pragma once
+#include "pch.h"
+#include "Netplay/NetMessage.h"
+
+//Sent by the server every few seconds, used by clients to detect desyncs
+class StateChecksumMessage : public NetMessage
+{
+private:
+	uint32_t _frameCount = 0;
+	uint32_t _checksum = 0;
+
+protected:
+	void Serialize(Serializer &s) override
+	{
+		SV(_frameCount);
+		SV(_checksum);
+	}
+
+public:
+	StateChecksumMessage(void* buffer, uint32_t length) : NetMessage(buffer, length) { }
+
+	StateChecksumMessage(uint32_t frameCount, uint32_t checksum) : NetMessage(MessageType::StateChecksum)
+	{
+		_frameCount = frameCount;
+		_checksum = checksum;
+	}
+
+	uint32_t GetFrameCount()
+	{
+		return _frameCount;
+	}
+
+	uint32_t GetChecksum()
+	{
+		return _checksum;
+	}
+};
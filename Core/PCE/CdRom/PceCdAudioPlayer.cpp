@@ -6,6 +6,10 @@
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/CdReader.h"
+#include "Shared/Audio/SoundMixer.h"
+#include "Shared/Audio/AudioStream.h"
+#include "Shared/Audio/AudioStreamService.h"
+#include "Shared/Audio/CdAudioStreamDecoder.h"
 #include "Utilities/Serializer.h"
 
 PceCdAudioPlayer::PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& disc)
@@ -14,6 +18,10 @@ PceCdAudioPlayer::PceCdAudioPlayer(Emulator* emu, PceCdRom* cdrom, DiscInfo& dis
 	_cdrom = cdrom;
 	_disc = &disc;
 	_state.Status = CdAudioStatus::Inactive;
+
+	if(CdAudioStreamDecoder::CanStream(disc)) {
+		_stream = _emu->GetSoundMixer()->GetAudioStreamService()->Open(std::make_unique<CdAudioStreamDecoder>(disc), 0, false);
+	}
 }
 
 void PceCdAudioPlayer::Play(uint32_t startSector, bool pause)
@@ -33,6 +41,11 @@ void PceCdAudioPlayer::Play(uint32_t startSector, bool pause)
 		_state.CurrentSector = startSector;
 
 		_clockCounter = 0;
+
+		if(_stream) {
+			//Start reading the track while the seek delay elapses
+			_stream->Seek(startSector * 588);
+		}
 	}
 }
 
@@ -47,11 +60,58 @@ void PceCdAudioPlayer::SetEndPosition(uint32_t endSector, CdPlayEndBehavior endB
 	_state.Status = CdAudioStatus::Playing;
 }
 
+void PceCdAudioPlayer::LoadSector(uint32_t sector)
+{
+	for(CdAudioSector& cached : _sectorCache) {
+		if(cached.Sector == sector) {
+			_currentSector = &cached;
+			return;
+		}
+	}
+
+	_currentSector = &_sectorCache[_sectorCacheIndex];
+	_sectorCacheIndex = (_sectorCacheIndex + 1) % 8;
+
+	uint32_t framesRead = 0;
+	if(_stream) {
+		uint32_t start = sector * 588;
+		uint32_t position = _stream->GetPosition();
+		if(position > start || start - position > 588 * 8) {
+			//Only seek (which discards the data that was read ahead) when playback jumped to another position
+			_stream->Seek(start);
+		} else {
+			//After a partial read, the stream is behind by the frames that were read directly from the disc, skip them
+			while(position < start) {
+				uint32_t skipped = _stream->Read(_currentSector->Samples, std::min<uint32_t>(start - position, 588));
+				if(skipped == 0) {
+					break;
+				}
+				position += skipped;
+			}
+		}
+
+		if(_stream->GetPosition() == start) {
+			framesRead = _stream->Read(_currentSector->Samples, 588);
+		}
+	}
+
+	//Samples that haven't been read ahead yet (or when streaming isn't available) are read directly from the disc
+	for(uint32_t i = framesRead; i < 588; i++) {
+		_currentSector->Samples[i * 2] = _disc->ReadLeftSample(sector, i);
+		_currentSector->Samples[i * 2 + 1] = _disc->ReadRightSample(sector, i);
+	}
+
+	_currentSector->Sector = sector;
+}
+
 void PceCdAudioPlayer::PlaySample()
 {
 	if(_state.Status == CdAudioStatus::Playing) {
-		_state.LeftSample = _disc->ReadLeftSample(_state.CurrentSector, _state.CurrentSample);
-		_state.RightSample = _disc->ReadRightSample(_state.CurrentSector, _state.CurrentSample);
+		if(!_currentSector || _currentSector->Sector != _state.CurrentSector) {
+			LoadSector(_state.CurrentSector);
+		}
+		_state.LeftSample = _currentSector->Samples[_state.CurrentSample * 2];
+		_state.RightSample = _currentSector->Samples[_state.CurrentSample * 2 + 1];
 		_samplesToPlay.push_back(_state.LeftSample);
 		_samplesToPlay.push_back(_state.RightSample);
 		_state.CurrentSample++;
@@ -7,8 +7,15 @@
 
 class Emulator;
 class PceCdRom;
+class AudioStream;
 struct DiscInfo;
 
+struct CdAudioSector
+{
+	int64_t Sector = -1;
+	int16_t Samples[588 * 2] = {};
+};
+
 class PceCdAudioPlayer final : public IAudioProvider, public ISerializable
 {
 	Emulator* _emu = nullptr;
@@ -22,7 +29,15 @@ class PceCdAudioPlayer final : public IAudioProvider, public ISerializable
 	uint32_t _seekDelay = 0;
 	
 	HermiteResampler _resampler;
+
+	//Samples are read ahead by the audio stream service - the last few sectors are cached
+	//so that the small rewinds done by run-ahead/rewind don't force the stream to seek
+	shared_ptr<AudioStream> _stream;
+	CdAudioSector _sectorCache[8] = {};
+	uint32_t _sectorCacheIndex = 0;
+	CdAudioSector* _currentSector = nullptr;
 	
+	void LoadSector(uint32_t sector);
 	void PlaySample();
 	void ProcessAudioPlaybackStart();
 
@@ -460,6 +460,7 @@ void PceVdc::LoadBackgroundTilesWidth4(uint16_t end, uint16_t scrollOffset, uint
 				//Load CG0 or CG1 based on CG mode flag
 				_tiles[_tileCount].TileData[0] = ReadVram(_tiles[_tileCount].TileAddr + (row & 0x07) + (_state.HvLatch.CgMode ? 8 : 0));
 				_tiles[_tileCount].TileData[1] = 0;
+				_tiles[_tileCount].UpdatePixels();
 				_tileCount++;
 				break;
 		}
@@ -478,12 +479,14 @@ void PceVdc::LoadBatEntry(uint16_t scrollOffset, uint16_t columnMask, uint16_t r
 void PceVdc::LoadTileDataCg0(uint16_t row)
 {
 	_tiles[_tileCount].TileData[0] = ReadVram(_tiles[_tileCount].TileAddr + (row & 0x07));
+	_tiles[_tileCount].UpdatePixels();
 	_allowVramAccess = false;
 }
 
 void PceVdc::LoadTileDataCg1(uint16_t row)
 {
 	_tiles[_tileCount].TileData[1] = ReadVram(_tiles[_tileCount].TileAddr + (row & 0x07) + 8);
+	_tiles[_tileCount].UpdatePixels();
 	_allowVramAccess = false;
 	_tileCount++;
 }
@@ -786,12 +789,6 @@ void PceVdc::ProcessEndOfVisibleFrame()
 	_needVertBlankIrq = false;
 }
 
-uint8_t PceVdc::GetTilePixelColor(const uint16_t chr0, const uint16_t chr1, const uint8_t shift)
-{
-	uint16_t color = ((chr0 >> shift) & 0x101) | (((chr1 >> shift) & 0x101) << 2);
-	return (uint8_t)(color | ((color & 0x500) >> 7));
-}
-
 uint8_t PceVdc::GetSpritePixelColor(const uint16_t chrData[4], const uint8_t shift)
 {
 	return (
@@ -859,7 +856,7 @@ void PceVdc::InternalDrawScanline()
 				if(bgEnabled) {
 					uint16_t screenX = (_state.HvLatch.BgScrollX & 0x07) + _screenOffsetX;
 					uint16_t column = screenX >> 3;
-					bgColor = GetTilePixelColor(_tiles[column].TileData[0], _tiles[column].TileData[1], 7 - (screenX & 0x07));
+					bgColor = PlanarTileDecoder::GetPixel(_tiles[column].Pixels, screenX & 0x07);
 					if(bgColor != 0) {
 						outColor = _vce->GetPalette(_tiles[column].Palette * 16 + bgColor);
 					}
@@ -1459,6 +1456,9 @@ void PceVdc::Serialize(Serializer& s)
 			SVI(_tiles[i].TileData[1]);
 			SVI(_tiles[i].Palette);
 			SVI(_tiles[i].TileAddr);
+			if(!s.IsSaving()) {
+				_tiles[i].UpdatePixels();
+			}
 		}
 	}
 }
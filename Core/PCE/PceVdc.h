@@ -2,6 +2,7 @@
 #include "pch.h"
 #include "Shared/Emulator.h"
 #include "Shared/MemoryType.h"
+#include "Shared/PlanarTileDecoder.h"
 #include "PCE/PceTypes.h"
 #include "PCE/PceConstants.h"
 #include "Utilities/ISerializable.h"
@@ -40,6 +41,14 @@ struct PceTileInfo
 	uint16_t TileData[2];
 	uint16_t TileAddr;
 	uint8_t Palette;
+
+	//TileData converted to 1 byte per pixel (see PlanarTileDecoder)
+	uint64_t Pixels;
+
+	void UpdatePixels()
+	{
+		Pixels = PlanarTileDecoder::Decode4bpp((uint8_t)TileData[0], (uint8_t)(TileData[0] >> 8), (uint8_t)TileData[1], (uint8_t)(TileData[1] >> 8));
+	}
 };
 
 struct PceSpriteInfo
@@ -165,7 +174,6 @@ private:
 	__noinline void ProcessHorizontalSyncStart();
 	__noinline void ProcessVerticalSyncStart();
 
-	__forceinline uint8_t GetTilePixelColor(const uint16_t chr0, const uint16_t chr1, const uint8_t shift);
 	__forceinline uint8_t GetSpritePixelColor(const uint16_t chrData[4], const uint8_t shift);
 
 	__forceinline void ProcessSpriteEvaluation();
@@ -204,63 +204,77 @@ void PceVpc::ProcessScanline()
 
 	uint16_t wnd1 = std::max(0, (int16_t)_state.Window1 - 16);
 	uint16_t wnd2 = std::max(0, (int16_t)_state.Window2 - 16);
-	for(uint32_t i = _xStart; i < xMax; i++) {
-		PceVpcPixelWindow wndType = (PceVpcPixelWindow)((i < wnd1) | ((i < wnd2) << 1));
-		PceVpcPriorityConfig& cfg = _state.WindowCfg[(int)wndType];
-		uint8_t enabledLayers = (uint8_t)cfg.Vdc1Enabled | ((uint8_t)cfg.Vdc2Enabled << 1);
-		uint16_t color;
-		switch(enabledLayers) {
-			default:
-			case 0: color = _vce->GetPalette(0); break;
-			case 1: color = rowBuffer[i]; break;
-			case 2: color = rowBufferVdc2[i]; break;
-
-			case 3:
-			{
-				bool isSpriteVdc1 = (rowBuffer[i] & PceVpc::SpritePixelFlag) != 0;
-				bool isSpriteVdc2 = (rowBufferVdc2[i] & PceVpc::SpritePixelFlag) != 0;
-				bool isTransparentVdc1 = (rowBuffer[i] & PceVpc::TransparentPixelFlag) != 0;
-
-				switch(cfg.PriorityMode) {
-					default:
-					case PceVpcPriorityMode::Default:
-						color = isTransparentVdc1 ? rowBufferVdc2[i] : rowBuffer[i];
-						break;
-
-					case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg:
-						//VDC2 sprites are shown above VDC1 background, but below VDC1 sprites
-						if(isTransparentVdc1 || (isSpriteVdc2 && !isSpriteVdc1)) {
-							//VDC1 transparent, show VDC2, or
-							//VDC2 is a sprite and VDC1 is not a sprite, show VDC2
-							color = rowBufferVdc2[i];
-						} else {
-							color = rowBuffer[i];
-						}
-						break;
-
-					case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg: {
-						//VDC1 sprites are shown behind VDC2 background, but above VDC2 sprites(?)
-						bool isTransparentVdc2 = (rowBufferVdc2[i] & PceVpc::TransparentPixelFlag) != 0;
-						if(isTransparentVdc1 || (isSpriteVdc1 && !isSpriteVdc2 && !isTransparentVdc2)) {
-							//VDC1 transparent, show VDC2, or
-							//VDC1 is a sprite, show VDC2 (unless VDC2 is a transparent color or the background layer)
-							color = rowBufferVdc2[i];
-						} else {
-							color = rowBuffer[i];
-						}
-						break;
-					}
-				}
-				break;
-			}
+
+	//The window/priority config only changes at the window boundaries, merge each span with the same config at once
+	uint32_t i = _xStart;
+	while(i < xMax) {
+		uint32_t spanEnd = xMax;
+		if(i < wnd1) {
+			spanEnd = std::min<uint32_t>(spanEnd, wnd1);
+		}
+		if(i < wnd2) {
+			spanEnd = std::min<uint32_t>(spanEnd, wnd2);
 		}
 
-		_currentOutBuffer[offset + i] = color;
+		PceVpcPixelWindow wndType = (PceVpcPixelWindow)((i < wnd1) | ((i < wnd2) << 1));
+		MergeSpan(_state.WindowCfg[(int)wndType], rowBuffer + i, rowBufferVdc2 + i, _currentOutBuffer + offset + i, spanEnd - i);
+		i = spanEnd;
 	}
 
 	_xStart = xMax;
 }
 
+void PceVpc::MergeSpan(PceVpcPriorityConfig& cfg, uint16_t* vdc1, uint16_t* vdc2, uint16_t* out, uint32_t length)
+{
+	//Each loop only selects between the 2 inputs without branching, which allows the compiler to vectorize them
+	uint8_t enabledLayers = (uint8_t)cfg.Vdc1Enabled | ((uint8_t)cfg.Vdc2Enabled << 1);
+	switch(enabledLayers) {
+		default:
+		case 0: std::fill(out, out + length, _vce->GetPalette(0)); break;
+		case 1: memcpy(out, vdc1, length * sizeof(uint16_t)); break;
+		case 2: memcpy(out, vdc2, length * sizeof(uint16_t)); break;
+
+		case 3:
+			switch(cfg.PriorityMode) {
+				default:
+				case PceVpcPriorityMode::Default:
+					for(uint32_t i = 0; i < length; i++) {
+						bool isTransparentVdc1 = (vdc1[i] & PceVpc::TransparentPixelFlag) != 0;
+						out[i] = isTransparentVdc1 ? vdc2[i] : vdc1[i];
+					}
+					break;
+
+				case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg:
+					//VDC2 sprites are shown above VDC1 background, but below VDC1 sprites
+					for(uint32_t i = 0; i < length; i++) {
+						bool isSpriteVdc1 = (vdc1[i] & PceVpc::SpritePixelFlag) != 0;
+						bool isSpriteVdc2 = (vdc2[i] & PceVpc::SpritePixelFlag) != 0;
+						bool isTransparentVdc1 = (vdc1[i] & PceVpc::TransparentPixelFlag) != 0;
+
+						//Show VDC2 if VDC1 is transparent, or if VDC2 is a sprite and VDC1 is not a sprite
+						bool showVdc2 = isTransparentVdc1 | (isSpriteVdc2 & !isSpriteVdc1);
+						out[i] = showVdc2 ? vdc2[i] : vdc1[i];
+					}
+					break;
+
+				case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg:
+					//VDC1 sprites are shown behind VDC2 background, but above VDC2 sprites(?)
+					for(uint32_t i = 0; i < length; i++) {
+						bool isSpriteVdc1 = (vdc1[i] & PceVpc::SpritePixelFlag) != 0;
+						bool isSpriteVdc2 = (vdc2[i] & PceVpc::SpritePixelFlag) != 0;
+						bool isTransparentVdc1 = (vdc1[i] & PceVpc::TransparentPixelFlag) != 0;
+						bool isTransparentVdc2 = (vdc2[i] & PceVpc::TransparentPixelFlag) != 0;
+
+						//Show VDC2 if VDC1 is transparent, or if VDC1 is a sprite (unless VDC2 is a transparent color or the background layer)
+						bool showVdc2 = isTransparentVdc1 | (isSpriteVdc1 & !isSpriteVdc2 & !isTransparentVdc2);
+						out[i] = showVdc2 ? vdc2[i] : vdc1[i];
+					}
+					break;
+			}
+			break;
+	}
+}
+
 void PceVpc::ProcessScanlineEnd(PceVdc* vdc, uint16_t scanline, uint16_t* rowBuffer)
 {
 	if(vdc == _vdc2 || _skipRender) {
@@ -33,6 +33,7 @@ private:
 
 	void SetPriorityConfig(PceVpcPixelWindow wnd, uint8_t value);
 	void UpdateIrqState();
+	void MergeSpan(PceVpcPriorityConfig& cfg, uint16_t* vdc1, uint16_t* vdc2, uint16_t* out, uint32_t length);
 
 public:
 	PceVpc(Emulator* emu, PceConsole* console, PceVce* vce);
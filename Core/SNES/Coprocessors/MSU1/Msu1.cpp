@@ -19,7 +19,7 @@ Msu1* Msu1::Init(Emulator* emu, VirtualFile& romFile, Spc* spc)
 	}
 }
 
-Msu1::Msu1(Emulator* emu, VirtualFile& romFile, Spc* spc)
+Msu1::Msu1(Emulator* emu, VirtualFile& romFile, Spc* spc) : _pcmReader(emu->GetSoundMixer()->GetAudioStreamService())
 {
 	_emu = emu;
 	_spc = spc;
@@ -2,6 +2,23 @@
 #include "pch.h"
 #include "SNES/DSP/Dsp.h"
 
+//Gaussian filter coefficients regrouped by offset, so the 4 taps used for a sample are contiguous
+struct DspGaussTable
+{
+	int16_t Taps[256][4] = {};
+
+	constexpr DspGaussTable(const int16_t (&gauss)[512])
+	{
+		for(int offset = 0; offset < 256; offset++) {
+			Taps[offset][0] = gauss[255 - offset];
+			Taps[offset][1] = gauss[511 - offset];
+			Taps[offset][2] = gauss[256 + offset];
+			Taps[offset][3] = gauss[offset];
+		}
+	}
+};
+
+//Sample buffers passed to these functions must contain 12 samples + a copy of the first 3 samples (see DspVoice::DecodeBrrSample)
 class DspInterpolation
 {
 private:
@@ -40,30 +57,32 @@ private:
 		1299,1300,1300,1301,1302,1302,1303,1303,1303,1304,1304,1304,1304,1304,1305,1305,
 	};
 
+	static constexpr DspGaussTable gaussTable = DspGaussTable(gauss);
+
 public:
 	static int16_t Gauss(int32_t interpolationPos, int16_t* samples, uint8_t bufferPos)
 	{
-		uint8_t pos = (interpolationPos >> 12) + bufferPos;
-		uint8_t offset = (interpolationPos >> 4) & 0xFF;
+		int16_t* in = samples + ((interpolationPos >> 12) + bufferPos) % 12;
+		const int16_t* taps = gaussTable.Taps[(interpolationPos >> 4) & 0xFF];
 		
 		//"The above 3 wrap at 15 bits signed. The last is added to that, and is clamped rather than wrapped.
 		int32_t out = (int16_t)(
-			((gauss[255 - offset] * (int32_t)samples[pos % 12]) >> 11) +
-			((gauss[511 - offset] * (int32_t)samples[(pos + 1) % 12]) >> 11) +
-			((gauss[256 + offset] * (int32_t)samples[(pos + 2) % 12]) >> 11)
-		) + ((gauss[offset] * (int32_t)samples[(pos + 3) % 12]) >> 11);
+			((taps[0] * (int32_t)in[0]) >> 11) +
+			((taps[1] * (int32_t)in[1]) >> 11) +
+			((taps[2] * (int32_t)in[2]) >> 11)
+		) + ((taps[3] * (int32_t)in[3]) >> 11);
 
 		return Dsp::Clamp16(out) & ~0x01;
 	}
 
 	static int16_t Cubic(int32_t interpolationPos, int16_t* samples, uint8_t bufferPos)
 	{
-		uint8_t pos = (interpolationPos >> 12) + bufferPos;
+		int16_t* in = samples + ((interpolationPos >> 12) + bufferPos) % 12;
 
-		float v0 = samples[pos % 12] / 32768.0f;
-		float v1 = samples[(pos + 1) % 12] / 32768.0f;
-		float v2 = samples[(pos + 2) % 12] / 32768.0f;
-		float v3 = samples[(pos + 3) % 12] / 32768.0f;
+		float v0 = in[0] / 32768.0f;
+		float v1 = in[1] / 32768.0f;
+		float v2 = in[2] / 32768.0f;
+		float v3 = in[3] / 32768.0f;
 
 		float a = (v3 - v2) - (v0 - v1);
 		float b = (v0 - v1) - a;
@@ -65,6 +65,10 @@ void DspVoice::DecodeBrrSample()
 		prev1 = _sampleBuffer[_bufferPos + i] >> 1;
 	}
 
+	if(_bufferPos == 0) {
+		UpdateSampleBufferMirror();
+	}
+
 	if(_bufferPos <= 4) {
 		_bufferPos += 4;
 	} else {
@@ -72,6 +76,13 @@ void DspVoice::DecodeBrrSample()
 	}
 }
 
+void DspVoice::UpdateSampleBufferMirror()
+{
+	_sampleBuffer[12] = _sampleBuffer[0];
+	_sampleBuffer[13] = _sampleBuffer[1];
+	_sampleBuffer[14] = _sampleBuffer[2];
+}
+
 void DspVoice::ProcessEnvelope()
 {
 	int32_t env = _envVolume;
@@ -178,7 +189,9 @@ void DspVoice::UpdateOutput(bool right)
 	//"Load and apply VxVOL[L/R] register."
 	int32_t voiceOut = ((int32_t)_shared->VoiceOutput * (int8_t)ReadReg((DspVoiceRegs)((int)DspVoiceRegs::VolLeft + (int)right))) >> 7;
 
-	voiceOut = voiceOut * (int32_t)_cfg->ChannelVolumes[_voiceIndex] / 100;
+	if(_cfg->ChannelVolumes[_voiceIndex] != 100) {
+		voiceOut = voiceOut * (int32_t)_cfg->ChannelVolumes[_voiceIndex] / 100;
+	}
 
 	_shared->OutSamples[(int)right] = Dsp::Clamp16(_shared->OutSamples[(int)right] + voiceOut);
 
@@ -392,4 +405,8 @@ void DspVoice::Serialize(Serializer& s)
 	SV(_bufferPos);
 
 	SVArray(_sampleBuffer, 12);
+
+	if(!s.IsSaving()) {
+		UpdateSampleBufferMirror();
+	}
 }
@@ -29,12 +29,14 @@ private:
 	uint8_t _envOut = 0;
 	uint8_t _bufferPos = 0;
 
-	int16_t _sampleBuffer[12] = {};
+	//12 samples, followed by a copy of the first 3 samples so interpolation can read 4 consecutive samples without wrapping
+	int16_t _sampleBuffer[12 + 3] = {};
 
 	uint8_t ReadReg(DspVoiceRegs reg) { return _regs[(int)reg]; }
 	void WriteReg(DspVoiceRegs reg, uint8_t value) { _regs[(int)reg] = value; }
 
 	void DecodeBrrSample();
+	void UpdateSampleBufferMirror();
 	void ProcessEnvelope();
 	void UpdateOutput(bool right);
 
@@ -8,6 +8,7 @@
 #include "SNES/SnesControlManager.h"
 #include "SNES/InternalRegisters.h"
 #include "SNES/SnesDmaController.h"
+#include "SNES/SnesPpuRenderThread.h"
 #include "SNES/Debugger/SnesPpuTools.h"
 #include "Debugger/Debugger.h"
 #include "Shared/Emulator.h"
@@ -39,8 +40,26 @@ SnesPpu::SnesPpu(Emulator* emu, SnesConsole* console)
 	memset(_outputBuffers[1], 0, 512 * 478 * sizeof(uint16_t));
 }
 
+SnesPpu::SnesPpu(SnesPpu* ppu)
+{
+	//Copy of the PPU used by SnesPpuRenderThread, only its rendering functions are used
+	_emu = ppu->_emu;
+	_console = ppu->_console;
+	_regs = ppu->_regs;
+	_memoryManager = ppu->_memoryManager;
+	_spc = ppu->_spc;
+	_settings = ppu->_settings;
+	_isRenderThreadPpu = true;
+
+	_vram = new uint16_t[SnesPpu::VideoRamSize >> 1];
+	memset(_vram, 0, SnesPpu::VideoRamSize);
+}
+
 SnesPpu::~SnesPpu()
 {
+	//Stop the render thread before the buffers it uses are deleted
+	_renderThread.reset();
+
 	delete[] _vram;
 	delete[] _outputBuffers[0];
 	delete[] _outputBuffers[1];
@@ -48,6 +67,13 @@ SnesPpu::~SnesPpu()
 
 void SnesPpu::PowerOn()
 {
+	if(_renderThread) {
+		//The render thread's copy of VRAM/CGRAM is synced again at the start of the next frame
+		_renderThread->WaitForIdle();
+	}
+	_threadedRender = false;
+	_verifyFrame = false;
+
 	_skipRender = false;
 	_regs = _console->GetInternalRegisters();
 	_settings = _emu->GetSettings();
@@ -81,6 +107,7 @@ void SnesPpu::Reset()
 	_scanline = 0;
 	_state.ForcedBlank = true;
 	_oddFrame = 0;
+	_renderStateDirty = true;
 }
 
 uint32_t SnesPpu::GetFrameCount()
@@ -412,6 +439,11 @@ bool SnesPpu::ProcessEndOfScanline(uint16_t& hClock)
 					if(_interlacedFrame) {
 						memcpy(_currentBuffer, GetPreviousScreenBuffer(), 512 * 478 * sizeof(uint16_t));
 					}
+
+					if(_verifyFrame) {
+						//The render thread draws this frame in a separate buffer, which is compared with the main buffer in SendFrame
+						memcpy(_renderThread->GetVerifyBuffer(), _currentBuffer, 512 * 478 * sizeof(uint16_t));
+					}
 					
 					//If we're not skipping this frame, reset the high resolution/interlace flags
 					_useHighResOutput = IsDoubleWidth() || _state.ScreenInterlace;
@@ -457,6 +489,11 @@ bool SnesPpu::ProcessEndOfScanline(uint16_t& hClock)
 			}
 		}
 
+		if(_threadedRender) {
+			//Send this scanline's commands to the render thread
+			_renderThread->Flush();
+		}
+
 		_scanline++;
 		hClock = 0;
 
@@ -504,6 +541,8 @@ bool SnesPpu::ProcessEndOfScanline(uint16_t& hClock)
 				_skipRender = true;
 			}
 
+			UpdateThreadedRenderState();
+
 			//Ensure the SPC is re-enabled for the next frame
 			_spc->SetSpcState(true);
 		}
@@ -865,7 +904,32 @@ void SnesPpu::RenderScanline()
 		_spriteEvalStart = _spriteEvalEnd + 1;
 	}
 
-	if(!_skipRender && (hPos <= 263 || _fetchBgEnd < 263)) {
+	if(!_skipRender) {
+		if(_threadedRender) {
+			_renderThread->AddRender(hPos);
+		}
+
+		if(!_threadedRender || _verifyFrame) {
+			RenderBackground(hPos);
+		} else {
+			SkipBackground(hPos);
+		}
+	}
+	
+	if(hPos >= 270 && !_spriteFetchingDone) {
+		//Fetch sprite data from OAM and calculated which CHR data needs to be loaded (between H=270 and H=337)
+		//Fetch sprite CHR data, as needed, between H=272 and H=339
+		_fetchSpriteEnd = std::min(hPos - 270, 69);
+		if(_fetchSpriteStart <= _fetchSpriteEnd) {
+			FetchSpriteData();
+		}
+		_fetchSpriteStart = _fetchSpriteEnd + 1;
+	}
+}
+
+void SnesPpu::RenderBackground(int32_t hPos)
+{
+	if(hPos <= 263 || _fetchBgEnd < 263) {
 		//Fetch tilemap and tile CHR data, as needed, between H=0 and H=263
 		_fetchBgEnd = std::min(hPos, 263);
 		if(_fetchBgStart <= _fetchBgEnd) {
@@ -875,7 +939,7 @@ void SnesPpu::RenderScanline()
 	} 
 
 	//Render the scanline
-	if(!_skipRender && _drawStartX <= 255 && hPos > 22 && _scanline > 0) {
+	if(_drawStartX <= 255 && hPos > 22 && _scanline > 0) {
 		_drawEndX = std::min(hPos - 22, 255);
 
 		if(_state.ForcedBlank) {
@@ -902,15 +966,22 @@ void SnesPpu::RenderScanline()
 
 		_drawStartX = _drawEndX + 1;
 	}
-	
-	if(hPos >= 270 && !_spriteFetchingDone) {
-		//Fetch sprite data from OAM and calculated which CHR data needs to be loaded (between H=270 and H=337)
-		//Fetch sprite CHR data, as needed, between H=272 and H=339
-		_fetchSpriteEnd = std::min(hPos - 270, 69);
-		if(_fetchSpriteStart <= _fetchSpriteEnd) {
-			FetchSpriteData();
+}
+
+void SnesPpu::SkipBackground(int32_t hPos)
+{
+	//Same as RenderBackground, but only updates the fetch/draw positions (used when the render thread draws the picture)
+	if(hPos <= 263 || _fetchBgEnd < 263) {
+		_fetchBgEnd = std::min(hPos, 263);
+		_fetchBgStart = _fetchBgEnd + 1;
+	}
+
+	if(_drawStartX <= 255 && hPos > 22 && _scanline > 0) {
+		_drawEndX = std::min(hPos - 22, 255);
+		if(_useHighResOutput) {
+			_interlacedFrame |= _state.ScreenInterlace;
 		}
-		_fetchSpriteStart = _fetchSpriteEnd + 1;
+		_drawStartX = _drawEndX + 1;
 	}
 }
 
@@ -1180,39 +1251,47 @@ void SnesPpu::RenderTilemapMode7()
 	
 	uint8_t pixelFlags = ((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0;
 
-	for(int x = _drawStartX; x <= _drawEndX; x++) {
-		int32_t xOffset = xValue >> 8;
-		int32_t yOffset = yValue >> 8;
-		xValue += xStep;
-		yValue += yStep;
+	//Calculate the tilemap address & pixel offset for every pixel first - this loop has no branches or
+	//memory lookups, which allows the compiler to vectorize it.
+	int pixelCount = _drawEndX - _drawStartX + 1;
+	bool largeMap = _state.Mode7.LargeMap;
+	uint16_t tilemapAddr[256];
+	uint8_t pixelOffset[256];
+	bool outsideMap[256];
+	for(int i = 0; i < pixelCount; i++) {
+		int32_t xOffset = (xValue + xStep * i) >> 8;
+		int32_t yOffset = (yValue + yStep * i) >> 8;
+		outsideMap[i] = largeMap && (((xOffset | yOffset) & ~0x3FF) != 0);
+		xOffset &= 0x3FF;
+		yOffset &= 0x3FF;
+		tilemapAddr[i] = ((yOffset & ~0x07) << 4) | (xOffset >> 3);
+		pixelOffset[i] = ((yOffset & 0x07) << 3) | (xOffset & 0x07);
+	}
+
+	for(int i = 0; i < pixelCount; i++) {
+		int x = _drawStartX + i;
 
 		uint8_t tileIndex;
-		if(!_state.Mode7.LargeMap) {
-			yOffset &= 0x3FF;
-			xOffset &= 0x3FF;
-			tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
-		} else {
-			if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
-				if(_state.Mode7.FillWithTile0) {
-					tileIndex = 0;
-				} else {
-					//Draw nothing for this pixel, we're outside the map
-					continue;
-				}
+		if(outsideMap[i]) {
+			if(_state.Mode7.FillWithTile0) {
+				tileIndex = 0;
 			} else {
-				tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+				//Draw nothing for this pixel, we're outside the map
+				continue;
 			}
+		} else {
+			tileIndex = (uint8_t)_vram[tilemapAddr[i]];
 		}
 
 		uint16_t colorIndex;
 		uint8_t priority;
 		if constexpr(layerIndex == 1) {
-			uint8_t color = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			uint8_t color = _vram[(tileIndex << 6) + pixelOffset[i]] >> 8;
 			priority = (color & 0x80) ? highPriority : normalPriority;
 			colorIndex = (color & 0x7F);
 		} else {
 			priority = normalPriority;
-			colorIndex = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			colorIndex = _vram[(tileIndex << 6) + pixelOffset[i]] >> 8;
 		}
 
 		if(applyMosaic) {
@@ -1262,7 +1341,7 @@ void SnesPpu::DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority)
 
 void SnesPpu::ApplyColorMath()
 {
-	if(!_skipRender && _emu->IsDebugging()) {
+	if(!_skipRender && !_isRenderThreadPpu && _emu->IsDebugging()) {
 		DebugProcessMainSubScreenViews();
 	}
 
@@ -1398,6 +1477,17 @@ void SnesPpu::ConvertToHiRes()
 	//Convert standard res picture to high resolution when the PPU starts drawing in high res mid frame
 	_useHighResOutput = useHighResOutput;
 
+	if(_threadedRender) {
+		_renderThread->AddConvertToHiRes();
+	}
+
+	if(!_threadedRender || _verifyFrame) {
+		ConvertBufferToHiRes();
+	}
+}
+
+void SnesPpu::ConvertBufferToHiRes()
+{
 	uint16_t scanline = _overscanFrame ? (_scanline - 1) : (_scanline + 6);
 
 	if(_drawStartX > 0) {
@@ -1488,8 +1578,52 @@ void SnesPpu::ProcessWindowMaskSettings(uint8_t value, uint8_t offset)
 	_state.Window[1].InvertedLayers[1 + offset] = (value & 0x40) != 0;
 }
 
+void SnesPpu::UpdateThreadedRenderState()
+{
+	//Threaded rendering is disabled while debugging, the debugger tools need the renderer's internal state
+	bool threadedRender = !_threadedRenderFailed && _settings->GetSnesConfig().EnableThreadedRendering && !_emu->IsDebugging();
+	if(threadedRender != _threadedRender) {
+		if(threadedRender) {
+			if(!_renderThread) {
+				_renderThread.reset(new SnesPpuRenderThread(this));
+			}
+			_renderThread->CopyStateToRenderer();
+		} else {
+			_renderThread->CopyStateFromRenderer();
+		}
+		_threadedRender = threadedRender;
+	}
+
+	_verifyFrame = false;
+	if(_threadedRender && !_skipRender && (_frameCount % SnesPpu::ThreadedRenderVerifyInterval) == 0) {
+		//Render this frame on both threads - the emulation thread's renderer starts from the render thread's current state
+		_renderThread->CopyStateFromRenderer();
+		_verifyFrame = true;
+	}
+}
+
+void SnesPpu::VerifyThreadedRenderOutput()
+{
+	_verifyFrame = false;
+	if(memcmp(_currentBuffer, _renderThread->GetVerifyBuffer(), 512 * 478 * sizeof(uint16_t)) != 0) {
+		//The output from the emulation thread's renderer is already in the main buffer, keep using it from now on
+		MessageManager::Log("[SNES] Threaded rendering output does not match the synchronous renderer (frame " + std::to_string(_frameCount) + "), threaded rendering disabled.");
+		_threadedRenderFailed = true;
+	}
+}
+
 void SnesPpu::SendFrame()
 {
+	if(_threadedRender) {
+		if(_verifyFrame) {
+			_renderThread->WaitForIdle();
+			VerifyThreadedRenderOutput();
+		} else {
+			//The renderer is idle until the next frame starts, get its state back now so save states don't need to wait for it
+			_renderThread->CopyStateFromRenderer();
+		}
+	}
+
 	uint16_t width = _useHighResOutput ? 512 : 256;
 	uint16_t height = _useHighResOutput ? 478 : 239;
 
@@ -1523,6 +1657,10 @@ void SnesPpu::DebugSendFrame()
 		RenderScanline();
 	}
 
+	if(_threadedRender) {
+		_renderThread->WaitForIdle();
+	}
+
 	uint16_t width = _useHighResOutput ? 512 : 256;
 	uint16_t height = _useHighResOutput ? 478 : 239;
 
@@ -1853,6 +1991,9 @@ void SnesPpu::Write(uint32_t addr, uint8_t value)
 		RenderScanline();
 	}
 
+	//The register state is sent to the render thread the next time it needs to draw
+	_renderStateDirty = true;
+
 	switch(addr) {
 		case 0x2100:
 			if(_state.ForcedBlank && _scanline == _nmiScanline) {
@@ -2020,6 +2161,9 @@ void SnesPpu::Write(uint32_t addr, uint8_t value)
 				//Only write the value if in vblank or forced blank (writes to VRAM outside vblank/forced blank are not allowed)
 				_emu->ProcessPpuWrite<CpuType::Snes>(GetVramAddress() << 1, value, MemoryType::SnesVideoRam);
 				_vram[GetVramAddress()] = value | (_vram[GetVramAddress()] & 0xFF00);
+				if(_threadedRender) {
+					_renderThread->AddVramWrite(GetVramAddress(), _vram[GetVramAddress()]);
+				}
 			}
 
 			//The VRAM address is incremented even outside of vblank/forced blank
@@ -2034,6 +2178,9 @@ void SnesPpu::Write(uint32_t addr, uint8_t value)
 				//Only write the value if in vblank or forced blank (writes to VRAM outside vblank/forced blank are not allowed)
 				_emu->ProcessPpuWrite<CpuType::Snes>((GetVramAddress() << 1) + 1, value, MemoryType::SnesVideoRam);
 				_vram[GetVramAddress()] = (value << 8) | (_vram[GetVramAddress()] & 0xFF); 
+				if(_threadedRender) {
+					_renderThread->AddVramWrite(GetVramAddress(), _vram[GetVramAddress()]);
+				}
 			}
 			
 			//The VRAM address is incremented even outside of vblank/forced blank
@@ -2083,6 +2230,9 @@ void SnesPpu::Write(uint32_t addr, uint8_t value)
 				_emu->ProcessPpuWrite<CpuType::Snes>((_state.CgramAddress << 1) + 1, value, MemoryType::SnesCgRam);
 
 				_cgram[_state.CgramAddress] = _state.CgramWriteBuffer | (value << 8);
+				if(_threadedRender) {
+					_renderThread->AddCgramWrite(_state.CgramAddress, _cgram[_state.CgramAddress]);
+				}
 				_state.CgramAddress++;
 			} else {
 				_state.CgramWriteBuffer = value;
@@ -2219,6 +2369,11 @@ void SnesPpu::Write(uint32_t addr, uint8_t value)
 
 void SnesPpu::Serialize(Serializer &s)
 {
+	if(_threadedRender && s.IsSaving() && !_renderThread->IsStateSynced()) {
+		//Saving in the middle of a frame, get the fetched tile data, etc. back from the render thread
+		_renderThread->CopyStateFromRenderer();
+	}
+
 	SV(_state.ForcedBlank); SV(_state.ScreenBrightness); SV(_scanline); SV(_frameCount);  SV(_state.BgMode);
 	SV(_state.Mode1Bg3Priority); SV(_state.MainScreenLayers); SV(_state.SubScreenLayers); SV(_state.VramAddress); SV(_state.VramIncrementValue); SV(_state.VramAddressRemapping);
 	SV(_state.VramAddrIncrementOnSecondReg); SV(_state.VramReadBuffer); SV(_state.Ppu1OpenBus); SV(_state.Ppu2OpenBus); SV(_state.CgramAddress); SV(_state.MosaicSize); SV(_state.MosaicEnabled);
@@ -2276,6 +2431,10 @@ void SnesPpu::Serialize(Serializer &s)
 	if(!s.IsSaving() && _interlacedFrame && _emu->GetRewindManager()->IsRewinding()) {
 		_needFullFrame = true;
 	}
+
+	if(_threadedRender && !s.IsSaving()) {
+		_renderThread->CopyStateToRenderer();
+	}
 }
 
 void SnesPpu::RandomizeState()
@@ -10,9 +10,12 @@ class InternalRegisters;
 class SnesMemoryManager;
 class Spc;
 class EmuSettings;
+class SnesPpuRenderThread;
 
 class SnesPpu : public ISerializable
 {
+	friend class SnesPpuRenderThread;
+
 public:
 	constexpr static uint32_t SpriteRamSize = 544;
 	constexpr static uint32_t CgRamSize = 512;
@@ -22,6 +25,9 @@ private:
 	constexpr static int SpriteLayerIndex = 4;
 	constexpr static int ColorWindowIndex = 5;
 
+	//When threaded rendering is enabled, every Nth frame is also rendered on the emulation thread to validate the render thread's output
+	constexpr static uint32_t ThreadedRenderVerifyInterval = 600;
+
 	Emulator* _emu;
 	SnesConsole* _console;
 	InternalRegisters* _regs;
@@ -122,6 +128,15 @@ private:
 
 	bool _needFullFrame = false;
 
+	unique_ptr<SnesPpuRenderThread> _renderThread;
+	bool _threadedRender = false;
+	bool _threadedRenderFailed = false;
+	bool _verifyFrame = false;
+	bool _renderStateDirty = false;
+	bool _isRenderThreadPpu = false;
+
+	SnesPpu(SnesPpu* ppu);
+
 	void RenderSprites(const uint8_t priorities[4]);
 
 	template<bool hiResMode>
@@ -134,6 +149,9 @@ private:
 	void GetVerticalOffsetByte(uint8_t columnIndex);
 	void FetchTileData();
 
+	void RenderBackground(int32_t hPos);
+	void SkipBackground(int32_t hPos);
+
 	void RenderMode0();
 	void RenderMode1();
 	void RenderMode2();
@@ -184,6 +202,7 @@ private:
 	void ApplyBrightness();
 
 	void ConvertToHiRes();
+	void ConvertBufferToHiRes();
 	void ApplyHiResMode();
 
 	template<uint8_t layerIndex>
@@ -196,6 +215,9 @@ private:
 
 	void SendFrame();
 
+	void UpdateThreadedRenderState();
+	void VerifyThreadedRenderOutput();
+
 	bool IsDoubleHeight();
 	bool IsDoubleWidth();
 
@@ -0,0 +1,266 @@
+#include "pch.h"
+#include "SNES/SnesPpuRenderThread.h"
+#include "SNES/SnesPpu.h"
+
+SnesPpuRenderThread::SnesPpuRenderThread(SnesPpu* ppu)
+{
+	_ppu = ppu;
+	_renderPpu.reset(new SnesPpu(ppu));
+
+	_verifyBuffer = new uint16_t[512 * 478];
+	memset(_verifyBuffer, 0, 512 * 478 * sizeof(uint16_t));
+
+	_stopFlag = false;
+	_thread.reset(new thread(&SnesPpuRenderThread::Exec, this));
+}
+
+SnesPpuRenderThread::~SnesPpuRenderThread()
+{
+	_stopFlag = true;
+	_workSignal.Signal();
+	_thread->join();
+
+	delete[] _verifyBuffer;
+}
+
+SnesPpuRenderBatch& SnesPpuRenderThread::GetBatch()
+{
+	if(!_batch) {
+		{
+			auto lock = _lock.AcquireSafe();
+			if(!_freeBatches.empty()) {
+				_batch = std::move(_freeBatches.back());
+				_freeBatches.pop_back();
+			}
+		}
+
+		if(!_batch) {
+			_batch.reset(new SnesPpuRenderBatch());
+		}
+
+		//These values only change between scanlines
+		SnesPpuRenderBatch& batch = *_batch;
+		batch.FrameCount = _ppu->_frameCount;
+		batch.Scanline = _ppu->_scanline;
+		batch.OddFrame = _ppu->_oddFrame;
+		batch.OverscanFrame = _ppu->_overscanFrame;
+		batch.ConfigVisibleLayers = _ppu->_configVisibleLayers;
+		batch.OutputBuffer = _ppu->_verifyFrame ? _verifyBuffer : _ppu->_currentBuffer;
+		memcpy(batch.SpritePriority, _ppu->_spritePriority, sizeof(batch.SpritePriority));
+		memcpy(batch.SpritePalette, _ppu->_spritePalette, sizeof(batch.SpritePalette));
+		memcpy(batch.SpriteColors, _ppu->_spriteColors, sizeof(batch.SpriteColors));
+	}
+	return *_batch;
+}
+
+void SnesPpuRenderThread::AddRender(int32_t hPos)
+{
+	SnesPpuRenderBatch& batch = GetBatch();
+	_stateSynced = false;
+
+	if(_ppu->_renderStateDirty) {
+		SnesPpuRenderCommand cmd = {};
+		cmd.Type = SnesPpuRenderCommandType::SetState;
+		cmd.Addr = (uint16_t)batch.States.size();
+		batch.Commands.push_back(cmd);
+		batch.States.push_back(_ppu->_state);
+		_ppu->_renderStateDirty = false;
+	}
+
+	SnesPpuRenderCommand cmd = {};
+	cmd.Type = SnesPpuRenderCommandType::Render;
+	cmd.HPos = (int16_t)hPos;
+	cmd.FetchBgStart = _ppu->_fetchBgStart;
+	cmd.FetchBgEnd = _ppu->_fetchBgEnd;
+	cmd.DrawStartX = _ppu->_drawStartX;
+	cmd.MosaicScanlineCounter = _ppu->_mosaicScanlineCounter;
+	cmd.UseHighResOutput = _ppu->_useHighResOutput;
+	batch.Commands.push_back(cmd);
+}
+
+void SnesPpuRenderThread::AddConvertToHiRes()
+{
+	SnesPpuRenderCommand cmd = {};
+	cmd.Type = SnesPpuRenderCommandType::ConvertToHiRes;
+	cmd.DrawStartX = _ppu->_drawStartX;
+	GetBatch().Commands.push_back(cmd);
+}
+
+void SnesPpuRenderThread::AddVramWrite(uint16_t addr, uint16_t value)
+{
+	SnesPpuRenderCommand cmd = {};
+	cmd.Type = SnesPpuRenderCommandType::VramWrite;
+	cmd.Addr = addr;
+	cmd.Value = value;
+	GetBatch().Commands.push_back(cmd);
+}
+
+void SnesPpuRenderThread::AddCgramWrite(uint8_t addr, uint16_t value)
+{
+	SnesPpuRenderCommand cmd = {};
+	cmd.Type = SnesPpuRenderCommandType::CgramWrite;
+	cmd.Addr = addr;
+	cmd.Value = value;
+	GetBatch().Commands.push_back(cmd);
+}
+
+void SnesPpuRenderThread::Flush()
+{
+	if(!_batch) {
+		return;
+	}
+
+	{
+		auto lock = _lock.AcquireSafe();
+		_pendingBatches.push_back(std::move(_batch));
+	}
+	_workSignal.Signal();
+}
+
+void SnesPpuRenderThread::WaitForIdle()
+{
+	Flush();
+
+	while(true) {
+		{
+			auto lock = _lock.AcquireSafe();
+			if(_pendingBatches.empty() && !_busy) {
+				return;
+			}
+		}
+		_idleSignal.Wait();
+	}
+}
+
+void SnesPpuRenderThread::CopyStateToRenderer()
+{
+	WaitForIdle();
+
+	SnesPpu* src = _ppu;
+	SnesPpu* dst = _renderPpu.get();
+	dst->_state = src->_state;
+	dst->_frameCount = src->_frameCount;
+	dst->_scanline = src->_scanline;
+	memcpy(dst->_vram, src->_vram, SnesPpu::VideoRamSize);
+	memcpy(dst->_cgram, src->_cgram, sizeof(dst->_cgram));
+	memcpy(dst->_layerData, src->_layerData, sizeof(dst->_layerData));
+	dst->_hOffset = src->_hOffset;
+	dst->_vOffset = src->_vOffset;
+	memcpy(dst->_mosaicColor, src->_mosaicColor, sizeof(dst->_mosaicColor));
+	memcpy(dst->_mosaicPriority, src->_mosaicPriority, sizeof(dst->_mosaicPriority));
+	memcpy(dst->_mainScreenFlags, src->_mainScreenFlags, sizeof(dst->_mainScreenFlags));
+	memcpy(dst->_mainScreenBuffer, src->_mainScreenBuffer, sizeof(dst->_mainScreenBuffer));
+	memcpy(dst->_subScreenPriority, src->_subScreenPriority, sizeof(dst->_subScreenPriority));
+	memcpy(dst->_subScreenBuffer, src->_subScreenBuffer, sizeof(dst->_subScreenBuffer));
+
+	src->_renderStateDirty = false;
+	_stateSynced = true;
+}
+
+void SnesPpuRenderThread::CopyStateFromRenderer()
+{
+	WaitForIdle();
+
+	//VRAM/CGRAM/registers are always up to date on the emulation thread, only copy the data the renderer itself updates
+	SnesPpu* src = _renderPpu.get();
+	SnesPpu* dst = _ppu;
+	dst->_state.Mode7.HScrollLatch = src->_state.Mode7.HScrollLatch;
+	dst->_state.Mode7.VScrollLatch = src->_state.Mode7.VScrollLatch;
+	memcpy(dst->_layerData, src->_layerData, sizeof(dst->_layerData));
+	dst->_hOffset = src->_hOffset;
+	dst->_vOffset = src->_vOffset;
+	memcpy(dst->_mosaicColor, src->_mosaicColor, sizeof(dst->_mosaicColor));
+	memcpy(dst->_mosaicPriority, src->_mosaicPriority, sizeof(dst->_mosaicPriority));
+	_stateSynced = true;
+}
+
+void SnesPpuRenderThread::Exec()
+{
+	while(true) {
+		unique_ptr<SnesPpuRenderBatch> batch;
+		{
+			auto lock = _lock.AcquireSafe();
+			if(!_pendingBatches.empty()) {
+				batch = std::move(_pendingBatches.front());
+				_pendingBatches.pop_front();
+				_busy = true;
+			}
+		}
+
+		if(!batch) {
+			if(_stopFlag.load()) {
+				break;
+			}
+			_workSignal.Wait();
+			continue;
+		}
+
+		ProcessBatch(*batch);
+		batch->Commands.clear();
+		batch->States.clear();
+
+		{
+			auto lock = _lock.AcquireSafe();
+			_freeBatches.push_back(std::move(batch));
+			_busy = false;
+		}
+		_idleSignal.Signal();
+	}
+}
+
+void SnesPpuRenderThread::ProcessBatch(SnesPpuRenderBatch& batch)
+{
+	SnesPpu* ppu = _renderPpu.get();
+
+	if(ppu->_scanline != batch.Scanline || ppu->_frameCount != batch.FrameCount) {
+		//Start of a new scanline (a scanline can be split over several batches)
+		memset(ppu->_mainScreenFlags, 0, sizeof(ppu->_mainScreenFlags));
+		memset(ppu->_subScreenPriority, 0, sizeof(ppu->_subScreenPriority));
+		ppu->_scanline = batch.Scanline;
+		ppu->_frameCount = batch.FrameCount;
+	}
+
+	ppu->_oddFrame = batch.OddFrame;
+	ppu->_overscanFrame = batch.OverscanFrame;
+	ppu->_configVisibleLayers = batch.ConfigVisibleLayers;
+	ppu->_currentBuffer = batch.OutputBuffer;
+	memcpy(ppu->_spritePriority, batch.SpritePriority, sizeof(ppu->_spritePriority));
+	memcpy(ppu->_spritePalette, batch.SpritePalette, sizeof(ppu->_spritePalette));
+	memcpy(ppu->_spriteColors, batch.SpriteColors, sizeof(ppu->_spriteColors));
+
+	for(SnesPpuRenderCommand& cmd : batch.Commands) {
+		switch(cmd.Type) {
+			case SnesPpuRenderCommandType::Render:
+				ppu->_fetchBgStart = cmd.FetchBgStart;
+				ppu->_fetchBgEnd = cmd.FetchBgEnd;
+				ppu->_drawStartX = cmd.DrawStartX;
+				ppu->_mosaicScanlineCounter = cmd.MosaicScanlineCounter;
+				ppu->_useHighResOutput = cmd.UseHighResOutput;
+				ppu->RenderBackground(cmd.HPos);
+				break;
+
+			case SnesPpuRenderCommandType::SetState: {
+				//The mode 7 scroll latches are updated by the renderer itself
+				int16_t hScrollLatch = ppu->_state.Mode7.HScrollLatch;
+				int16_t vScrollLatch = ppu->_state.Mode7.VScrollLatch;
+				ppu->_state = batch.States[cmd.Addr];
+				ppu->_state.Mode7.HScrollLatch = hScrollLatch;
+				ppu->_state.Mode7.VScrollLatch = vScrollLatch;
+				break;
+			}
+
+			case SnesPpuRenderCommandType::VramWrite:
+				ppu->_vram[cmd.Addr] = cmd.Value;
+				break;
+
+			case SnesPpuRenderCommandType::CgramWrite:
+				ppu->_cgram[cmd.Addr] = cmd.Value;
+				break;
+
+			case SnesPpuRenderCommandType::ConvertToHiRes:
+				ppu->_drawStartX = cmd.DrawStartX;
+				ppu->ConvertBufferToHiRes();
+				break;
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "pch.h"
+#include "SNES/SnesPpuTypes.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
+
+class SnesPpu;
+
+enum class SnesPpuRenderCommandType : uint8_t
+{
+	Render,
+	SetState,
+	VramWrite,
+	CgramWrite,
+	ConvertToHiRes
+};
+
+struct SnesPpuRenderCommand
+{
+	SnesPpuRenderCommandType Type;
+	bool UseHighResOutput;
+
+	//VRAM/CGRAM address (or index in SnesPpuRenderBatch::States for SetState)
+	uint16_t Addr;
+	uint16_t Value;
+
+	int16_t HPos;
+	uint16_t FetchBgStart;
+	uint16_t FetchBgEnd;
+	uint16_t DrawStartX;
+	uint16_t MosaicScanlineCounter;
+};
+
+//Everything the render thread needs to draw (part of) a scanline
+struct SnesPpuRenderBatch
+{
+	uint32_t FrameCount;
+	uint16_t Scanline;
+	uint8_t OddFrame;
+	bool OverscanFrame;
+	uint8_t ConfigVisibleLayers;
+	uint16_t* OutputBuffer;
+
+	uint8_t SpritePriority[256];
+	uint8_t SpritePalette[256];
+	uint8_t SpriteColors[256];
+
+	vector<SnesPpuRenderCommand> Commands;
+	vector<SnesPpuState> States;
+};
+
+//Renders the PPU's output on a worker thread (SnesConfig::EnableThreadedRendering)
+//The emulation thread logs everything the renderer needs (register state changes, VRAM/CGRAM writes and the
+//H position at which each part of the scanline must be drawn) and sends each scanline's log to the worker, which
+//replays it on its own copy of the PPU. Sprite evaluation/fetching (which sets the time/range over flags) and
+//all register reads are still done on the emulation thread, so the emulation itself is unaffected.
+class SnesPpuRenderThread
+{
+private:
+	SnesPpu* _ppu = nullptr;
+	unique_ptr<SnesPpu> _renderPpu;
+	uint16_t* _verifyBuffer = nullptr;
+
+	unique_ptr<thread> _thread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _workSignal;
+	AutoResetEvent _idleSignal;
+
+	SimpleLock _lock;
+	deque<unique_ptr<SnesPpuRenderBatch>> _pendingBatches;
+	vector<unique_ptr<SnesPpuRenderBatch>> _freeBatches;
+	bool _busy = false;
+
+	//Only accessed by the emulation thread
+	unique_ptr<SnesPpuRenderBatch> _batch;
+
+	//True when the PPU's copy of the data the renderer updates (fetched tile data, etc.) is up to date
+	bool _stateSynced = false;
+
+	void Exec();
+	void ProcessBatch(SnesPpuRenderBatch& batch);
+	SnesPpuRenderBatch& GetBatch();
+
+public:
+	SnesPpuRenderThread(SnesPpu* ppu);
+	~SnesPpuRenderThread();
+
+	void AddRender(int32_t hPos);
+	void AddConvertToHiRes();
+	void AddVramWrite(uint16_t addr, uint16_t value);
+	void AddCgramWrite(uint8_t addr, uint16_t value);
+
+	//Sends the commands logged so far to the render thread
+	void Flush();
+	void WaitForIdle();
+
+	//Copies the renderer state (VRAM, CGRAM, registers, fetched tile data) to/from the render thread's copy of the PPU
+	void CopyStateToRenderer();
+	void CopyStateFromRenderer();
+	bool IsStateSynced() { return _stateSynced; }
+
+	//Used by the PPU to render the same frame on both threads, to validate the render thread's output
+	uint16_t* GetVerifyBuffer() { return _verifyBuffer; }
+};
@@ -0,0 +1,255 @@
+#include "pch.h"
+#include "Shared/Audio/AudioStream.h"
+#include "Shared/Audio/AudioStreamService.h"
+
+AudioStream::AudioStream(AudioStreamService* service, unique_ptr<IAudioStreamDecoder> decoder, uint32_t startFrame, bool loop, uint32_t bufferedFrames)
+{
+	_service = service;
+	_decoder = std::move(decoder);
+	_capacity = bufferedFrames;
+	_ring.resize(_capacity * 2);
+	_decodeBuffer.resize(AudioStream::DecodeBlockSize * 2);
+	_loop = loop;
+	_position = startFrame;
+
+	if(startFrame > 0) {
+		_seekPending = true;
+		_seekFrame = startFrame;
+	}
+}
+
+bool AudioStream::Fill()
+{
+	uint32_t generation;
+	uint32_t space;
+	uint32_t seekFrame;
+	bool seekPending;
+	bool loop;
+	{
+		auto lock = _lock.AcquireSafe();
+		if(_failed) {
+			return false;
+		}
+
+		if(!_opened) {
+			//Open the file outside of the lock, the consumer only sees an empty buffer until this is done
+			lock.Release();
+			bool result = _decoder->Open();
+
+			auto openLock = _lock.AcquireSafe();
+			_opened = true;
+			_failed = !result;
+			if(result) {
+				_sampleRate = _decoder->GetSampleRate();
+				_frameCount = _decoder->GetFrameCount();
+				_loopFrame = _decoder->GetLoopFrame();
+			}
+			return true;
+		}
+
+		generation = _generation;
+		seekPending = _seekPending;
+		seekFrame = _seekFrame;
+		_seekPending = false;
+		loop = _loop;
+		space = _decoderEnded ? 0 : _capacity - _bufferedFrames;
+	}
+
+	if(seekPending) {
+		_decoder->Seek(seekFrame);
+	}
+
+	if(space == 0) {
+		return seekPending;
+	}
+
+	uint32_t framesToDecode = std::min(space, AudioStream::DecodeBlockSize);
+	uint32_t framesDecoded = 0;
+	bool ended = false;
+	bool looped = false;
+	while(framesDecoded < framesToDecode) {
+		uint32_t count = _decoder->Decode(_decodeBuffer.data() + framesDecoded * 2, framesToDecode - framesDecoded);
+		if(count == 0) {
+			//Reached the end of the stream - the seek is done here, ahead of playback, so loops are seamless
+			if(loop && !looped && _frameCount > _loopFrame && _decoder->Seek(_loopFrame)) {
+				looped = true;
+				continue;
+			}
+			ended = true;
+			break;
+		}
+		looped = false;
+		framesDecoded += count;
+	}
+
+	auto lock = _lock.AcquireSafe();
+	if(generation != _generation) {
+		//The consumer seeked while this block was being decoded, discard it
+		return true;
+	}
+
+	for(uint32_t i = 0; i < framesDecoded; i++) {
+		_ring[_writePos * 2] = _decodeBuffer[i * 2];
+		_ring[_writePos * 2 + 1] = _decodeBuffer[i * 2 + 1];
+		_writePos = _writePos + 1 == _capacity ? 0 : _writePos + 1;
+	}
+	_bufferedFrames += framesDecoded;
+	_historyFrames = std::min(_historyFrames, _capacity - _bufferedFrames);
+	_decoderEnded = ended;
+	Discard(_pendingSkip);
+	return true;
+}
+
+void AudioStream::Discard(uint32_t frameCount)
+{
+	//Drops buffered frames without reading them, the rest is discarded as soon as the worker decodes it
+	uint32_t count = std::min(frameCount, _bufferedFrames);
+	_readPos = (_readPos + count) % _capacity;
+	_bufferedFrames -= count;
+	_historyFrames = std::min(_historyFrames + count, _capacity - _bufferedFrames);
+	_pendingSkip = frameCount - count;
+}
+
+void AudioStream::AdvancePosition(uint32_t frameCount, uint32_t streamFrameCount, uint32_t loopFrame)
+{
+	_position += frameCount;
+	_framesSinceLoop += frameCount;
+	if(_loop && streamFrameCount > loopFrame) {
+		while(_position >= streamFrameCount) {
+			_position -= streamFrameCount - loopFrame;
+			_framesSinceLoop = _position - loopFrame;
+		}
+	}
+}
+
+uint32_t AudioStream::Read(int16_t* out, uint32_t frameCount)
+{
+	uint32_t framesRead;
+	uint32_t bufferedFrames;
+	uint32_t streamFrameCount;
+	uint32_t loopFrame;
+	{
+		auto lock = _lock.AcquireSafe();
+		framesRead = _pendingSkip > 0 ? 0 : std::min(frameCount, _bufferedFrames);
+		for(uint32_t i = 0; i < framesRead; i++) {
+			out[i * 2] = _ring[_readPos * 2];
+			out[i * 2 + 1] = _ring[_readPos * 2 + 1];
+			_readPos = _readPos + 1 == _capacity ? 0 : _readPos + 1;
+		}
+		_bufferedFrames -= framesRead;
+		_historyFrames = std::min(_historyFrames + framesRead, _capacity - _bufferedFrames);
+		bufferedFrames = _bufferedFrames;
+		streamFrameCount = _frameCount;
+		loopFrame = _loopFrame;
+	}
+
+	AdvancePosition(framesRead, streamFrameCount, loopFrame);
+
+	if(bufferedFrames < _capacity / 2) {
+		_service->Wake();
+	}
+
+	return framesRead;
+}
+
+void AudioStream::Skip(uint32_t frameCount)
+{
+	uint32_t streamFrameCount;
+	uint32_t loopFrame;
+	{
+		auto lock = _lock.AcquireSafe();
+		Discard(_pendingSkip + frameCount);
+		streamFrameCount = _frameCount;
+		loopFrame = _loopFrame;
+	}
+
+	AdvancePosition(frameCount, streamFrameCount, loopFrame);
+	_service->Wake();
+}
+
+void AudioStream::Flush(uint32_t frame)
+{
+	_readPos = 0;
+	_writePos = 0;
+	_bufferedFrames = 0;
+	_historyFrames = 0;
+	_pendingSkip = 0;
+	_framesSinceLoop = 0;
+	_generation++;
+	_seekPending = true;
+	_seekFrame = frame;
+	_decoderEnded = false;
+	_position = frame;
+}
+
+void AudioStream::Seek(uint32_t frame)
+{
+	if(frame == _position) {
+		return;
+	}
+
+	{
+		auto lock = _lock.AcquireSafe();
+		if(frame < _position && _position - frame <= _framesSinceLoop && _position - frame <= _historyFrames + _pendingSkip) {
+			//Seeking back to data that is still in the ring (e.g loading a state for run-ahead/rewind)
+			uint32_t count = _position - frame;
+			uint32_t skipped = std::min(count, _pendingSkip);
+			_pendingSkip -= skipped;
+			count -= skipped;
+			_readPos = (_readPos + _capacity - count) % _capacity;
+			_bufferedFrames += count;
+			_historyFrames -= count;
+			_framesSinceLoop -= _position - frame;
+			_position = frame;
+			return;
+		} else if(frame > _position && (_frameCount == 0 || frame < _frameCount) && frame - _position <= _bufferedFrames) {
+			//Seeking forward within the buffered data (no loop in between)
+			Discard(frame - _position);
+			_framesSinceLoop += frame - _position;
+			_position = frame;
+			return;
+		}
+
+		Flush(frame);
+	}
+	_service->Wake();
+}
+
+void AudioStream::SetLoop(bool loop)
+{
+	if(loop == _loop) {
+		return;
+	}
+
+	{
+		//The buffered data may have been decoded past the end of the stream with the previous loop flag
+		auto lock = _lock.AcquireSafe();
+		_loop = loop;
+		Flush(_position);
+	}
+	_service->Wake();
+}
+
+bool AudioStream::IsOpened()
+{
+	auto lock = _lock.AcquireSafe();
+	return _opened && !_failed;
+}
+
+bool AudioStream::IsPlaybackOver()
+{
+	auto lock = _lock.AcquireSafe();
+	return _failed || (_decoderEnded && _bufferedFrames == 0);
+}
+
+uint32_t AudioStream::GetSampleRate()
+{
+	auto lock = _lock.AcquireSafe();
+	return _sampleRate;
+}
+
+uint32_t AudioStream::GetBufferedFrames()
+{
+	auto lock = _lock.AcquireSafe();
+	return _bufferedFrames;
+}
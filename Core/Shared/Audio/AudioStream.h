@@ -0,0 +1,72 @@
+#pragma once
+#include "pch.h"
+#include "Shared/Interfaces/IAudioStreamDecoder.h"
+#include "Utilities/SimpleLock.h"
+
+class AudioStreamService;
+
+//Ring buffer of decoded stereo frames, filled ahead of time by the AudioStreamService's worker thread
+//The consumer side (Read/Seek/SetLoop/GetPosition) must only be used by a single thread (the emulation thread)
+class AudioStream
+{
+private:
+	static constexpr uint32_t DecodeBlockSize = 4096;
+
+	AudioStreamService* _service = nullptr;
+	unique_ptr<IAudioStreamDecoder> _decoder;
+
+	SimpleLock _lock;
+	vector<int16_t> _ring;
+	uint32_t _capacity = 0;
+	uint32_t _readPos = 0;
+	uint32_t _writePos = 0;
+	uint32_t _bufferedFrames = 0;
+
+	//Frames before the read position that are still in the ring (allows seeking back without flushing, e.g when loading a state)
+	uint32_t _historyFrames = 0;
+
+	//Frames skipped by the consumer that were not buffered yet, they are discarded when the worker provides them
+	uint32_t _pendingSkip = 0;
+
+	//Incremented whenever buffered data is discarded, to drop blocks decoded before a seek
+	uint32_t _generation = 0;
+	bool _seekPending = false;
+	uint32_t _seekFrame = 0;
+
+	bool _loop = false;
+	bool _opened = false;
+	bool _failed = false;
+	bool _decoderEnded = false;
+
+	uint32_t _sampleRate = 0;
+	uint32_t _frameCount = 0;
+	uint32_t _loopFrame = 0;
+
+	//Only accessed by the consumer
+	uint32_t _position = 0;
+	uint32_t _framesSinceLoop = 0;
+
+	//Only accessed by the worker thread
+	vector<int16_t> _decodeBuffer;
+
+	void Flush(uint32_t frame);
+	void Discard(uint32_t frameCount);
+	void AdvancePosition(uint32_t frameCount, uint32_t streamFrameCount, uint32_t loopFrame);
+
+public:
+	AudioStream(AudioStreamService* service, unique_ptr<IAudioStreamDecoder> decoder, uint32_t startFrame, bool loop, uint32_t bufferedFrames);
+
+	//Worker thread: returns true if any work was done
+	bool Fill();
+
+	uint32_t Read(int16_t* out, uint32_t frameCount);
+	void Skip(uint32_t frameCount);
+	void Seek(uint32_t frame);
+	void SetLoop(bool loop);
+
+	bool IsOpened();
+	bool IsPlaybackOver();
+	uint32_t GetPosition() { return _position; }
+	uint32_t GetSampleRate();
+	uint32_t GetBufferedFrames();
+};
@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "Shared/Audio/AudioStreamService.h"
+#include "Shared/Audio/AudioStream.h"
+#include "Shared/Interfaces/IAudioStreamDecoder.h"
+
+AudioStreamService::AudioStreamService()
+{
+	_stopFlag = false;
+}
+
+AudioStreamService::~AudioStreamService()
+{
+	_stopFlag = true;
+	if(_thread) {
+		_signal.Signal();
+		_thread->join();
+		_thread.reset();
+	}
+}
+
+shared_ptr<AudioStream> AudioStreamService::Open(unique_ptr<IAudioStreamDecoder> decoder, uint32_t startFrame, bool loop, uint32_t bufferedFrames)
+{
+	shared_ptr<AudioStream> stream(new AudioStream(this, std::move(decoder), startFrame, loop, bufferedFrames));
+
+	{
+		auto lock = _lock.AcquireSafe();
+		_streams.push_back(stream);
+		if(!_thread) {
+			_thread.reset(new thread(&AudioStreamService::Exec, this));
+		}
+	}
+
+	Wake();
+	return stream;
+}
+
+void AudioStreamService::Wake()
+{
+	_signal.Signal();
+}
+
+void AudioStreamService::Exec()
+{
+	vector<shared_ptr<AudioStream>> streams;
+	while(!_stopFlag.load()) {
+		{
+			auto lock = _lock.AcquireSafe();
+			for(weak_ptr<AudioStream>& ref : _streams) {
+				if(shared_ptr<AudioStream> stream = ref.lock()) {
+					streams.push_back(stream);
+				}
+			}
+			_streams.erase(std::remove_if(_streams.begin(), _streams.end(), [](const weak_ptr<AudioStream>& ref) { return ref.expired(); }), _streams.end());
+		}
+
+		bool workDone = false;
+		for(shared_ptr<AudioStream>& stream : streams) {
+			workDone |= stream->Fill();
+		}
+
+		//Streams that were closed by their owner are destroyed here, on the worker thread
+		streams.clear();
+
+		if(!workDone) {
+			_signal.Wait(20);
+		}
+	}
+}
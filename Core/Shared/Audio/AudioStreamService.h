@@ -0,0 +1,31 @@
+#pragma once
+#include "pch.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
+
+class AudioStream;
+class IAudioStreamDecoder;
+
+//Reads/decodes streamed audio (MSU-1 PCM tracks, HD pack OGG files, CD audio) ahead of playback on a worker thread
+//so that file I/O and decoding never happen on the emulation thread
+class AudioStreamService
+{
+private:
+	static constexpr uint32_t DefaultBufferSize = 16384;
+
+	unique_ptr<thread> _thread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _signal;
+
+	SimpleLock _lock;
+	vector<weak_ptr<AudioStream>> _streams;
+
+	void Exec();
+
+public:
+	AudioStreamService();
+	~AudioStreamService();
+
+	shared_ptr<AudioStream> Open(unique_ptr<IAudioStreamDecoder> decoder, uint32_t startFrame, bool loop, uint32_t bufferedFrames = AudioStreamService::DefaultBufferSize);
+	void Wake();
+};
@@ -0,0 +1,88 @@
+#include "pch.h"
+#include "Shared/Audio/CdAudioStreamDecoder.h"
+
+CdAudioStreamDecoder::CdAudioStreamDecoder(DiscInfo& disc)
+{
+	//Copy everything needed, the DiscInfo instance belongs to the emulation thread
+	_tracks = disc.Tracks;
+	_sectorCount = disc.DiscSectorCount;
+	for(VirtualFile& file : disc.Files) {
+		_filePaths.push_back(file.GetFilePath());
+	}
+}
+
+bool CdAudioStreamDecoder::CanStream(DiscInfo& disc)
+{
+	//Files inside archives are kept in memory by VirtualFile, there is nothing to read ahead
+	for(VirtualFile& file : disc.Files) {
+		if(file.IsArchive()) {
+			return false;
+		}
+	}
+	return disc.Files.size() > 0;
+}
+
+bool CdAudioStreamDecoder::Open()
+{
+	for(string& path : _filePaths) {
+		_files.push_back(std::make_unique<ifstream>(path, ios::binary));
+		if(!*_files.back()) {
+			return false;
+		}
+	}
+	_readBuffer.resize(CdAudioStreamDecoder::SamplesPerSector * 4);
+	return true;
+}
+
+int32_t CdAudioStreamDecoder::GetTrack(uint32_t sector)
+{
+	for(size_t i = 0; i < _tracks.size(); i++) {
+		if(sector >= _tracks[i].FirstSector && sector <= _tracks[i].LastSector) {
+			return (int32_t)i;
+		}
+	}
+	return -1;
+}
+
+uint32_t CdAudioStreamDecoder::Decode(int16_t* out, uint32_t frameCount)
+{
+	uint32_t sector = _frame / CdAudioStreamDecoder::SamplesPerSector;
+	if(sector >= _sectorCount) {
+		return 0;
+	}
+
+	//Decode at most until the end of the current sector
+	uint32_t sample = _frame % CdAudioStreamDecoder::SamplesPerSector;
+	frameCount = std::min(frameCount, CdAudioStreamDecoder::SamplesPerSector - sample);
+
+	int32_t track = GetTrack(sector);
+	if(track < 0) {
+		memset(out, 0, frameCount * 4);
+	} else {
+		TrackInfo& trk = _tracks[track];
+		ifstream& file = *_files[trk.FileIndex];
+		uint32_t startByte = trk.FileOffset + (sector - trk.FirstSector) * DiscInfo::SectorSize + sample * 4;
+
+		file.clear();
+		file.seekg(startByte, ios::beg);
+		file.read((char*)_readBuffer.data(), frameCount * 4);
+
+		//Data past the end of the file is read as 0, like VirtualFile::ReadByte
+		uint32_t bytesRead = file ? frameCount * 4 : (uint32_t)file.gcount();
+		memset(_readBuffer.data() + bytesRead, 0, frameCount * 4 - bytesRead);
+
+		uint8_t* src = _readBuffer.data();
+		for(uint32_t i = 0; i < frameCount * 2; i++) {
+			out[i] = (int16_t)(src[i * 2] | (src[i * 2 + 1] << 8));
+		}
+	}
+
+	_frame += frameCount;
+	return frameCount;
+}
+
+bool CdAudioStreamDecoder::Seek(uint32_t frame)
+{
+	_frame = frame;
+	return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include "pch.h"
+#include "Shared/Interfaces/IAudioStreamDecoder.h"
+#include "Shared/CdReader.h"
+
+//Reads raw CD-DA samples from a disc image - frame N is sample (N % 588) of sector (N / 588)
+//Matches the output of DiscInfo::ReadLeftSample/ReadRightSample exactly (samples outside of any track are 0)
+class CdAudioStreamDecoder final : public IAudioStreamDecoder
+{
+private:
+	static constexpr uint32_t SamplesPerSector = 588;
+
+	vector<TrackInfo> _tracks;
+	vector<string> _filePaths;
+	vector<unique_ptr<ifstream>> _files;
+	uint32_t _sectorCount = 0;
+	uint32_t _frame = 0;
+	vector<uint8_t> _readBuffer;
+
+	int32_t GetTrack(uint32_t sector);
+
+public:
+	CdAudioStreamDecoder(DiscInfo& disc);
+
+	static bool CanStream(DiscInfo& disc);
+
+	bool Open() override;
+	uint32_t Decode(int16_t* out, uint32_t frameCount) override;
+	bool Seek(uint32_t frame) override;
+
+	uint32_t GetSampleRate() override { return 44100; }
+	uint32_t GetFrameCount() override { return _sectorCount * CdAudioStreamDecoder::SamplesPerSector; }
+	uint32_t GetLoopFrame() override { return 0; }
+};
@@ -1,12 +1,69 @@
 #include "pch.h"
 #include "Shared/Audio/PcmReader.h"
-#include "Utilities/VirtualFile.h"
+#include "Shared/Audio/AudioStream.h"
+#include "Shared/Audio/AudioStreamService.h"
 #include "Utilities/Audio/HermiteResampler.h"
 
-PcmReader::PcmReader()
+PcmStreamDecoder::PcmStreamDecoder(string filename)
 {
+	_filename = filename;
+}
+
+bool PcmStreamDecoder::Open()
+{
+	_file.open(_filename, ios::binary);
+	if(!_file) {
+		return false;
+	}
+
+	_file.seekg(0, ios::end);
+	uint32_t fileSize = (uint32_t)_file.tellg();
+	if(fileSize < 12) {
+		return false;
+	}
+
+	uint8_t header[PcmStreamDecoder::HeaderSize];
+	_file.seekg(0, ios::beg);
+	_file.read((char*)header, PcmStreamDecoder::HeaderSize);
+
+	_loopFrame = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+	_frameCount = (fileSize - PcmStreamDecoder::HeaderSize) / 4;
+	_frame = 0;
+	_readBuffer.resize(PcmStreamDecoder::ReadBlockSize * 4);
+	return true;
+}
+
+uint32_t PcmStreamDecoder::Decode(int16_t* out, uint32_t frameCount)
+{
+	frameCount = std::min(frameCount, std::min(_frameCount - _frame, PcmStreamDecoder::ReadBlockSize));
+	if(frameCount == 0) {
+		return 0;
+	}
+
+	_file.read((char*)_readBuffer.data(), frameCount * 4);
+	frameCount = (uint32_t)_file.gcount() / 4;
+
+	uint8_t* src = _readBuffer.data();
+	for(uint32_t i = 0; i < frameCount * 2; i++) {
+		out[i] = (int16_t)(src[i * 2] | (src[i * 2 + 1] << 8));
+	}
+
+	_frame += frameCount;
+	return frameCount;
+}
+
+bool PcmStreamDecoder::Seek(uint32_t frame)
+{
+	_frame = std::min(frame, _frameCount);
+	_file.clear();
+	_file.seekg(PcmStreamDecoder::HeaderSize + _frame * 4, ios::beg);
+	return (bool)_file;
+}
+
+PcmReader::PcmReader(AudioStreamService* streamService)
+{
+	_streamService = streamService;
 	_done = true;
-	_loopOffset = 8;
 	_outputBuffer = new int16_t[20000];
 }
 
@@ -17,37 +74,42 @@ PcmReader::~PcmReader()
 
 bool PcmReader::Init(string filename, bool loop, uint32_t startOffset)
 {
-	if(_file) {
-		_file.close();
+	uint32_t startFrame = startOffset > PcmStreamDecoder::HeaderSize ? (startOffset - PcmStreamDecoder::HeaderSize) / 4 : 0;
+
+	if(_stream && _filename == filename) {
+		//Same track (e.g loading a save state), the stream keeps its buffered data if the position is unchanged or still buffered
+		_loop = loop;
+		_position = startFrame;
+		_done = !_loop && _position >= _frameCount;
+		_stream->SetLoop(loop);
+		_stream->Seek(startFrame);
+		return true;
 	}
 
-	_file.open(filename, ios::binary);
-	if(_file) {
-		_file.seekg(0, ios::end);
-		_fileSize = (uint32_t)_file.tellg();
-		if(_fileSize < 12) {
+	_stream.reset();
+	_filename = filename;
+
+	//The track missing flag and the track's length are visible to the game, so the file's header is read synchronously
+	//Only the sample data is read on the stream service's thread
+	ifstream file(filename, ios::binary);
+	if(file) {
+		file.seekg(0, ios::end);
+		uint32_t fileSize = (uint32_t)file.tellg();
+		uint8_t header[PcmStreamDecoder::HeaderSize] = {};
+		file.seekg(0, ios::beg);
+		file.read((char*)header, PcmStreamDecoder::HeaderSize);
+		if(fileSize < 12 || !file) {
+			_done = true;
 			return false;
 		}
 
-		_file.seekg(4, ios::beg);
-		uint32_t loopOffset = (uint8_t)_file.get();
-		loopOffset |= ((uint8_t)_file.get()) << 8;
-		loopOffset |= ((uint8_t)_file.get()) << 16;
-		loopOffset |= ((uint8_t)_file.get()) << 24;
-
-		_loopOffset = (uint32_t)loopOffset;
-
-		_prevLeft = 0;
-		_prevRight = 0;
-		_done = false;
 		_loop = loop;
-		_fileOffset = startOffset;
-		_file.seekg(_fileOffset, ios::beg);
-
-		_leftoverSampleCount = 0;
-		_pcmBuffer.clear();
+		_position = startFrame;
+		_frameCount = (fileSize - PcmStreamDecoder::HeaderSize) / 4;
+		_loopFrame = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+		_done = !_loop && _position >= _frameCount;
 		_resampler.Reset();
-
+		_stream = _streamService->Open(std::make_unique<PcmStreamDecoder>(filename), startFrame, loop);
 		return true;
 	} else {
 		_done = true;
@@ -72,72 +134,55 @@ void PcmReader::SetSampleRate(uint32_t sampleRate)
 void PcmReader::SetLoopFlag(bool loop)
 {
 	_loop = loop;
-}
-
-void PcmReader::ReadSample(int16_t &left, int16_t &right)
-{
-	uint8_t val[4];
-	_file.get(((char*)val)[0]);
-	_file.get(((char*)val)[1]);
-	_file.get(((char*)val)[2]);
-	_file.get(((char*)val)[3]);
-
-	left = val[0] | (val[1] << 8);
-	right = val[2] | (val[3] << 8);
-}
-
-void PcmReader::LoadSamples(uint32_t samplesToLoad)
-{
-	uint32_t samplesRead = 0;
-
-	int16_t left = 0;
-	int16_t right = 0;
-	for(uint32_t i = _fileOffset; i < _fileSize && samplesRead < samplesToLoad; i+=4) {
-		ReadSample(left, right);
-
-		_pcmBuffer.push_back(left);
-		_pcmBuffer.push_back(right);
-
-		_prevLeft = left;
-		_prevRight = right;
-
-		_fileOffset += 4;
-		samplesRead++;
-
-		if(samplesRead < samplesToLoad && i + 4 >= _fileSize) {
-			if(_loop) {
-				i = _loopOffset * 4 + 8;
-				_fileOffset = i;
-				_file.seekg(_fileOffset, ios::beg);
-			} else {
-				_done = true;
-			}
-		}
+	if(_stream) {
+		_stream->SetLoop(loop);
 	}
 }
 
 void PcmReader::ApplySamples(int16_t *buffer, size_t sampleCount, uint8_t volume)
 {
-	if(_done) {
+	if(_done || !_stream) {
 		return;
 	}
 
+	bool loop = _loop && _frameCount > _loopFrame;
+	uint32_t samplesLoaded = 0;
 	int32_t samplesNeeded = (int32_t)sampleCount - _resampler.GetPendingCount();
 	if(samplesNeeded > 0) {
 		uint32_t samplesToLoad = samplesNeeded * PcmReader::PcmSampleRate / _sampleRate + 2;
-		LoadSamples(samplesToLoad);
+		if(!loop) {
+			samplesToLoad = std::min(samplesToLoad, _frameCount - _position);
+		}
+
+		_pcmBuffer.resize(samplesToLoad * 2);
+		samplesLoaded = _stream->Read(_pcmBuffer.data(), samplesToLoad);
+		if(samplesLoaded < samplesToLoad) {
+			//The data isn't buffered yet - play silence and skip over the missing samples, so the
+			//game-visible position stays the same regardless of how far ahead the stream service is
+			std::fill(_pcmBuffer.begin() + samplesLoaded * 2, _pcmBuffer.end(), 0);
+			_stream->Skip(samplesToLoad - samplesLoaded);
+			samplesLoaded = samplesToLoad;
+		}
+
+		_position += samplesToLoad;
+		if(loop) {
+			while(_position >= _frameCount) {
+				_position -= _frameCount - _loopFrame;
+			}
+		}
 	}
 
-	uint32_t samplesRead = _resampler.Resample<false>(_pcmBuffer.data(), (uint32_t)_pcmBuffer.size() / 2, _outputBuffer, sampleCount);
-	_pcmBuffer.clear();
+	uint32_t samplesRead = _resampler.Resample<false>(_pcmBuffer.data(), samplesLoaded, _outputBuffer, sampleCount);
 
 	uint32_t samplesToProcess = (uint32_t)samplesRead * 2;
 	for(uint32_t i = 0; i < samplesToProcess; i++) {
 		buffer[i] += (int16_t)((int32_t)_outputBuffer[i] * volume / 255);
 	}
+
+	_done = !loop && _position >= _frameCount;
 }
 
 uint32_t PcmReader::GetOffset()
 {
-	return _fileOffset;
-}
\ No newline at end of file
+	return _stream ? PcmStreamDecoder::HeaderSize + _position * 4 : 0;
+}
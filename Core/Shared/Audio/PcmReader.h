@@ -1,41 +1,67 @@
 #pragma once
 #include "pch.h"
-#include "Utilities/Audio/stb_vorbis.h"
+#include "Shared/Interfaces/IAudioStreamDecoder.h"
 #include "Utilities/Audio/HermiteResampler.h"
 
+class AudioStream;
+class AudioStreamService;
+
+//Reads MSU-1 .pcm files (8-byte "MSU1" header + loop point, followed by 44.1kHz 16-bit stereo samples)
+class PcmStreamDecoder final : public IAudioStreamDecoder
+{
+private:
+	static constexpr uint32_t ReadBlockSize = 4096;
+
+	string _filename;
+	ifstream _file;
+	uint32_t _frameCount = 0;
+	uint32_t _loopFrame = 0;
+	uint32_t _frame = 0;
+	vector<uint8_t> _readBuffer;
+
+public:
+	static constexpr uint32_t HeaderSize = 8;
+
+	PcmStreamDecoder(string filename);
+
+	bool Open() override;
+	uint32_t Decode(int16_t* out, uint32_t frameCount) override;
+	bool Seek(uint32_t frame) override;
+
+	uint32_t GetSampleRate() override { return 44100; }
+	uint32_t GetFrameCount() override { return _frameCount; }
+	uint32_t GetLoopFrame() override { return _loopFrame; }
+};
+
 class PcmReader
 {
 private:
 	static constexpr int PcmSampleRate = 44100;
-	static constexpr int SamplesToRead = 100;
 
-	int16_t* _outputBuffer = nullptr;
+	AudioStreamService* _streamService = nullptr;
+	shared_ptr<AudioStream> _stream;
+	string _filename;
 
-	ifstream _file;
-	uint32_t _fileOffset = 0;
-	uint32_t _fileSize = 0;
-	uint32_t _loopOffset = 0;
+	int16_t* _outputBuffer = nullptr;
 
-	int16_t _prevLeft = 0;
-	int16_t _prevRight = 0;
+	bool _done = false;
 
+	//Game-visible playback state, only updated by the emulation thread (never depends on how much data the stream has buffered)
 	bool _loop = false;
-	bool _done = false;
+	uint32_t _position = 0;
+	uint32_t _frameCount = 0;
+	uint32_t _loopFrame = 0;
 
 	HermiteResampler _resampler;
 	vector<int16_t> _pcmBuffer;
-	uint32_t _leftoverSampleCount = 0;
 
 	uint32_t _sampleRate = 0;
 
-	void LoadSamples(uint32_t samplesToLoad);
-	void ReadSample(int16_t &left, int16_t &right);
-
 public:
-	PcmReader();
+	PcmReader(AudioStreamService* streamService);
 	~PcmReader();
 
-	bool Init(string filename, bool loop, uint32_t startOffset = 0);
+	bool Init(string filename, bool loop, uint32_t startOffset = PcmStreamDecoder::HeaderSize);
 	bool IsPlaybackOver();
 	void SetSampleRate(uint32_t sampleRate);
 	void SetLoopFlag(bool loop);
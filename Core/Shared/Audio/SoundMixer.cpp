@@ -7,6 +7,9 @@
 #include "Shared/RewindManager.h"
 #include "Shared/Video/VideoRenderer.h"
 #include "Shared/Audio/WaveRecorder.h"
+#include "Shared/MessageManager.h"
+#include "Shared/PerformanceTracer.h"
+#include "Shared/Audio/AudioStreamService.h"
 #include "Shared/Interfaces/IAudioProvider.h"
 #include "Utilities/Audio/Equalizer.h"
 #include "Utilities/Audio/ReverbFilter.h"
@@ -20,6 +23,7 @@ SoundMixer::SoundMixer(Emulator* emu)
 	_sampleBuffer = new int16_t[0x10000];
 	_reverbFilter.reset(new ReverbFilter());
 	_crossFeedFilter.reset(new CrossFeedFilter());
+	_streamService.reset(new AudioStreamService());
 }
 
 SoundMixer::~SoundMixer()
@@ -69,6 +73,11 @@ void SoundMixer::PlayAudioBuffer(int16_t* samples, uint32_t sampleCount, uint32_
 		return;
 	}
 
+	PipelineTraceScope trace(_emu->GetPerformanceTracer(), PipelineStage::AudioMix);
+	if(trace.IsActive()) {
+		trace.SetFrameNumber(_emu->GetFrameCount());
+	}
+
 	EmuSettings* settings = _emu->GetSettings();
 	AudioPlayerHud* audioPlayer = _emu->GetAudioPlayerHud();
 	AudioConfig cfg = settings->GetAudioConfig();
@@ -140,6 +149,7 @@ void SoundMixer::PlayAudioBuffer(int16_t* samples, uint32_t sampleCount, uint32_
 		//Only send the audio to the device if the emulation is running
 		//(this is to prevent playing an audio blip when loading a save state)
 		if(!_emu->IsPaused() && _audioDevice) {
+			trace.Next(PipelineStage::AudioDevice);
 			if(cfg.EnableAudio) {
 				_audioDevice->PlayBuffer(out, count, cfg.SampleRate, true);
 				_audioDevice->ProcessEndOfFrame();
@@ -179,6 +189,10 @@ void SoundMixer::StartRecording(string filepath)
 
 void SoundMixer::StopRecording()
 {
+	shared_ptr<WaveRecorder> recorder = _waveRecorder.lock();
+	if(recorder) {
+		MessageManager::Log("[Sound Recorder] " + recorder->GetStats().ToString());
+	}
 	_waveRecorder.reset();
 }
 
@@ -10,6 +10,7 @@ class WaveRecorder;
 class IAudioProvider;
 class CrossFeedFilter;
 class ReverbFilter;
+class AudioStreamService;
 
 class SoundMixer 
 {
@@ -27,6 +28,7 @@ private:
 
 	unique_ptr<CrossFeedFilter> _crossFeedFilter;
 	unique_ptr<ReverbFilter> _reverbFilter;
+	unique_ptr<AudioStreamService> _streamService;
 
 	void ProcessEqualizer(int16_t *samples, uint32_t sampleCount, uint32_t targetRate);
 
@@ -49,4 +51,6 @@ public:
 	void StopRecording();
 	bool IsRecording();
 	void GetLastSamples(int16_t &left, int16_t &right);
+
+	AudioStreamService* GetAudioStreamService() { return _streamService.get(); }
 };
@@ -12,6 +12,17 @@ WaveRecorder::WaveRecorder(string outputFile, uint32_t sampleRate, bool isStereo
 	
 	if(_stream) {
 		WriteHeader();
+
+		//Samples are written to the file on a separate thread
+		_queue.reset(new RecordingQueue(WaveRecorder::QueueSize, 0,
+			[](RecordingQueueItem& item, uint32_t encoderIndex) {},
+			[this](RecordingQueueItem& item) {
+				uint32_t sampleBytes = (uint32_t)item.AudioData.size() * sizeof(int16_t);
+				_stream.write((char*)item.AudioData.data(), sampleBytes);
+				_streamSize += sampleBytes;
+			}
+		));
+
 		MessageManager::DisplayMessage("SoundRecorder", "SoundRecorderStarted", _outputFile);
 	}
 }
@@ -58,9 +69,11 @@ bool WaveRecorder::WriteSamples(int16_t * samples, uint32_t sampleCount, uint32_
 		//Format changed, stop recording
 		return false;
 	} else {
-		uint32_t sampleBytes = sampleCount * (isStereo ? 4 : 2);
-		_stream.write((char*)samples, sampleBytes);
-		_streamSize += sampleBytes;
+		if(_queue) {
+			RecordingQueueItem& item = _queue->BeginPush();
+			item.AudioData.assign(samples, samples + sampleCount * (isStereo ? 2 : 1));
+			_queue->EndPush();
+		}
 		return true;
 	}
 }
@@ -77,6 +90,10 @@ void WaveRecorder::UpdateSizeValues()
 
 void WaveRecorder::CloseFile()
 {
+	if(_queue) {
+		_queue->Stop();
+	}
+
 	if(_stream && _stream.is_open()) {
 		UpdateSizeValues();
 		_stream.close();
@@ -84,3 +101,9 @@ void WaveRecorder::CloseFile()
 		MessageManager::DisplayMessage("SoundRecorder", "SoundRecorderStopped", _outputFile);
 	}
 }
+
+
+RecordingQueueStats WaveRecorder::GetStats()
+{
+	return _queue ? _queue->GetStats() : RecordingQueueStats();
+}
\ No newline at end of file
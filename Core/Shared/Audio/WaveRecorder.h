@@ -1,9 +1,13 @@
 #include "pch.h"
+#include "Utilities/Video/RecordingQueue.h"
 
 class WaveRecorder
 {
 private:
+	static constexpr uint32_t QueueSize = 16;
+
 	std::ofstream _stream;
+	unique_ptr<RecordingQueue> _queue;
 	uint32_t _streamSize;
 	uint32_t _sampleRate;
 	bool _isStereo;
@@ -18,4 +22,5 @@ public:
 	~WaveRecorder();
 
 	bool WriteSamples(int16_t* samples, uint32_t sampleCount, uint32_t sampleRate, bool isStereo);
-};
\ No newline at end of file
+	RecordingQueueStats GetStats();
+};
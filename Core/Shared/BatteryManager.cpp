@@ -1,7 +1,33 @@
 #include "pch.h"
+
+#if __has_include(<filesystem>)
+	#include <filesystem>
+	namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+	#include <experimental/filesystem>
+	namespace fs = std::experimental::filesystem;
+#endif
+
 #include "Shared/BatteryManager.h"
+#include "Shared/MessageManager.h"
 #include "Utilities/VirtualFile.h"
 #include "Utilities/FolderUtilities.h"
+#include "Utilities/Timer.h"
+
+BatteryManager::BatteryManager()
+{
+	_stopFlag = false;
+}
+
+BatteryManager::~BatteryManager()
+{
+	if(_writeThread) {
+		//Pending writes are processed before the thread ends
+		_stopFlag = true;
+		_writeSignal.Signal();
+		_writeThread->join();
+	}
+}
 
 void BatteryManager::Initialize(string romName, bool setBatteryFlag)
 {
@@ -32,10 +58,129 @@ void BatteryManager::SaveBattery(string extension, uint8_t* data, uint32_t lengt
 	}
 
 	_hasBattery = true;
-	ofstream out(GetBasePath() + extension, ios::binary);
-	if(out) {
-		out.write((char*)data, length);
+
+	string path = GetBasePath() + extension;
+	auto lock = _lock.AcquireSafe();
+
+	vector<uint8_t>& savedData = _savedData[path];
+	if(savedData.size() == length && memcmp(savedData.data(), data, length) == 0) {
+		//Nothing was modified since the last save
+		_stats.SkipCount++;
+		return;
 	}
+	savedData.assign(data, data + length);
+
+	//The file is written by the battery save thread, only the latest data is kept if the file is already waiting to be written
+	bool isPending = false;
+	for(PendingWrite& write : _pendingWrites) {
+		if(write.Path == path) {
+			write.Data = savedData;
+			isPending = true;
+			break;
+		}
+	}
+
+	if(!isPending) {
+		_pendingWrites.push_back({ path, savedData });
+	}
+
+	if(!_writeThread) {
+		_writeThread.reset(new thread(&BatteryManager::ProcessWrites, this));
+	}
+	_writeSignal.Signal();
+}
+
+bool BatteryManager::WriteFile(PendingWrite& write)
+{
+	//Write to a temporary file and then replace the existing file, to avoid losing the save if the process ends mid-write
+	string tmpPath = write.Path + ".tmp";
+	bool result = false;
+	{
+		ofstream out(tmpPath, ios::binary);
+		if(out) {
+			out.write((char*)write.Data.data(), write.Data.size());
+			out.close();
+			result = !out.fail();
+		}
+	}
+
+	std::error_code error;
+	if(result) {
+		fs::rename(fs::u8path(tmpPath), fs::u8path(write.Path), error);
+	} else {
+		fs::remove(fs::u8path(tmpPath), error);
+	}
+	return result && !error;
+}
+
+void BatteryManager::ProcessWrites()
+{
+	while(true) {
+		PendingWrite write;
+		bool hasWrite = false;
+		{
+			auto lock = _lock.AcquireSafe();
+			if(!_pendingWrites.empty()) {
+				write = std::move(_pendingWrites.front());
+				_pendingWrites.pop_front();
+				_writing = true;
+				hasWrite = true;
+			}
+		}
+
+		if(!hasWrite) {
+			if(_stopFlag) {
+				break;
+			}
+			_writeSignal.Wait();
+			continue;
+		}
+
+		Timer timer;
+		bool result = WriteFile(write);
+		double elapsed = timer.GetElapsedMS();
+
+		{
+			auto lock = _lock.AcquireSafe();
+			if(result) {
+				_stats.WriteCount++;
+				_stats.BytesWritten += write.Data.size();
+				_stats.LastWriteTime = elapsed;
+				_stats.MaxWriteTime = std::max(_stats.MaxWriteTime, elapsed);
+			} else {
+				//Forget the saved data to retry on the next save
+				_stats.ErrorCount++;
+				_savedData.erase(write.Path);
+			}
+			_writing = false;
+		}
+
+		if(!result) {
+			MessageManager::Log("[Battery] Could not write file: " + write.Path);
+		}
+		_writeDoneSignal.Signal();
+	}
+}
+
+void BatteryManager::WaitForPendingWrites()
+{
+	while(true) {
+		{
+			auto lock = _lock.AcquireSafe();
+			if(_pendingWrites.empty() && !_writing) {
+				return;
+			}
+		}
+		_writeDoneSignal.Wait(50);
+	}
+}
+
+BatterySaveStats BatteryManager::GetStats()
+{
+	auto lock = _lock.AcquireSafe();
+	BatterySaveStats stats = _stats;
+	stats.PendingCount = (uint32_t)_pendingWrites.size() + (_writing ? 1 : 0);
+	return stats;
 }
 
 vector<uint8_t> BatteryManager::LoadBattery(string extension)
@@ -52,10 +197,17 @@ vector<uint8_t> BatteryManager::LoadBattery(string extension)
 		//Used by movie player to provider initial state of ram at startup
 		batteryData = provider->LoadBattery(extension);
 	} else {
-		VirtualFile file = GetBasePath() + extension;
+		//Make sure the file is up to date (e.g when reloading the same game)
+		WaitForPendingWrites();
+
+		string path = GetBasePath() + extension;
+		VirtualFile file = path;
 		if(file.IsValid()) {
 			file.ReadFile(batteryData);
 		}
+
+		auto lock = _lock.AcquireSafe();
+		_savedData[path] = batteryData;
 	}
 
 	if(!batteryData.empty()) {
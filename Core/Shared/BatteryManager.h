@@ -1,5 +1,8 @@
 #pragma once
 #include "pch.h"
+#include <deque>
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class IBatteryProvider
 {
@@ -13,18 +16,53 @@ public:
 	virtual void OnLoadBattery(string extension, vector<uint8_t> batteryData) = 0;
 };
 
+struct BatterySaveStats
+{
+	uint32_t WriteCount;
+	uint32_t SkipCount;
+	uint32_t ErrorCount;
+	uint32_t PendingCount;
+	uint64_t BytesWritten;
+	double LastWriteTime;
+	double MaxWriteTime;
+};
+
 class BatteryManager
 {
 private:
+	struct PendingWrite
+	{
+		string Path;
+		vector<uint8_t> Data;
+	};
+
 	string _romName;
 	bool _hasBattery = false;
 
 	std::weak_ptr<IBatteryProvider> _provider;
 	std::weak_ptr<IBatteryRecorder> _recorder;
 
+	//Content of each battery file, as last loaded or written - used to skip saving memory that has not changed
+	unordered_map<string, vector<uint8_t>> _savedData;
+
+	SimpleLock _lock;
+	std::deque<PendingWrite> _pendingWrites;
+	bool _writing = false;
+	BatterySaveStats _stats = {};
+
+	unique_ptr<thread> _writeThread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _writeSignal;
+	AutoResetEvent _writeDoneSignal;
+
 	string GetBasePath();
+	bool WriteFile(PendingWrite& write);
+	void ProcessWrites();
 
 public:
+	BatteryManager();
+	~BatteryManager();
+
 	void Initialize(string romName, bool setBatteryFlag = false);
 
 	bool HasBattery() { return _hasBattery; }
@@ -37,4 +75,8 @@ public:
 	vector<uint8_t> LoadBattery(string extension);
 	void LoadBattery(string extension, uint8_t* data, uint32_t length);
 	uint32_t GetBatteryFileSize(string extension);
+
+	//Waits until all of the saves queued by SaveBattery are written to the disk
+	void WaitForPendingWrites();
+	BatterySaveStats GetStats();
 };
\ No newline at end of file
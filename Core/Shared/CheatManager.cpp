@@ -47,14 +47,32 @@ bool CheatManager::AddCheat(CheatCode code)
 	if(convertedCode->IsRamCode) {
 		_ramRefreshCheats[cpuIndex].push_back(convertedCode.value());
 	} else {
-		_cheatsByAddress[cpuIndex].emplace(convertedCode->Address, convertedCode.value());
+		AddCheatByAddress(convertedCode.value());
 		_hasCheats[cpuIndex] = true;
-		_bankHasCheats[cpuIndex][convertedCode->Address >> GetBankShift(convertedCode->Cpu)] = true;
 	}
 
 	return true;
 }
 
+void CheatManager::AddCheatByAddress(InternalCheatCode& code)
+{
+	int cpuIndex = (int)code.Cpu;
+	vector<InternalCheatCode>& cheats = _cheatsByAddress[cpuIndex];
+	auto pos = std::lower_bound(cheats.begin(), cheats.end(), code.Address, [](const InternalCheatCode& a, uint32_t addr) { return a.Address < addr; });
+	if(pos != cheats.end() && pos->Address == code.Address) {
+		//Only the first code for a given address is used
+		return;
+	}
+	cheats.insert(pos, code);
+
+	vector<uint64_t>& bitmap = _cheatAddressBitmap[cpuIndex];
+	uint32_t index = code.Address >> 6;
+	if(index >= bitmap.size()) {
+		bitmap.resize(index + 1, 0);
+	}
+	bitmap[index] |= (uint64_t)1 << (code.Address & 0x3F);
+}
+
 void CheatManager::SetCheats(vector<CheatCode>& codes)
 {
 	auto lock = _emu->AcquireLock();
@@ -89,10 +107,10 @@ void CheatManager::InternalClearCheats()
 	_cheats.clear();
 	for(int i = 0; i < CpuTypeUtilities::GetCpuTypeCount(); i++) {
 		_cheatsByAddress[i].clear();
+		_cheatAddressBitmap[i].clear();
 		_ramRefreshCheats[i].clear();
 	}
 	memset(_hasCheats, 0, sizeof(_hasCheats));
-	memset(_bankHasCheats, 0, sizeof(_bankHasCheats));
 }
 
 void CheatManager::ClearCheats(bool showMessage)
@@ -452,9 +470,19 @@ bool CheatManager::GetConvertedCheat(CheatCode input, InternalCheatCode& output)
 
 void CheatManager::RefreshRamCheats(CpuType cpuType)
 {
+	//Codes usually all target the same memory type, only look up the memory when it changes
+	ConsoleMemoryInfo mem = {};
+	MemoryType memType = {};
+	bool memLoaded = false;
+
 	for(InternalCheatCode& code : _ramRefreshCheats[(int)cpuType]) {
 		if(code.IsAbsoluteAddress) {
-			ConsoleMemoryInfo mem = _emu->GetMemory(code.MemType);
+			if(!memLoaded || code.MemType != memType) {
+				mem = _emu->GetMemory(code.MemType);
+				memType = code.MemType;
+				memLoaded = true;
+			}
+
 			if(code.Address < mem.Size) {
 				((uint8_t*)mem.Memory)[code.Address] = code.Value;
 			}
@@ -462,22 +490,15 @@ void CheatManager::RefreshRamCheats(CpuType cpuType)
 	}
 }
 
-template<CpuType cpuType>
-void CheatManager::ApplyCheat(uint32_t addr, uint8_t& value)
+void CheatManager::ProcessCheat(CpuType cpuType, uint32_t addr, uint8_t& value)
 {
-	if(_bankHasCheats[(int)cpuType][addr >> GetBankShift(cpuType)]) {
-		auto result = _cheatsByAddress[(int)cpuType].find(addr);
-		if(result != _cheatsByAddress[(int)cpuType].end()) {
-			if(result->second.Compare == -1 || result->second.Compare == value) {
-				value = result->second.Value;
-				_emu->GetConsoleUnsafe()->ProcessCheatCode(result->second, addr, value);
-			}
+	//Only called for addresses that have a code (see ApplyCheat)
+	vector<InternalCheatCode>& cheats = _cheatsByAddress[(int)cpuType];
+	auto result = std::lower_bound(cheats.begin(), cheats.end(), addr, [](const InternalCheatCode& a, uint32_t addr) { return a.Address < addr; });
+	if(result != cheats.end() && result->Address == addr) {
+		if(result->Compare == -1 || result->Compare == value) {
+			value = result->Value;
+			_emu->GetConsoleUnsafe()->ProcessCheatCode(*result, addr, value);
 		}
 	}
 }
-
-template void CheatManager::ApplyCheat<CpuType::Nes>(uint32_t addr, uint8_t& value);
-template void CheatManager::ApplyCheat<CpuType::Snes>(uint32_t addr, uint8_t& value);
-template void CheatManager::ApplyCheat<CpuType::Pce>(uint32_t addr, uint8_t& value);
-template void CheatManager::ApplyCheat<CpuType::Gameboy>(uint32_t addr, uint8_t& value);
-template void CheatManager::ApplyCheat<CpuType::Sms>(uint32_t addr, uint8_t& value);
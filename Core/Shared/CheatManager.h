@@ -46,12 +46,17 @@ class CheatManager
 private:
 	Emulator* _emu;
 	bool _hasCheats[CpuTypeUtilities::GetCpuTypeCount()] = {};
-	bool _bankHasCheats[CpuTypeUtilities::GetCpuTypeCount()][0x100] = {};
 	
 	vector<CheatCode> _cheats;
 
 	vector<InternalCheatCode> _ramRefreshCheats[CpuTypeUtilities::GetCpuTypeCount()];
-	unordered_map<uint32_t, InternalCheatCode> _cheatsByAddress[CpuTypeUtilities::GetCpuTypeCount()];
+
+	//Codes sorted by address, and a bitmap of the addresses that have a code (1 bit per address, up to the highest address used)
+	vector<InternalCheatCode> _cheatsByAddress[CpuTypeUtilities::GetCpuTypeCount()];
+	vector<uint64_t> _cheatAddressBitmap[CpuTypeUtilities::GetCpuTypeCount()];
+	
+	void AddCheatByAddress(InternalCheatCode& code);
+	__noinline void ProcessCheat(CpuType cpuType, uint32_t addr, uint8_t& value);
 	
 	optional<InternalCheatCode> TryConvertCode(CheatCode code);
 	
@@ -71,18 +76,6 @@ private:
 	optional<InternalCheatCode> ConvertFromSmsGameGenie(string code);
 	optional<InternalCheatCode> ConvertFromSmsProActionReplay(string code);
 
-	__forceinline constexpr int GetBankShift(CpuType cpuType)
-	{
-		switch(cpuType) {
-			case CpuType::Snes: return 16;
-			case CpuType::Gameboy: return 8;
-			case CpuType::Nes: return 8;
-			case CpuType::Pce: return 13;
-			case CpuType::Sms: return 8;
-			default: throw std::runtime_error("unsupported cpu type");
-		}
-	}
-
 public:
 	CheatManager(Emulator* emu);
 
@@ -107,5 +100,12 @@ public:
 	}
 
 	template<CpuType cpuType>
-	__noinline void ApplyCheat(uint32_t addr, uint8_t& value);
+	__forceinline void ApplyCheat(uint32_t addr, uint8_t& value)
+	{
+		vector<uint64_t>& bitmap = _cheatAddressBitmap[(int)cpuType];
+		uint32_t index = addr >> 6;
+		if(index < bitmap.size() && ((bitmap[index] >> (addr & 0x3F)) & 0x01)) {
+			ProcessCheat(cpuType, addr, value);
+		}
+	}
 };
\ No newline at end of file
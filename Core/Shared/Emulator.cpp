@@ -13,6 +13,7 @@
 #include "Shared/EmuSettings.h"
 #include "Shared/SaveStateManager.h"
 #include "Shared/Video/DebugStats.h"
+#include "Shared/PerformanceTracer.h"
 #include "Shared/RewindManager.h"
 #include "Shared/ShortcutKeyHandler.h"
 #include "Shared/EmulatorLock.h"
@@ -26,6 +27,7 @@
 #include "Shared/HistoryViewer.h"
 #include "Netplay/GameServer.h"
 #include "Netplay/GameClient.h"
+#include "Netplay/RollbackManager.h"
 #include "Shared/Interfaces/IConsole.h"
 #include "Shared/Interfaces/IBarcodeReader.h"
 #include "Shared/Interfaces/ITapeRecorder.h"
@@ -66,7 +68,8 @@ Emulator::Emulator() :
 	_historyViewer(new HistoryViewer(this)),
 	_gameServer(new GameServer(this)),
 	_gameClient(new GameClient(this)),
-	_rewindManager(new RewindManager(this))
+	_rewindManager(new RewindManager(this)),
+	_perfTracer(new PerformanceTracer())
 {
 	_paused = false;
 	_pauseOnNextFrame = false;
@@ -99,7 +102,9 @@ void Emulator::Initialize(bool enableShortcuts)
 
 void Emulator::Release()
 {
+	_saveStateManager->WaitForPendingSaves();
 	Stop(true);
+	_batteryManager->WaitForPendingWrites();
 
 	_gameClient->Disconnect();
 	_gameServer->StopServer();
@@ -135,17 +140,40 @@ void Emulator::Run()
 	_lastFrameTimer.Reset();
 
 	while(!_stopFlag) {
+		shared_ptr<RollbackManager> rollback = _gameClient->GetRollbackManager();
+		uint32_t movieSeekFrames = _movieManager->GetSeekFrameCount();
+		bool useRollback = rollback && rollback->IsEnabled() && !_debugger && movieSeekFrames == 0;
 		bool useRunAhead = _settings->GetEmulationConfig().RunAheadFrames > 0 && !_debugger && !_audioPlayerHud && !_rewindManager->IsRewinding() && _settings->GetEmulationSpeed() > 0 && _settings->GetEmulationSpeed() <= 100;
-		if(useRunAhead) {
+		if(rollback && !useRollback) {
+			//Keep the input history up to date, the server's input is used as-is until the rollback loop runs again
+			rollback->SaveFrame(false);
+			if(!rollback->VerifyChecksums()) {
+				_gameClient->RequestResync();
+			}
+		}
+
+		if(movieSeekFrames > 0) {
+			RunFrameWithMovieSeek(movieSeekFrames);
+		} else if(useRollback) {
+			RunFrameWithRollback(rollback.get());
+		} else if(useRunAhead) {
 			RunFrameWithRunAhead();
 		} else {
-			_console->RunFrame();
+			{
+				PipelineTraceScope trace(_perfTracer.get(), PipelineStage::Emulate);
+				_console->RunFrame();
+				if(trace.IsActive()) {
+					trace.SetFrameNumber(GetFrameCount());
+				}
+			}
 			_rewindManager->ProcessEndOfFrame();
 			_historyViewer->ProcessEndOfFrame();
 			ProcessSystemActions();
 		}
 
+		_movieManager->ProcessEndOfFrame();
 		ProcessAutoSaveState();
+		ProcessAutoSaveBattery();
 
 		WaitForLock();
 
@@ -154,7 +182,7 @@ void Emulator::Run()
 			_paused = true;
 		}
 
-		if(_paused && !_stopFlag && !_debugger) {
+		if(_paused && !_stopFlag && !_debugger && _movieManager->GetSeekFrameCount() == 0) {
 			WaitForPauseEnd();
 		}
 	}
@@ -170,6 +198,22 @@ void Emulator::Run()
 	PlatformUtilities::RestoreTimerResolution();
 }
 
+void Emulator::ProcessAutoSaveBattery()
+{
+	if(_autoSaveBatteryFrameCounter > 0) {
+		_autoSaveBatteryFrameCounter--;
+		if(_autoSaveBatteryFrameCounter == 0) {
+			//Only the battery files whose content changed are written (by the battery manager's thread)
+			_console->SaveBattery();
+		}
+	} else {
+		uint32_t batterySaveDelay = _settings->GetPreferences().AutoSaveBatteryDelay;
+		if(batterySaveDelay > 0) {
+			_autoSaveBatteryFrameCounter = (uint32_t)(GetFps() * batterySaveDelay);
+		}
+	}
+}
+
 void Emulator::ProcessAutoSaveState()
 {
 	if(_autoSaveStateFrameCounter > 0) {
@@ -208,6 +252,9 @@ void Emulator::RunFrameWithRunAhead()
 	stringstream runAheadState;
 	uint32_t frameCount = _settings->GetEmulationConfig().RunAheadFrames;
 
+	//Traced as a single emulation step, including the extra run ahead frames
+	PipelineTraceScope trace(_perfTracer.get(), PipelineStage::Emulate);
+
 	//Run a single frame and save the state (no audio/video)
 	_isRunAheadFrame = true;
 	_console->RunFrame();
@@ -222,6 +269,9 @@ void Emulator::RunFrameWithRunAhead()
 
 	//Run one frame normally (with audio/video output)
 	_console->RunFrame();
+	if(trace.IsActive()) {
+		trace.SetFrameNumber(GetFrameCount());
+	}
 	_rewindManager->ProcessEndOfFrame();
 	_historyViewer->ProcessEndOfFrame();
 
@@ -234,6 +284,60 @@ void Emulator::RunFrameWithRunAhead()
 	}
 }
 
+void Emulator::RunFrameWithRollback(RollbackManager* rollback)
+{
+	//Traced as a single emulation step, including the frames that are run again after a rollback
+	PipelineTraceScope trace(_perfTracer.get(), PipelineStage::Emulate);
+
+	//Load the state for the first frame that used mispredicted input and run the frames again (no audio/video)
+	_isRunAheadFrame = true;
+	uint32_t frameCount = rollback->Rollback();
+	if(frameCount > 0) {
+		Timer timer;
+		for(uint32_t i = 0; i < frameCount; i++) {
+			rollback->SaveFrame();
+			_console->RunFrame();
+		}
+		rollback->AddRollbackStats(frameCount, timer.GetElapsedMS());
+	}
+	_isRunAheadFrame = false;
+
+	rollback->SaveFrame();
+	_console->RunFrame();
+	if(trace.IsActive()) {
+		trace.SetFrameNumber(GetFrameCount());
+	}
+
+	//Compare the state of the frames that are now confirmed with the server's state
+	if(!rollback->VerifyChecksums()) {
+		_gameClient->RequestResync();
+	}
+	_rewindManager->ProcessEndOfFrame();
+	_historyViewer->ProcessEndOfFrame();
+	ProcessSystemActions();
+}
+
+void Emulator::RunFrameWithMovieSeek(uint32_t remainingFrames)
+{
+	PipelineTraceScope trace(_perfTracer.get(), PipelineStage::Emulate);
+
+	if(remainingFrames > 1) {
+		//Replay the movie up to the frame before the seek target as fast as possible (no audio/video)
+		_isRunAheadFrame = true;
+		_console->RunFrame();
+		_isRunAheadFrame = false;
+	} else {
+		//Run the target frame normally, to display it
+		_console->RunFrame();
+		_rewindManager->ProcessEndOfFrame();
+		_historyViewer->ProcessEndOfFrame();
+	}
+
+	if(trace.IsActive()) {
+		trace.SetFrameNumber(GetFrameCount());
+	}
+}
+
 void Emulator::OnBeforeSendFrame()
 {
 	if(!_isRunAheadFrame) {
@@ -493,6 +597,7 @@ bool Emulator::InternalLoadRom(VirtualFile romFile, VirtualFile patchFile, bool
 	_console->GetControlManager()->UpdateInputState();
 
 	_autoSaveStateFrameCounter = 0;
+	_autoSaveBatteryFrameCounter = 0;
 
 	//Mark the thread as paused, and release the debugger lock to avoid
 	//deadlocks with DebugBreakHelper if GameLoaded event starts the debugger
@@ -815,7 +920,7 @@ void Emulator::WaitForPauseEnd()
 	PlatformUtilities::EnableScreensaver();
 	PlatformUtilities::RestoreTimerResolution();
 
-	while(_paused && !_rewindManager->IsRewinding() && !_stopFlag && !_debugger) {
+	while(_paused && !_rewindManager->IsRewinding() && !_stopFlag && !_debugger && _movieManager->GetSeekFrameCount() == 0) {
 		//Sleep until emulation is resumed
 		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(30));
 
@@ -26,6 +26,7 @@ class MovieManager;
 class HistoryViewer;
 class FrameLimiter;
 class DebugStats;
+class PerformanceTracer;
 class BaseControlManager;
 class VirtualFile;
 class BaseVideoFilter;
@@ -34,6 +35,7 @@ class SystemActionManager;
 class AudioPlayerHud;
 class GameServer;
 class GameClient;
+class RollbackManager;
 
 class IInputRecorder;
 class IInputProvider;
@@ -85,6 +87,7 @@ private:
 	const shared_ptr<GameServer> _gameServer;
 	const shared_ptr<GameClient> _gameClient;
 	const shared_ptr<RewindManager> _rewindManager;
+	const unique_ptr<PerformanceTracer> _perfTracer;
 
 	thread::id _emulationThreadId;
 
@@ -115,6 +118,7 @@ private:
 	double _frameDelay = 0;
 	
 	uint32_t _autoSaveStateFrameCounter = 0;
+	uint32_t _autoSaveBatteryFrameCounter = 0;
 	int32_t _stopCode = 0;
 	bool _stopRequested = false;
 
@@ -122,8 +126,11 @@ private:
 	void WaitForPauseEnd();
 
 	void ProcessAutoSaveState();
+	void ProcessAutoSaveBattery();
 	bool ProcessSystemActions();
 	void RunFrameWithRunAhead();
+	void RunFrameWithRollback(RollbackManager* rollback);
+	void RunFrameWithMovieSeek(uint32_t remainingFrames);
 
 	void BlockDebuggerRequests();
 	void ResetDebugger(bool startDebugger = false);
@@ -199,6 +206,7 @@ public:
 	CheatManager* GetCheatManager() { return _cheatManager.get(); }
 	MovieManager* GetMovieManager() { return _movieManager.get(); }
 	HistoryViewer* GetHistoryViewer() { return _historyViewer.get(); }
+	PerformanceTracer* GetPerformanceTracer() { return _perfTracer.get(); }
 	GameServer* GetGameServer() { return _gameServer.get(); }
 	GameClient* GetGameClient() { return _gameClient.get(); }
 	shared_ptr<SystemActionManager> GetSystemActionManager() { return _systemActionManager; }
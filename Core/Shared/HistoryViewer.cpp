@@ -18,10 +18,23 @@ HistoryViewer::HistoryViewer(Emulator* emu)
 	_emu = emu;
 	_position = 0;
 	_pollCounter = 0;
+	_stopWorkers = false;
 }
 
 HistoryViewer::~HistoryViewer()
 {
+	StopWorkers();
+}
+
+void HistoryViewer::StopWorkers()
+{
+	_stopWorkers = true;
+	_workSignal.Signal();
+	for(unique_ptr<thread>& worker : _workers) {
+		worker->join();
+	}
+	_workers.clear();
+	_stopWorkers = false;
 }
 
 bool HistoryViewer::Initialize(Emulator* mainEmu)
@@ -44,8 +57,32 @@ bool HistoryViewer::Initialize(Emulator* mainEmu)
 	//Disable battery saving for this instance
 	_emu->GetBatteryManager()->Initialize("");
 	
+	StopWorkers();
 	_history = mainEmu->GetRewindManager()->GetHistory();
-	
+
+	_fullStates.clear();
+	_segments.clear();
+	for(size_t i = 0; i < _history.size(); i++) {
+		if(_history[i].IsFullState) {
+			_fullStates.push_back((uint32_t)i);
+		}
+		if(_history[i].EndOfSegment || i == _history.size() - 1) {
+			_segments.push_back((uint32_t)i);
+		}
+	}
+
+	{
+		auto lock = _cacheLock.AcquireSafe();
+		_cache.clear();
+		_cacheSize = 0;
+		_pendingDecodes.clear();
+	}
+
+	uint32_t workerCount = std::clamp<uint32_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+	for(uint32_t i = 0; i < workerCount; i++) {
+		_workers.push_back(unique_ptr<thread>(new thread(&HistoryViewer::ProcessDecodes, this)));
+	}
+
 	_emu->UnregisterInputProvider(this);
 	_emu->RegisterInputProvider(this);
 	
@@ -76,15 +113,13 @@ HistoryViewerState HistoryViewer::GetState()
 	state.Fps = _emu->GetTimingInfo(_emu->GetCpuTypes()[0]).Fps;
 
 	uint32_t segmentCount = 0;
-	for(size_t i = 0; i < _history.size(); i++) {
-		if(_history[i].EndOfSegment || i == _history.size() - 1) {
-			state.Segments[segmentCount] = (uint32_t)i * RewindManager::BufferSize;
-			segmentCount++;
+	for(uint32_t segment : _segments) {
+		state.Segments[segmentCount] = segment * RewindManager::BufferSize;
+		segmentCount++;
 
-			if(segmentCount == 1000) {
-				//Reached max count, can't return any more values
-				break;
-			}
+		if(segmentCount == 1000) {
+			//Reached max count, can't return any more values
+			break;
 		}
 	}
 
@@ -101,8 +136,8 @@ void HistoryViewer::SeekTo(uint32_t seekPosition)
 		auto lock = _emu->AcquireLock();
 		
 		_position = seekPosition;
-		RewindData rewindData = _history[_position];
-		rewindData.LoadState(_emu, _history, _position);
+		LoadHistoryState(_emu, _position);
+		Prefetch(_position);
 
 		_emu->GetSoundMixer()->StopAudio(true);
 		_pollCounter = 0;
@@ -154,6 +189,9 @@ bool HistoryViewer::SaveMovie(string movieFile, uint32_t startPosition, uint32_t
 void HistoryViewer::ResumeGameplay(uint32_t resumePosition)
 {
 	resumePosition /= RewindManager::BufferSize;
+	if(_history.empty()) {
+		return;
+	}
 
 	auto lock = _mainEmu->AcquireLock();
 	RomInfo mainRom = _mainEmu->GetRomInfo();
@@ -166,20 +204,15 @@ void HistoryViewer::ResumeGameplay(uint32_t resumePosition)
 		}
 	}
 
-	if(resumePosition < _history.size()) {
-		_history[resumePosition].LoadState(_mainEmu, _history, resumePosition);
-	} else {
-		_history[_history.size() - 1].LoadState(_mainEmu, _history, (int32_t)_history.size() - 1);
-	}
+	LoadHistoryState(_mainEmu, std::min(resumePosition, (uint32_t)_history.size() - 1));
 }
 
 bool HistoryViewer::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
 	if(_position < _history.size()) {
-		std::deque<ControlDeviceState> &stateData = _history[_position].InputLogs[port];
-		if(_pollCounter < stateData.size()) {
-			ControlDeviceState state = stateData[_pollCounter];
+		ControlDeviceState state;
+		if(_history[_position].InputLogs[port].Get(_pollCounter, state)) {
 			device->SetRawState(state);
 		}
 	}
@@ -206,7 +239,121 @@ void HistoryViewer::ProcessEndOfFrame()
 			return;
 		}
 
-		RewindData rewindData = _history[_position];
-		rewindData.LoadState(_emu, _history, _position);
+		LoadHistoryState(_emu, _position);
+		Prefetch(_position);
+	}
+}
+
+shared_ptr<vector<uint8_t>> HistoryViewer::GetCachedState(uint32_t position)
+{
+	auto lock = _cacheLock.AcquireSafe();
+	auto result = _cache.find(position);
+	if(result != _cache.end()) {
+		result->second.LastUse = ++_cacheCounter;
+		return result->second.Data;
+	}
+	return nullptr;
+}
+
+shared_ptr<vector<uint8_t>> HistoryViewer::DecodeState(uint32_t position)
+{
+	//Called by both the emulation and worker threads (_history is not modified after Initialize)
+	shared_ptr<vector<uint8_t>> state = GetCachedState(position);
+	if(state) {
+		return state;
+	}
+
+	RewindData& data = _history[position];
+	state.reset(new vector<uint8_t>());
+	if(!data.DecompressState(*state)) {
+		return nullptr;
+	}
+
+	if(!data.IsFullState) {
+		//XOR with the previous full state
+		auto fullState = std::lower_bound(_fullStates.begin(), _fullStates.end(), position);
+		if(fullState != _fullStates.begin()) {
+			shared_ptr<vector<uint8_t>> fullStateData = DecodeState(*(fullState - 1));
+			if(fullStateData) {
+				vector<uint8_t>& src = *fullStateData;
+				vector<uint8_t>& dst = *state;
+				for(size_t i = 0, len = std::min(src.size(), dst.size()); i < len; i++) {
+					dst[i] ^= src[i];
+				}
+			}
+		}
+	}
+
+	auto lock = _cacheLock.AcquireSafe();
+	if(_cache.find(position) == _cache.end()) {
+		while(_cacheSize + state->size() > HistoryViewer::MaxCacheSize && !_cache.empty()) {
+			//Evict the least recently used state
+			auto oldest = _cache.begin();
+			for(auto it = _cache.begin(); it != _cache.end(); it++) {
+				if(it->second.LastUse < oldest->second.LastUse) {
+					oldest = it;
+				}
+			}
+			_cacheSize -= oldest->second.Data->size();
+			_cache.erase(oldest);
+		}
+
+		_cache[position] = { state, ++_cacheCounter };
+		_cacheSize += state->size();
+	}
+	return state;
+}
+
+void HistoryViewer::LoadHistoryState(Emulator* emu, uint32_t position)
+{
+	shared_ptr<vector<uint8_t>> state = DecodeState(position);
+	if(state) {
+		stringstream stream;
+		stream.write((char*)state->data(), state->size());
+		stream.seekg(0, ios::beg);
+		emu->Deserialize(stream, SaveStateManager::FileFormatVersion, true);
+	}
+}
+
+void HistoryViewer::Prefetch(uint32_t position)
+{
+	//Decode the states around the current position on the worker threads, nearest (and following) states first
+	auto lock = _cacheLock.AcquireSafe();
+	_pendingDecodes.clear();
+	for(uint32_t i = 1; i <= HistoryViewer::PrefetchRange; i++) {
+		if(position + i < _history.size()) {
+			_pendingDecodes.push_back(position + i);
+		}
+		if(position >= i) {
+			_pendingDecodes.push_back(position - i);
+		}
+	}
+	_workSignal.Signal();
+}
+
+void HistoryViewer::ProcessDecodes()
+{
+	while(!_stopWorkers) {
+		uint32_t position;
+		{
+			auto lock = _cacheLock.AcquireSafe();
+			if(_pendingDecodes.empty()) {
+				position = UINT32_MAX;
+			} else {
+				position = _pendingDecodes.front();
+				_pendingDecodes.pop_front();
+				if(!_pendingDecodes.empty()) {
+					//Wake up another worker to process the next state
+					_workSignal.Signal();
+				}
+			}
+		}
+
+		if(position == UINT32_MAX) {
+			//Workers share the same signal, use a timeout to make sure they all see the stop flag
+			_workSignal.Wait(100);
+		} else {
+			DecodeState(position);
+		}
 	}
 }
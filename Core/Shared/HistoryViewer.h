@@ -1,8 +1,11 @@
 #pragma once
 #include "pch.h"
 #include <deque>
+#include <unordered_map>
 #include "Shared/Interfaces/IInputProvider.h"
 #include "Shared/RewindData.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Emulator;
 class BaseControlDevice;
@@ -30,12 +33,43 @@ struct HistoryViewerOptions
 class HistoryViewer : public IInputProvider
 {
 private:
+	//Decoded states kept in memory (the states around the current position are decoded ahead of time by worker threads)
+	static constexpr size_t MaxCacheSize = 64 * 1024 * 1024;
+	static constexpr uint32_t PrefetchRange = 4;
+
+	struct CachedState
+	{
+		shared_ptr<vector<uint8_t>> Data;
+		uint64_t LastUse;
+	};
+
 	Emulator* _emu = nullptr;
 	Emulator* _mainEmu = nullptr;
 	deque<RewindData> _history;
 	uint32_t _position = 0;
 	uint32_t _pollCounter = 0;
 
+	//Positions of the full states (the other states are XOR deltas of the previous full state), and segment ends
+	vector<uint32_t> _fullStates;
+	vector<uint32_t> _segments;
+
+	SimpleLock _cacheLock;
+	std::unordered_map<uint32_t, CachedState> _cache;
+	size_t _cacheSize = 0;
+	uint64_t _cacheCounter = 0;
+
+	deque<uint32_t> _pendingDecodes;
+	vector<unique_ptr<thread>> _workers;
+	AutoResetEvent _workSignal;
+	atomic<bool> _stopWorkers;
+
+	shared_ptr<vector<uint8_t>> GetCachedState(uint32_t position);
+	shared_ptr<vector<uint8_t>> DecodeState(uint32_t position);
+	void LoadHistoryState(Emulator* emu, uint32_t position);
+	void Prefetch(uint32_t position);
+	void StopWorkers();
+	void ProcessDecodes();
+
 public:
 	HistoryViewer(Emulator* emu);
 	virtual ~HistoryViewer();
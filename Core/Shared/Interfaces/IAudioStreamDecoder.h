@@ -0,0 +1,21 @@
+#pragma once
+#include "pch.h"
+
+//Source of 16-bit stereo frames for an AudioStream
+//All methods are called on the AudioStreamService's worker thread
+class IAudioStreamDecoder
+{
+public:
+	virtual ~IAudioStreamDecoder() = default;
+
+	//Opens the underlying file, returns false if the stream can't be played
+	virtual bool Open() = 0;
+
+	//Decodes up to frameCount stereo frames, returns the number of frames written (0 at the end of the stream)
+	virtual uint32_t Decode(int16_t* out, uint32_t frameCount) = 0;
+	virtual bool Seek(uint32_t frame) = 0;
+
+	virtual uint32_t GetSampleRate() = 0;
+	virtual uint32_t GetFrameCount() = 0;
+	virtual uint32_t GetLoopFrame() = 0;
+};
@@ -38,6 +38,12 @@ struct PpuFrameInfo
 	uint32_t CycleCount;
 };
 
+struct IdleLoopStats
+{
+	uint64_t SkippedCycles;
+	uint64_t CpuCycles;
+};
+
 enum class ShortcutState
 {
 	Disabled = 0,
@@ -87,6 +93,8 @@ public:
 		return info;
 	}
 
+	virtual IdleLoopStats GetIdleLoopStats() { return {}; }
+
 	virtual BaseVideoFilter* GetVideoFilter(bool getDefaultFilter) = 0;
 	virtual void GetScreenRotationOverride(uint32_t& rotation) {}
 
@@ -32,7 +32,7 @@ MesenMovie::~MesenMovie()
 void MesenMovie::Stop()
 {
 	if(_playing) {
-		bool isEndOfMovie = _lastPollCounter >= _inputData.size();
+		bool isEndOfMovie = _endOfMovie;
 
 		if(!_forTest) {
 			MessageManager::DisplayMessage("Movies", isEndOfMovie ? "MovieEnded" : "MovieStopped");
@@ -61,16 +61,18 @@ bool MesenMovie::SetInput(BaseControlDevice *device)
 	uint32_t inputRowIndex = _controlManager->GetPollCounter();
 	_lastPollCounter = inputRowIndex;
 
-	if(_inputData.size() > inputRowIndex && _inputData[inputRowIndex].size() > _deviceIndex) {
-		device->SetTextState(_inputData[inputRowIndex][_deviceIndex]);
+	vector<ControlDeviceState>* row = _inputLog.GetRow(inputRowIndex);
+	if(row && row->size() > _deviceIndex) {
+		device->SetRawState((*row)[_deviceIndex]);
 
 		_deviceIndex++;
-		if(_deviceIndex >= _inputData[inputRowIndex].size()) {
+		if(_deviceIndex >= row->size()) {
 			//Move to the next frame's data
 			_deviceIndex = 0;
 		}
 	} else {
 		//End of input data reached (movie end)
+		_endOfMovie = true;
 		_emu->GetMovieManager()->Stop();
 	}
 	return true;
@@ -81,6 +83,74 @@ bool MesenMovie::IsPlaying()
 	return _playing;
 }
 
+bool MesenMovie::Seek(uint32_t frame)
+{
+	if(!_playing) {
+		return false;
+	}
+
+	auto lock = _emu->AcquireLock();
+
+	MovieKeyframe* keyframe = nullptr;
+	for(MovieKeyframe& candidate : _keyframes) {
+		if(candidate.Frame > frame) {
+			break;
+		}
+		keyframe = &candidate;
+	}
+
+	uint32_t position = GetPosition();
+	if(frame < position || (keyframe && keyframe->Frame > position)) {
+		//Load the closest keyframe (unless the current position is closer to the target)
+		if(!keyframe || !LoadKeyframe(*keyframe)) {
+			MessageManager::Log("[Movie] Could not seek to frame " + std::to_string(frame));
+			return false;
+		}
+	}
+
+	//The remaining frames are run by the emulation thread (see Emulator::RunFrameWithMovieSeek)
+	_seekTarget = frame;
+	_seeking = GetPosition() < frame;
+	return true;
+}
+
+bool MesenMovie::LoadKeyframe(MovieKeyframe& keyframe)
+{
+	stringstream state;
+	if(keyframe.Data.empty()) {
+		if(!_reader->GetStream(MovieKeys::Keyframe + std::to_string(keyframe.Frame) + ".dat", state)) {
+			return false;
+		}
+	} else {
+		state.write(keyframe.Data.data(), keyframe.Data.size());
+	}
+
+	if(_emu->Deserialize(state, keyframe.FormatVersion, false) != DeserializeResult::Success) {
+		return false;
+	}
+
+	_lastPollCounter = keyframe.InputRow;
+	_deviceIndex = 0;
+	_controlManager->SetPollCounter(keyframe.InputRow);
+	return true;
+}
+
+uint32_t MesenMovie::GetPosition()
+{
+	uint32_t frameCount = _emu->GetFrameCount();
+	return _playing && frameCount > _startFrame ? frameCount - _startFrame : 0;
+}
+
+uint32_t MesenMovie::GetSeekFrameCount()
+{
+	uint32_t position = GetPosition();
+	if(_seeking && position < _seekTarget) {
+		return _seekTarget - position;
+	}
+	_seeking = false;
+	return 0;
+}
+
 vector<uint8_t> MesenMovie::LoadBattery(string extension)
 {
 	vector<uint8_t> batteryData;
@@ -109,25 +179,30 @@ bool MesenMovie::Play(VirtualFile &file)
 	_reader.reset(new ZipReader());
 	_reader->LoadArchive(ss);
 
-	stringstream settingsData, inputData;
+	stringstream settingsData;
 	if(!_reader->GetStream("GameSettings.txt", settingsData)) {
 		MessageManager::Log("[Movie] File not found: GameSettings.txt");
 		return false;
 	}
-	if(!_reader->GetStream("Input.txt", inputData)) {
-		MessageManager::Log("[Movie] File not found: Input.txt");
-		return false;
-	}
 
-	while(inputData) {
-		string line;
-		std::getline(inputData, line);
-		if(line.substr(0, 1) == "|") {
-			_inputData.push_back(StringUtilities::Split(line.substr(1), '|'));
+	//Movies contain either the binary input log or the text version (converted to the binary format once the input devices are known)
+	vector<uint8_t> binaryInput;
+	stringstream textInput;
+	bool hasTextInput = false;
+	if(_reader->ExtractFile(MovieInputLog::Filename, binaryInput)) {
+		if(!_inputLog.LoadData(binaryInput)) {
+			MessageManager::Log("[Movie] Invalid input data");
+			return false;
 		}
+	} else if(_reader->GetStream("Input.txt", textInput)) {
+		hasTextInput = true;
+	} else {
+		MessageManager::Log("[Movie] File not found: Input.txt");
+		return false;
 	}
 
 	_deviceIndex = 0;
+	_endOfMovie = false;
 
 	ParseSettings(settingsData);
 	
@@ -171,12 +246,113 @@ bool MesenMovie::Play(VirtualFile &file)
 	}
 
 	_controlManager->UpdateControlDevices();
+
+	if(hasTextInput && !ConvertTextInput(textInput)) {
+		return false;
+	}
+
+	_startFrame = _emu->GetFrameCount();
+	LoadKeyframes();
+
 	_controlManager->SetPollCounter(0);
 	_playing = true;
 
 	return true;
 }
 
+void MesenMovie::LoadKeyframes()
+{
+	//The movie's initial state is used as the first keyframe, the movie may contain more (see MovieRecorder::ProcessEndOfFrame)
+	MovieKeyframe start;
+	stringstream startState;
+	_emu->Serialize(startState, false);
+	start.Data = startState.str();
+	start.FormatVersion = SaveStateManager::FileFormatVersion;
+	_keyframes.push_back(std::move(start));
+
+	stringstream keyframeData;
+	if(!_reader->GetStream("Keyframes.txt", keyframeData)) {
+		return;
+	}
+
+	std::unordered_map<string, string> settings;
+	string line;
+	vector<MovieKeyframe> keyframes;
+	while(std::getline(keyframeData, line)) {
+		vector<string> values = StringUtilities::Split(line, ' ');
+		if(values.size() == 2 && values[0] == MovieKeys::KeyframeFormatVersion) {
+			settings[values[0]] = values[1];
+		} else if(values.size() == 3 && values[0] == MovieKeys::Keyframe) {
+			try {
+				MovieKeyframe keyframe;
+				keyframe.Frame = (uint32_t)std::stoul(values[1]);
+				keyframe.InputRow = (uint32_t)std::stoul(values[2]);
+				if(keyframe.Frame > 0) {
+					keyframes.push_back(keyframe);
+				}
+			} catch(std::exception&) {
+				MessageManager::Log("[Movie] Invalid keyframe: " + line);
+			}
+		}
+	}
+
+	uint32_t formatVersion = LoadInt(settings, MovieKeys::KeyframeFormatVersion);
+	if(formatVersion < SaveStateManager::MinimumSupportedVersion || formatVersion > SaveStateManager::FileFormatVersion) {
+		MessageManager::Log("[Movie] Keyframes ignored (incompatible version)");
+		return;
+	}
+
+	for(MovieKeyframe& keyframe : keyframes) {
+		keyframe.FormatVersion = formatVersion;
+	}
+	std::sort(keyframes.begin(), keyframes.end(), [](const MovieKeyframe& a, const MovieKeyframe& b) { return a.Frame < b.Frame; });
+	_keyframes.insert(_keyframes.end(), keyframes.begin(), keyframes.end());
+}
+
+bool MesenMovie::ConvertTextInput(istream& inputData)
+{
+	//Each line contains the text state of every input device (in the same order as the devices are polled)
+	//Parse each state with the matching device and keep its raw state, to avoid parsing text during playback
+	vector<shared_ptr<BaseControlDevice>> devices = _controlManager->GetControlDevices();
+	vector<ControlDeviceState> originalStates;
+	for(shared_ptr<BaseControlDevice>& device : devices) {
+		originalStates.push_back(device->GetRawState());
+	}
+
+	MovieInputLogWriter writer;
+	vector<ControlDeviceState> row;
+	string line;
+	string prevLine;
+	while(std::getline(inputData, line)) {
+		if(line.substr(0, 1) != "|") {
+			continue;
+		}
+
+		if(line != prevLine) {
+			vector<string> states = StringUtilities::Split(line.substr(1), '|');
+			row.clear();
+			for(size_t i = 0; i < states.size() && i < devices.size(); i++) {
+				devices[i]->SetTextState(states[i]);
+				row.push_back(devices[i]->GetRawState());
+			}
+			prevLine = std::move(line);
+		}
+		writer.AddRow(row);
+	}
+
+	for(size_t i = 0; i < devices.size(); i++) {
+		devices[i]->SetRawState(originalStates[i]);
+	}
+
+	vector<uint8_t> data;
+	writer.GetData(data);
+	if(!_inputLog.LoadData(data)) {
+		MessageManager::Log("[Movie] Invalid input data");
+		return false;
+	}
+	return true;
+}
+
 template<typename T>
 T FromString(string name, const vector<string> &enumNames, T defaultValue)
 {
@@ -5,6 +5,7 @@
 #include "Shared/BatteryManager.h"
 #include "Shared/Interfaces/INotificationListener.h"
 #include "Shared/Movies/MovieManager.h"
+#include "Shared/Movies/MovieInputLog.h"
 
 class ZipReader;
 class Emulator;
@@ -23,7 +24,15 @@ private:
 	bool _playing = false;
 	size_t _deviceIndex = 0;
 	uint32_t _lastPollCounter = 0;
-	vector<vector<string>> _inputData;
+	bool _endOfMovie = false;
+	MovieInputLogReader _inputLog;
+
+	vector<MovieKeyframe> _keyframes;
+
+	//Console frame count when playback started - the movie's position is derived from the console's (serialized) frame count
+	uint32_t _startFrame = 0;
+	uint32_t _seekTarget = 0;
+	bool _seeking = false;
 	vector<string> _cheats;
 	vector<CheatCode> _originalCheats;
 	stringstream _emuSettingsBackup;
@@ -32,6 +41,9 @@ private:
 	bool _forTest = false;
 
 private:
+	bool ConvertTextInput(istream& inputData);
+	void LoadKeyframes();
+	bool LoadKeyframe(MovieKeyframe& keyframe);
 	void ParseSettings(stringstream &data);
 	bool ApplySettings(istream& settingsData);
 
@@ -52,6 +64,10 @@ public:
 	bool SetInput(BaseControlDevice* device) override;
 	bool IsPlaying() override;
 
+	bool Seek(uint32_t frame) override;
+	uint32_t GetPosition() override;
+	uint32_t GetSeekFrameCount() override;
+
 	//Inherited via IBatteryProvider
 	vector<uint8_t> LoadBattery(string extension) override;
 
@@ -0,0 +1,153 @@
+#include "pch.h"
+#include "Shared/Movies/MovieInputLog.h"
+
+MovieInputLogWriter::MovieInputLogWriter()
+{
+	_data.insert(_data.end(), MovieInputLog::Header, MovieInputLog::Header + sizeof(MovieInputLog::Header));
+}
+
+void MovieInputLogWriter::WriteVarInt(vector<uint8_t>& out, uint32_t value)
+{
+	while(value >= 0x80) {
+		out.push_back((uint8_t)(value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t)value);
+}
+
+void MovieInputLogWriter::WriteRun(vector<uint8_t>& out)
+{
+	if(_runLength == 0) {
+		return;
+	}
+
+	WriteVarInt(out, _runLength);
+	WriteVarInt(out, (uint32_t)_row.size());
+	for(ControlDeviceState& state : _row) {
+		WriteVarInt(out, (uint32_t)state.State.size());
+		out.insert(out.end(), state.State.begin(), state.State.end());
+	}
+}
+
+void MovieInputLogWriter::AddRow(vector<ControlDeviceState>& row)
+{
+	_rowCount++;
+
+	if(_runLength > 0 && row.size() == _row.size()) {
+		bool isSame = true;
+		for(size_t i = 0; i < row.size(); i++) {
+			if(row[i] != _row[i]) {
+				isSame = false;
+				break;
+			}
+		}
+
+		if(isSame) {
+			_runLength++;
+			return;
+		}
+	}
+
+	WriteRun(_data);
+	_row = row;
+	_runLength = 1;
+}
+
+void MovieInputLogWriter::GetData(vector<uint8_t>& out)
+{
+	//The current run is only written to the output, more rows may still be added to it
+	out = _data;
+	WriteRun(out);
+}
+
+bool MovieInputLogReader::LoadData(vector<uint8_t>& data)
+{
+	if(data.size() < sizeof(MovieInputLog::Header) || memcmp(data.data(), MovieInputLog::Header, sizeof(MovieInputLog::Header)) != 0) {
+		return false;
+	}
+
+	_data = std::move(data);
+	_checkpoints.clear();
+	Seek(0);
+	return true;
+}
+
+bool MovieInputLogReader::ReadVarInt(uint32_t& value)
+{
+	value = 0;
+	for(int shift = 0; shift < 32; shift += 7) {
+		if(_pos >= _data.size()) {
+			return false;
+		}
+
+		uint8_t b = _data[_pos++];
+		value |= (uint32_t)(b & 0x7F) << shift;
+		if(!(b & 0x80)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool MovieInputLogReader::ReadRecord()
+{
+	if(_pos >= _data.size()) {
+		return false;
+	}
+
+	if(_rowEnd / CheckpointInterval >= _checkpoints.size()) {
+		_checkpoints.push_back({ _rowEnd, _pos });
+	}
+
+	uint32_t runLength;
+	uint32_t deviceCount;
+	if(!ReadVarInt(runLength) || !ReadVarInt(deviceCount) || runLength == 0) {
+		return false;
+	}
+
+	_row.resize(deviceCount);
+	for(ControlDeviceState& state : _row) {
+		uint32_t size;
+		if(!ReadVarInt(size) || size > _data.size() - _pos) {
+			return false;
+		}
+		state.State.assign(_data.begin() + _pos, _data.begin() + _pos + size);
+		_pos += size;
+	}
+
+	_rowStart = _rowEnd;
+	_rowEnd += runLength;
+	return true;
+}
+
+void MovieInputLogReader::Seek(uint32_t row)
+{
+	size_t index = std::min<size_t>(row / CheckpointInterval, _checkpoints.size());
+	while(index > 0 && _checkpoints[index - 1].Row > row) {
+		index--;
+	}
+
+	if(index > 0) {
+		_rowEnd = _checkpoints[index - 1].Row;
+		_pos = _checkpoints[index - 1].Position;
+	} else {
+		_rowEnd = 0;
+		_pos = sizeof(MovieInputLog::Header);
+	}
+	_rowStart = _rowEnd;
+	_row.clear();
+}
+
+vector<ControlDeviceState>* MovieInputLogReader::GetRow(uint32_t row)
+{
+	if(row < _rowStart) {
+		Seek(row);
+	}
+
+	while(row >= _rowEnd) {
+		if(!ReadRecord()) {
+			return nullptr;
+		}
+	}
+	return &_row;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include "pch.h"
+#include "Shared/ControlDeviceState.h"
+
+//Binary input log format (Input.bin):
+//The header is followed by a list of records, each one describing a run of identical input polls:
+//  [run length (varint)][device count (varint)], then for each device: [state size (varint)][raw device state]
+//The raw device states are the devices' own bit-packed states (BaseControlDevice::GetRawState)
+class MovieInputLog
+{
+public:
+	static constexpr const char* Filename = "Input.bin";
+	static constexpr uint8_t Header[4] = { 'M', 'I', 'L', 1 };
+};
+
+class MovieInputLogWriter
+{
+private:
+	vector<uint8_t> _data;
+	vector<ControlDeviceState> _row;
+	uint32_t _runLength = 0;
+	uint32_t _rowCount = 0;
+
+	void WriteVarInt(vector<uint8_t>& out, uint32_t value);
+	void WriteRun(vector<uint8_t>& out);
+
+public:
+	MovieInputLogWriter();
+
+	void AddRow(vector<ControlDeviceState>& row);
+	uint32_t GetRowCount() { return _rowCount; }
+
+	void GetData(vector<uint8_t>& out);
+};
+
+//Decodes the log on demand, one record at a time, as playback reaches it
+class MovieInputLogReader
+{
+private:
+	//Every Nth row, the position of the record that contains it is kept to be able to seek backwards
+	static constexpr uint32_t CheckpointInterval = 0x400;
+
+	struct Checkpoint
+	{
+		uint32_t Row;
+		size_t Position;
+	};
+
+	vector<uint8_t> _data;
+	size_t _pos = 0;
+
+	//Rows covered by the record that was last decoded
+	uint32_t _rowStart = 0;
+	uint32_t _rowEnd = 0;
+	vector<ControlDeviceState> _row;
+
+	vector<Checkpoint> _checkpoints;
+
+	bool ReadVarInt(uint32_t& value);
+	bool ReadRecord();
+	void Seek(uint32_t row);
+
+public:
+	bool LoadData(vector<uint8_t>& data);
+
+	//Returns nullptr once the end of the log is reached
+	vector<ControlDeviceState>* GetRow(uint32_t row);
+};
@@ -18,6 +18,8 @@ void MovieManager::Record(RecordMovieOptions options)
 	//Stop any active recording/playback before starting playback for this movie
 	Stop();
 
+	//Keep the emulation paused until the recorder is set, to make sure it sees every frame (keyframes are saved based on the frame count)
+	auto lock = _emu->AcquireLock(false);
 	shared_ptr<MovieRecorder> recorder(new MovieRecorder(_emu));
 	if(recorder->Record(options)) {
 		_recorder.reset(recorder);
@@ -43,6 +45,7 @@ void MovieManager::Play(VirtualFile file, bool forTest)
 		//Stop any active recording/playback before starting playback for this movie
 		Stop();
 
+		auto lock = _emu->AcquireLock(false);
 		if(player && player->Play(file)) {
 			_player.reset(player);
 			if(!forTest) {
@@ -71,3 +74,29 @@ bool MovieManager::Recording()
 {
 	return _recorder != nullptr;
 }
+
+bool MovieManager::Seek(uint32_t frame)
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->Seek(frame) : false;
+}
+
+uint32_t MovieManager::GetPosition()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->GetPosition() : 0;
+}
+
+uint32_t MovieManager::GetSeekFrameCount()
+{
+	shared_ptr<IMovie> player = _player.lock();
+	return player ? player->GetSeekFrameCount() : 0;
+}
+
+void MovieManager::ProcessEndOfFrame()
+{
+	shared_ptr<MovieRecorder> recorder = _recorder.lock();
+	if(recorder) {
+		recorder->ProcessEndOfFrame();
+	}
+}
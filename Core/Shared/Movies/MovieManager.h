@@ -17,6 +17,10 @@ public:
 	virtual bool Play(VirtualFile& file) = 0;
 	virtual void Stop() = 0;
 	virtual bool IsPlaying() = 0;
+
+	virtual bool Seek(uint32_t frame) = 0;
+	virtual uint32_t GetPosition() = 0;
+	virtual uint32_t GetSeekFrameCount() = 0;
 };
 
 class MovieManager
@@ -34,4 +38,12 @@ public:
 	void Stop();
 	bool Playing();
 	bool Recording();
+
+	//Seeks to the specified frame by loading the nearest keyframe and replaying the movie from there
+	bool Seek(uint32_t frame);
+	uint32_t GetPosition();
+
+	//Number of frames the emulation thread must still run (without audio/video) to reach the seek target
+	uint32_t GetSeekFrameCount();
+	void ProcessEndOfFrame();
 };
\ No newline at end of file
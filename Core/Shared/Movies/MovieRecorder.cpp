@@ -36,7 +36,12 @@ bool MovieRecorder::Record(RecordMovieOptions options)
 	_author = options.Author;
 	_description = options.Description;
 	_writer.reset(new ZipWriter());
+	_binaryInput = options.BinaryInput;
 	_inputData = stringstream();
+	_inputLog.reset(new MovieInputLogWriter());
+	_inputRowCount = 0;
+	_keyframeInterval = options.KeyframeInterval;
+	_keyframes.clear();
 	_saveStateData = stringstream();
 	_hasSaveState = false;
 
@@ -67,6 +72,9 @@ bool MovieRecorder::Record(RecordMovieOptions options)
 			_emu->GetSaveStateManager()->SaveState(_saveStateData);
 			_hasSaveState = true;
 		}
+
+		//Keyframe positions are relative to the console's frame counter (which is part of the save states) when the recording starts
+		_startFrame = _emu->GetFrameCount();
 		
 		_emu->GetBatteryManager()->SetBatteryRecorder(nullptr);
 		_emu->Unlock();
@@ -131,7 +139,13 @@ bool MovieRecorder::Stop()
 	if(_writer) {
 		_emu->UnregisterInputRecorder(this);
 
-		_writer->AddFile(_inputData, "Input.txt");
+		if(_binaryInput) {
+			vector<uint8_t> inputLog;
+			_inputLog->GetData(inputLog);
+			_writer->AddFile(inputLog, MovieInputLog::Filename);
+		} else {
+			_writer->AddFile(_inputData, "Input.txt");
+		}
 
 		stringstream out;
 		GetGameSettings(out);
@@ -154,6 +168,10 @@ bool MovieRecorder::Stop()
 			_writer->AddFile(_saveStateData, "SaveState.mss");
 		}
 
+		if(!_keyframes.empty()) {
+			WriteKeyframes();
+		}
+
 		for(auto kvp : _batteryData) {
 			_writer->AddFile(kvp.second, "Battery" + kvp.first);
 		}
@@ -168,12 +186,54 @@ bool MovieRecorder::Stop()
 	return false;
 }
 
+void MovieRecorder::WriteKeyframes()
+{
+	stringstream index;
+	WriteInt(index, MovieKeys::KeyframeFormatVersion, SaveStateManager::FileFormatVersion);
+	for(MovieKeyframe& keyframe : _keyframes) {
+		index << MovieKeys::Keyframe << " " << keyframe.Frame << " " << keyframe.InputRow << "\n";
+	}
+	_writer->AddFile(index, "Keyframes.txt");
+}
+
+void MovieRecorder::ProcessEndOfFrame()
+{
+	if(!_writer || _keyframeInterval == 0) {
+		return;
+	}
+
+	uint32_t frame = _emu->GetFrameCount() - _startFrame;
+	if(frame == 0 || frame % _keyframeInterval != 0 || (!_keyframes.empty() && _keyframes.back().Frame >= frame)) {
+		//Frames already passed (e.g after a rewind) keep the keyframe that was taken the first time
+		return;
+	}
+
+	MovieKeyframe keyframe;
+	keyframe.Frame = frame;
+	keyframe.InputRow = _inputRowCount;
+	_keyframes.push_back(keyframe);
+
+	//Favor speed over size, this runs on the emulation thread
+	stringstream state;
+	_emu->Serialize(state, false);
+	_writer->AddFile(state, MovieKeys::Keyframe + std::to_string(frame) + ".dat", MZ_BEST_SPEED);
+}
+
 void MovieRecorder::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
-	for(shared_ptr<BaseControlDevice> &device : devices) {
-		_inputData << ("|" + device->GetTextState());
+	_inputRowCount++;
+	if(_binaryInput) {
+		_inputRow.clear();
+		for(shared_ptr<BaseControlDevice>& device : devices) {
+			_inputRow.push_back(device->GetRawState());
+		}
+		_inputLog->AddRow(_inputRow);
+	} else {
+		for(shared_ptr<BaseControlDevice> &device : devices) {
+			_inputData << ("|" + device->GetTextState());
+		}
+		_inputData << "\n";
 	}
-	_inputData << "\n";
 }
 
 void MovieRecorder::OnLoadBattery(string extension, vector<uint8_t> batteryData)
@@ -216,12 +276,13 @@ bool MovieRecorder::CreateMovie(string movieFile, deque<RewindData> &data, uint3
 		_inputData = stringstream();
 
 		for(uint32_t i = startPosition; i < endPosition; i++) {
-			RewindData rewindData = data[i];
+			RewindData& rewindData = data[i];
 			for(uint32_t j = 0; j < RewindManager::BufferSize; j++) {
 				for(shared_ptr<BaseControlDevice> &device : devices) {
 					uint8_t port = device->GetPort();
-					if(j < rewindData.InputLogs[port].size()) {
-						device->SetRawState(rewindData.InputLogs[port][j]);
+					ControlDeviceState state;
+					if(rewindData.InputLogs[port].Get(j, state)) {
+						device->SetRawState(state);
 						_inputData << ("|" + device->GetTextState());
 					}
 				}
@@ -7,6 +7,7 @@
 #include "Shared/BatteryManager.h"
 #include "Shared/RewindData.h"
 #include "Shared/Movies/MovieTypes.h"
+#include "Shared/Movies/MovieInputLog.h"
 
 class ZipWriter;
 class Emulator;
@@ -22,7 +23,17 @@ private:
 	string _description;
 	unique_ptr<ZipWriter> _writer;
 	std::unordered_map<string, vector<uint8_t>> _batteryData;
+	bool _binaryInput = false;
 	stringstream _inputData;
+	unique_ptr<MovieInputLogWriter> _inputLog;
+	vector<ControlDeviceState> _inputRow;
+	uint32_t _inputRowCount = 0;
+
+	uint32_t _keyframeInterval = 0;
+	uint32_t _startFrame = 0;
+
+	//Keyframe states are written to the movie file as they are taken, only their frame/input row is kept until the movie is saved
+	vector<MovieKeyframe> _keyframes;
 	bool _hasSaveState = false;
 	stringstream _saveStateData;
 
@@ -30,6 +41,7 @@ private:
 	void WriteString(stringstream &out, string name, string value);
 	void WriteInt(stringstream &out, string name, uint32_t value);
 	void WriteBool(stringstream &out, string name, bool enabled);
+	void WriteKeyframes();
 
 public:
 	MovieRecorder(Emulator* emu);
@@ -38,6 +50,9 @@ public:
 	bool Record(RecordMovieOptions options);
 	bool Stop();
 
+	//Called by the emulation thread at the end of each frame, writes the keyframes to the movie file
+	void ProcessEndOfFrame();
+
 	// Inherited via IInputRecorder
 	void RecordInput(vector<shared_ptr<BaseControlDevice>> devices) override;
 
@@ -15,6 +15,22 @@ struct RecordMovieOptions
 	char Description[10000] = {};
 
 	RecordMovieFrom RecordFrom = RecordMovieFrom::StartWithoutSaveData;
+
+	//Store the input in the binary format (Input.bin) instead of the text format (Input.txt)
+	bool BinaryInput = false;
+
+	//Save a state in the movie every N frames, to be able to seek quickly (0 = disabled)
+	uint32_t KeyframeInterval = 0;
+};
+
+struct MovieKeyframe
+{
+	uint32_t Frame = 0;
+	uint32_t InputRow = 0;
+	uint32_t FormatVersion = 0;
+
+	//Serialized emulator state (or empty if the state is still in the movie file)
+	string Data;
 };
 
 namespace MovieKeys
@@ -26,4 +42,6 @@ namespace MovieKeys
 	constexpr const char* PatchFile = "PatchFile";
 	constexpr const char* PatchFileSha1 = "PatchFileSHA1";
 	constexpr const char* PatchedRomSha1 = "PatchedRomSHA1";
+	constexpr const char* Keyframe = "Keyframe";
+	constexpr const char* KeyframeFormatVersion = "FormatVersion";
 };
\ No newline at end of file
@@ -0,0 +1,254 @@
+#include "pch.h"
+#include "Shared/PerformanceTracer.h"
+
+atomic<uint32_t> PerformanceTracer::_nextTracerId(1);
+SimpleLock PerformanceTracer::_tracersLock;
+std::unordered_set<uint32_t> PerformanceTracer::_tracerIds;
+
+//Buffers used by the current thread, for each tracer
+struct PerformanceTracer::ThreadBufferCache
+{
+	struct Entry
+	{
+		uint32_t TracerId;
+		ThreadBuffer* Buffer;
+	};
+
+	vector<Entry> Entries;
+	uint32_t LastTracerId = 0;
+	ThreadBuffer* LastBuffer = nullptr;
+
+	~ThreadBufferCache()
+	{
+		//Give the buffers back to their tracers (the tracer can't be destroyed while its ID is being checked)
+		auto lock = PerformanceTracer::_tracersLock.AcquireSafe();
+		for(Entry& entry : Entries) {
+			if(PerformanceTracer::_tracerIds.find(entry.TracerId) != PerformanceTracer::_tracerIds.end()) {
+				entry.Buffer->InUse = false;
+			}
+		}
+	}
+};
+
+static const char* _stageNames[(int)PipelineStage::Count] = {
+	"Emulate", "Filter", "Scale", "HUD", "Present", "Audio Mix", "Audio Device", "Frame Latency"
+};
+
+PerformanceTracer::PerformanceTracer()
+{
+	_tracerId = _nextTracerId++;
+	_startTime = std::chrono::steady_clock::now();
+	_enabled = false;
+	_enableTime = 0;
+
+	auto lock = _tracersLock.AcquireSafe();
+	_tracerIds.insert(_tracerId);
+}
+
+PerformanceTracer::~PerformanceTracer()
+{
+	//Threads that still reference this tracer's buffers will ignore them once the ID is removed
+	auto lock = _tracersLock.AcquireSafe();
+	_tracerIds.erase(_tracerId);
+}
+
+void PerformanceTracer::SetEnabled(bool enabled)
+{
+	if(enabled && !_enabled) {
+		//Events recorded before this point are ignored by GetStats/SaveChromeTrace
+		_enableTime = GetTimestamp();
+	}
+	_enabled = enabled;
+}
+
+uint64_t PerformanceTracer::GetTimestamp()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _startTime).count();
+}
+
+PerformanceTracer::ThreadBuffer* PerformanceTracer::GetThreadBuffer()
+{
+	//Cache the buffers for the current thread (the tracer's ID is used instead of its pointer, in case another tracer is created at the same address)
+	thread_local ThreadBufferCache cache;
+	if(cache.LastTracerId == _tracerId) {
+		return cache.LastBuffer;
+	}
+
+	ThreadBuffer* buffer = nullptr;
+	for(ThreadBufferCache::Entry& entry : cache.Entries) {
+		if(entry.TracerId == _tracerId) {
+			buffer = entry.Buffer;
+			break;
+		}
+	}
+
+	if(!buffer) {
+		{
+			//Forget the buffers of the tracers that were destroyed
+			auto tracersLock = _tracersLock.AcquireSafe();
+			cache.Entries.erase(std::remove_if(cache.Entries.begin(), cache.Entries.end(), [](ThreadBufferCache::Entry& entry) {
+				return _tracerIds.find(entry.TracerId) == _tracerIds.end();
+			}), cache.Entries.end());
+		}
+
+		//Reuse the buffer of a thread that ended, if there is one
+		auto lock = _lock.AcquireSafe();
+		for(unique_ptr<ThreadBuffer>& candidate : _buffers) {
+			if(!candidate->InUse) {
+				buffer = candidate.get();
+				break;
+			}
+		}
+
+		if(!buffer) {
+			unique_ptr<ThreadBuffer> newBuffer(new ThreadBuffer());
+			newBuffer->ThreadIndex = (uint32_t)_buffers.size() + 1;
+			newBuffer->WriteIndex = 0;
+			newBuffer->StageMask = 0;
+			buffer = newBuffer.get();
+			_buffers.push_back(std::move(newBuffer));
+		}
+		buffer->InUse = true;
+		cache.Entries.push_back({ _tracerId, buffer });
+	}
+
+	cache.LastTracerId = _tracerId;
+	cache.LastBuffer = buffer;
+	return buffer;
+}
+
+void PerformanceTracer::AddEvent(PipelineStage stage, uint64_t start, uint64_t end, uint32_t frameNumber)
+{
+	ThreadBuffer* buffer = GetThreadBuffer();
+	uint64_t index = buffer->WriteIndex.load(std::memory_order_relaxed);
+	TraceEvent& evt = buffer->Events[index % PerformanceTracer::BufferSize];
+	evt.Start = start;
+	evt.End = end;
+	evt.FrameNumber = frameNumber;
+	evt.Stage = stage;
+	if(!(buffer->StageMask.load(std::memory_order_relaxed) & (1 << (int)stage))) {
+		buffer->StageMask |= 1 << (int)stage;
+	}
+	buffer->WriteIndex.store(index + 1, std::memory_order_release);
+}
+
+vector<std::pair<uint32_t, PerformanceTracer::TraceEvent>> PerformanceTracer::GetEvents()
+{
+	vector<std::pair<uint32_t, TraceEvent>> events;
+	uint64_t enableTime = _enableTime;
+
+	auto lock = _lock.AcquireSafe();
+	for(unique_ptr<ThreadBuffer>& buffer : _buffers) {
+		uint64_t end = buffer->WriteIndex.load(std::memory_order_acquire);
+		uint64_t start = end > PerformanceTracer::BufferSize ? end - PerformanceTracer::BufferSize : 0;
+
+		size_t firstEvent = events.size();
+		for(uint64_t i = start; i < end; i++) {
+			events.push_back({ buffer->ThreadIndex, buffer->Events[i % PerformanceTracer::BufferSize] });
+		}
+
+		//The owner thread may have overwritten the oldest entries while they were being copied (or be writing one right now), drop them
+		uint64_t newEnd = buffer->WriteIndex.load(std::memory_order_acquire) + 1;
+		uint64_t overwritten = newEnd > start + PerformanceTracer::BufferSize ? newEnd - start - PerformanceTracer::BufferSize : 0;
+		overwritten = std::min<uint64_t>(overwritten, end - start);
+		events.erase(events.begin() + firstEvent, events.begin() + firstEvent + overwritten);
+	}
+
+	events.erase(std::remove_if(events.begin(), events.end(), [=](const std::pair<uint32_t, TraceEvent>& evt) {
+		return evt.second.Start < enableTime;
+	}), events.end());
+
+	std::sort(events.begin(), events.end(), [](const std::pair<uint32_t, TraceEvent>& a, const std::pair<uint32_t, TraceEvent>& b) {
+		return a.second.Start < b.second.Start;
+	});
+
+	return events;
+}
+
+void PerformanceTracer::GetStats(PipelineStageStats stats[(int)PipelineStage::Count])
+{
+	vector<std::pair<uint32_t, TraceEvent>> events = GetEvents();
+
+	vector<double> durations[(int)PipelineStage::Count];
+	unordered_map<uint32_t, uint64_t> emulationStart;
+	for(std::pair<uint32_t, TraceEvent>& entry : events) {
+		TraceEvent& evt = entry.second;
+		durations[(int)evt.Stage].push_back((evt.End - evt.Start) / 1000000.0);
+
+		if(evt.Stage == PipelineStage::Emulate) {
+			emulationStart[evt.FrameNumber] = evt.Start;
+		} else if(evt.Stage == PipelineStage::Present) {
+			auto result = emulationStart.find(evt.FrameNumber);
+			if(result != emulationStart.end()) {
+				//Only count the first time a frame is presented (the renderer can redraw the same frame to update the HUD)
+				durations[(int)PipelineStage::FrameLatency].push_back((evt.End - result->second) / 1000000.0);
+				emulationStart.erase(result);
+			}
+		}
+	}
+
+	for(int i = 0; i < (int)PipelineStage::Count; i++) {
+		vector<double>& values = durations[i];
+		PipelineStageStats& stageStats = stats[i];
+		stageStats = {};
+		if(values.empty()) {
+			continue;
+		}
+
+		std::sort(values.begin(), values.end());
+		double total = 0;
+		for(double value : values) {
+			total += value;
+		}
+
+		auto getPercentile = [&](double percentile) {
+			return values[std::min(values.size() - 1, (size_t)(percentile * values.size()))];
+		};
+
+		stageStats.SampleCount = (uint32_t)values.size();
+		stageStats.Average = total / values.size();
+		stageStats.P50 = getPercentile(0.50);
+		stageStats.P90 = getPercentile(0.90);
+		stageStats.P99 = getPercentile(0.99);
+		stageStats.Max = values.back();
+	}
+}
+
+bool PerformanceTracer::SaveChromeTrace(string filename)
+{
+	ofstream file(filename, ios::out | ios::binary);
+	if(!file) {
+		return false;
+	}
+
+	vector<std::pair<uint32_t, TraceEvent>> events = GetEvents();
+
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Mesen\"}}";
+
+	{
+		//Threads are named after the stages they recorded
+		auto lock = _lock.AcquireSafe();
+		for(unique_ptr<ThreadBuffer>& buffer : _buffers) {
+			string name;
+			for(int i = 0; i < (int)PipelineStage::Count; i++) {
+				if(buffer->StageMask & (1 << i)) {
+					name += (name.empty() ? "" : " / ") + string(_stageNames[i]);
+				}
+			}
+			file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->ThreadIndex << ",\"args\":{\"name\":\"" << name << "\"}}";
+		}
+	}
+
+	file << std::fixed << std::setprecision(3);
+	for(std::pair<uint32_t, TraceEvent>& entry : events) {
+		TraceEvent& evt = entry.second;
+		file << ",\n{\"name\":\"" << _stageNames[(int)evt.Stage] << "\",\"cat\":\"pipeline\",\"ph\":\"X\",\"pid\":1,\"tid\":" << entry.first;
+		file << ",\"ts\":" << (evt.Start / 1000.0) << ",\"dur\":" << ((evt.End - evt.Start) / 1000.0);
+		file << ",\"args\":{\"frame\":" << evt.FrameNumber << "}}";
+	}
+
+	file << "\n]}\n";
+	file.close();
+	return true;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include "pch.h"
+#include <chrono>
+#include <unordered_set>
+#include "Utilities/SimpleLock.h"
+
+enum class PipelineStage : uint8_t
+{
+	Emulate,
+	Filter,
+	Scale,
+	Hud,
+	Present,
+	AudioMix,
+	AudioDevice,
+
+	//Not recorded directly - time between the start of a frame's emulation and the moment it is first presented
+	FrameLatency,
+
+	Count
+};
+
+struct PipelineStageStats
+{
+	uint32_t SampleCount;
+	double Average;
+	double P50;
+	double P90;
+	double P99;
+	double Max;
+};
+
+//Records timestamped events for each stage of the audio/video pipeline
+//Each thread writes to its own ring buffer, so recording an event does not take any lock
+class PerformanceTracer
+{
+private:
+	static constexpr uint32_t BufferSize = 0x4000;
+
+	struct TraceEvent
+	{
+		uint64_t Start;
+		uint64_t End;
+		uint32_t FrameNumber;
+		PipelineStage Stage;
+	};
+
+	struct ThreadBuffer
+	{
+		uint32_t ThreadIndex = 0;
+		//Cleared when the thread that uses the buffer ends, the buffer is then reused by the next new thread
+		atomic<bool> InUse;
+		atomic<uint32_t> StageMask;
+		atomic<uint64_t> WriteIndex;
+		TraceEvent Events[PerformanceTracer::BufferSize];
+	};
+
+	struct ThreadBufferCache;
+
+	static atomic<uint32_t> _nextTracerId;
+
+	//IDs of the tracers that currently exist - used by threads to know which of their cached buffers are still valid
+	static SimpleLock _tracersLock;
+	static std::unordered_set<uint32_t> _tracerIds;
+
+	uint32_t _tracerId = 0;
+	std::chrono::steady_clock::time_point _startTime;
+	atomic<bool> _enabled;
+	atomic<uint64_t> _enableTime;
+
+	//Only taken when a thread records its first event, or when reading the events
+	SimpleLock _lock;
+	vector<unique_ptr<ThreadBuffer>> _buffers;
+
+	ThreadBuffer* GetThreadBuffer();
+	vector<std::pair<uint32_t, TraceEvent>> GetEvents();
+
+public:
+	PerformanceTracer();
+	~PerformanceTracer();
+
+	void SetEnabled(bool enabled);
+	bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+
+	//Time since the tracer was created, in nanoseconds
+	uint64_t GetTimestamp();
+	void AddEvent(PipelineStage stage, uint64_t start, uint64_t end, uint32_t frameNumber);
+
+	void GetStats(PipelineStageStats stats[(int)PipelineStage::Count]);
+	bool SaveChromeTrace(string filename);
+};
+
+class PipelineTraceScope
+{
+private:
+	PerformanceTracer* _tracer;
+	PipelineStage _stage;
+	uint32_t _frameNumber;
+	uint64_t _start;
+	bool _active;
+
+public:
+	PipelineTraceScope(PerformanceTracer* tracer, PipelineStage stage, uint32_t frameNumber = 0)
+	{
+		_tracer = tracer;
+		_stage = stage;
+		_frameNumber = frameNumber;
+		_active = tracer->IsEnabled();
+		_start = _active ? _tracer->GetTimestamp() : 0;
+	}
+
+	~PipelineTraceScope()
+	{
+		End();
+	}
+
+	//Ends the current stage and starts the next one
+	void Next(PipelineStage stage)
+	{
+		End();
+		_stage = stage;
+		_active = _tracer->IsEnabled();
+		_start = _active ? _tracer->GetTimestamp() : 0;
+	}
+
+	void End()
+	{
+		if(_active) {
+			_tracer->AddEvent(_stage, _start, _tracer->GetTimestamp(), _frameNumber);
+			_active = false;
+		}
+	}
+
+	bool IsActive() { return _active; }
+	void SetFrameNumber(uint32_t frameNumber) { _frameNumber = frameNumber; }
+};
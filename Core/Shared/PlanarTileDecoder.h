@@ -0,0 +1,53 @@
+#pragma once
+#include "pch.h"
+
+//Expands each bit of a byte into its own byte (bit 7 -> lowest byte)
+struct PlanarTileExpandTable
+{
+	uint64_t Values[256] = {};
+
+	constexpr PlanarTileExpandTable()
+	{
+		for(int value = 0; value < 256; value++) {
+			uint64_t row = 0;
+			for(int i = 0; i < 8; i++) {
+				if(value & (0x80 >> i)) {
+					row |= (uint64_t)1 << (i * 8);
+				}
+			}
+			Values[value] = row;
+		}
+	}
+};
+
+//Converts a row of planar tile data (1 byte per bitplane, leftmost pixel in bit 7) into 8 chunky
+//pixels, stored 1 byte per pixel in a uint64_t (leftmost pixel in the lowest byte)
+class PlanarTileDecoder
+{
+private:
+	static constexpr PlanarTileExpandTable _expand = {};
+
+public:
+	static __forceinline uint64_t Decode2bpp(uint8_t plane0, uint8_t plane1)
+	{
+		return _expand.Values[plane0] | (_expand.Values[plane1] << 1);
+	}
+
+	static __forceinline uint64_t Decode4bpp(uint8_t plane0, uint8_t plane1, uint8_t plane2, uint8_t plane3)
+	{
+		return _expand.Values[plane0] | (_expand.Values[plane1] << 1) | (_expand.Values[plane2] << 2) | (_expand.Values[plane3] << 3);
+	}
+
+	//Reverses the order of the pixels (horizontal mirroring)
+	static __forceinline uint64_t Mirror(uint64_t row)
+	{
+		row = ((row & 0x00FF00FF00FF00FFull) << 8) | ((row >> 8) & 0x00FF00FF00FF00FFull);
+		row = ((row & 0x0000FFFF0000FFFFull) << 16) | ((row >> 16) & 0x0000FFFF0000FFFFull);
+		return (row << 32) | (row >> 32);
+	}
+
+	static __forceinline uint8_t GetPixel(uint64_t row, uint8_t column)
+	{
+		return (uint8_t)(row >> (column * 8));
+	}
+};
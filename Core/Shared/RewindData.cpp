@@ -17,6 +17,15 @@ void RewindData::GetStateData(stringstream &stateData, deque<RewindData>& prevSt
 	stateData.write((char*)data.data(), data.size());
 }
 
+uint32_t RewindData::GetMemoryUsage()
+{
+	uint32_t memoryUsage = (uint32_t)(_saveStateData.capacity() + _uncompressedData.capacity());
+	for(int i = 0; i < BaseControlDevice::PortCount; i++) {
+		memoryUsage += InputLogs[i].GetMemoryUsage();
+	}
+	return memoryUsage;
+}
+
 template<typename T>
 void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position)
 {
@@ -2,6 +2,8 @@
 #include "pch.h"
 #include <deque>
 #include "Shared/BaseControlDevice.h"
+#include "Shared/RewindInputLog.h"
+#include "Utilities/CompressionHelper.h"
 
 class Emulator;
 
@@ -15,13 +17,17 @@ private:
 	void ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position);
 
 public:
-	std::deque<ControlDeviceState> InputLogs[BaseControlDevice::PortCount];
+	RewindInputLog InputLogs[BaseControlDevice::PortCount];
 	int32_t FrameCount = 0;
 	bool EndOfSegment = false;
 	bool IsFullState = false;
 
 	void GetStateData(stringstream& stateData, deque<RewindData>& prevStates, int32_t position);
 	uint32_t GetStateSize() { return (uint32_t)_saveStateData.size(); }
+	uint32_t GetMemoryUsage();
+
+	//Decompresses the state data as is (XOR delta states must then be XORed with the previous full state's data)
+	bool DecompressState(vector<uint8_t>& data) { return CompressionHelper::Decompress(_saveStateData, data); }
 
 	void LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1, bool sendNotification = true);
 	void SaveState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1);
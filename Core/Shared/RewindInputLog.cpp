@@ -0,0 +1,94 @@
+#include "pch.h"
+#include "Shared/RewindInputLog.h"
+
+void RewindInputLog::Add(const ControlDeviceState& state)
+{
+	if(_count > 0) {
+		//Extend the last record if the state is unchanged
+		uint8_t& runLength = _data[_lastRecord];
+		uint16_t size = GetStateSize(_lastRecord);
+		if(runLength < RewindInputLog::MaxRunLength && size == state.State.size() && memcmp(_data.data() + _lastRecord + RewindInputLog::RecordHeaderSize, state.State.data(), size) == 0) {
+			runLength++;
+			_count++;
+			return;
+		}
+	}
+
+	uint16_t size = (uint16_t)state.State.size();
+	_lastRecord = _data.size();
+	_data.push_back(1);
+	_data.push_back((uint8_t)size);
+	_data.push_back((uint8_t)(size >> 8));
+	_data.insert(_data.end(), state.State.begin(), state.State.begin() + size);
+	_count++;
+}
+
+size_t RewindInputLog::FindRecord(uint32_t index, uint32_t& indexInRecord)
+{
+	size_t pos = 0;
+	while(pos < _data.size()) {
+		uint8_t runLength = _data[pos];
+		if(index < runLength) {
+			indexInRecord = index;
+			return pos;
+		}
+		index -= runLength;
+		pos += RewindInputLog::RecordHeaderSize + GetStateSize(pos);
+	}
+	return SIZE_MAX;
+}
+
+bool RewindInputLog::Get(uint32_t index, ControlDeviceState& state)
+{
+	if(index >= GetCount()) {
+		return false;
+	}
+
+	uint32_t indexInRecord;
+	size_t pos = FindRecord(_start + index, indexInRecord);
+	if(pos == SIZE_MAX) {
+		return false;
+	}
+
+	uint8_t* start = _data.data() + pos + RewindInputLog::RecordHeaderSize;
+	state.State.assign(start, start + GetStateSize(pos));
+	return true;
+}
+
+bool RewindInputLog::RemoveFirst(ControlDeviceState& state)
+{
+	if(!Get(0, state)) {
+		return false;
+	}
+
+	_start++;
+	if(_start == _count) {
+		Clear();
+	}
+	return true;
+}
+
+void RewindInputLog::Clear()
+{
+	_data.clear();
+	_lastRecord = 0;
+	_count = 0;
+	_start = 0;
+}
+
+void RewindInputLog::RemoveLast(uint32_t count)
+{
+	uint32_t newCount = count < GetCount() ? _count - count : _start;
+	if(newCount == _start) {
+		Clear();
+		return;
+	}
+
+	//Shorten the record that contains the new last state, and remove all records after it
+	uint32_t indexInRecord;
+	size_t pos = FindRecord(newCount - 1, indexInRecord);
+	_data[pos] = (uint8_t)(indexInRecord + 1);
+	_data.resize(pos + RewindInputLog::RecordHeaderSize + GetStateSize(pos));
+	_lastRecord = pos;
+	_count = newCount;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "pch.h"
+#include "Shared/ControlDeviceState.h"
+
+//Input log for a single port, for a single rewind history block
+//All of the block's states are stored in one buffer, as run-length encoded records (consecutive identical states
+//share a record): [run length (1 byte)][state size (2 bytes)][raw device state]
+class RewindInputLog
+{
+private:
+	static constexpr uint32_t RecordHeaderSize = 3;
+	static constexpr uint8_t MaxRunLength = 0xFF;
+
+	vector<uint8_t> _data;
+	size_t _lastRecord = 0;
+
+	//Number of states added to the log, and number of states removed from the start of the log
+	uint32_t _count = 0;
+	uint32_t _start = 0;
+
+	uint16_t GetStateSize(size_t pos) { return _data[pos + 1] | (_data[pos + 2] << 8); }
+	size_t FindRecord(uint32_t index, uint32_t& indexInRecord);
+	void Clear();
+
+public:
+	void Add(const ControlDeviceState& state);
+	bool Get(uint32_t index, ControlDeviceState& state);
+
+	bool RemoveFirst(ControlDeviceState& state);
+	void RemoveLast(uint32_t count);
+
+	uint32_t GetCount() { return _count - _start; }
+	bool IsEmpty() { return _count == _start; }
+	uint32_t GetMemoryUsage() { return (uint32_t)_data.capacity(); }
+};
@@ -75,11 +75,9 @@ void RewindManager::ProcessNotification(ConsoleNotificationType type, void * par
 					_currentHistory.FrameCount++;
 					if(_framesToFastForward == 0) {
 						for(int i = 0; i < 4; i++) {
-							size_t numberToRemove = _currentHistory.InputLogs[i].size();
+							uint32_t numberToRemove = _currentHistory.InputLogs[i].GetCount();
 							_currentHistory.InputLogs[i] = _historyBackup.front().InputLogs[i];
-							for(size_t j = 0; j < numberToRemove; j++) {
-								_currentHistory.InputLogs[i].pop_back();
-							}
+							_currentHistory.InputLogs[i].RemoveLast(numberToRemove);
 						}
 						_historyBackup.clear();
 						_rewindState = RewindState::Stopped;
@@ -108,7 +106,7 @@ RewindStats RewindManager::GetStats()
 {
 	uint32_t memoryUsage = 0;
 	for(int i = (int)_history.size() - 1; i >= 0; i--) {
-		memoryUsage += _history[i].GetStateSize();
+		memoryUsage += _history[i].GetMemoryUsage();
 	}
 	
 	RewindStats stats = {};
@@ -124,7 +122,7 @@ void RewindManager::AddHistoryBlock()
 	if(maxHistorySize > 0) {
 		uint32_t memoryUsage = 0;
 		for(int i = (int)_history.size() - 1; i >= 0; i--) {
-			memoryUsage += _history[i].GetStateSize();
+			memoryUsage += _history[i].GetMemoryUsage();
 			if((memoryUsage >> 20) >= maxHistorySize) {
 				//Remove all old state data above the memory limit
 				for(int j = 0; j < i; j++) {
@@ -218,11 +216,7 @@ void RewindManager::ForceStop(bool deleteFutureData)
 				_currentHistory = _historyBackup.front();
 				_currentHistory.FrameCount -= framesToRemove;
 				for(int i = 0; i < BaseControlDevice::PortCount; i++) {
-					for(int j = 0; j < orgHistory.InputLogs[i].size(); j++) {
-						if(!_currentHistory.InputLogs[i].empty()) {
-							_currentHistory.InputLogs[i].pop_back();
-						}
-					}
+					_currentHistory.InputLogs[i].RemoveLast(orgHistory.InputLogs[i].GetCount());
 				}
 			}
 			_historyBackup.clear();
@@ -399,7 +393,7 @@ void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 {
 	if(_settings->GetPreferences().RewindBufferSize > 0 && _rewindState == RewindState::Stopped) {
 		for(shared_ptr<BaseControlDevice> &device : devices) {
-			_currentHistory.InputLogs[device->GetPort()].push_back(device->GetRawState());
+			_currentHistory.InputLogs[device->GetPort()].Add(device->GetRawState());
 		}
 	}
 }
@@ -407,9 +401,8 @@ void RewindManager::RecordInput(vector<shared_ptr<BaseControlDevice>> devices)
 bool RewindManager::SetInput(BaseControlDevice *device)
 {
 	uint8_t port = device->GetPort();
-	if(!_currentHistory.InputLogs[port].empty() && IsRewinding()) {
-		ControlDeviceState state = _currentHistory.InputLogs[port].front();
-		_currentHistory.InputLogs[port].pop_front();
+	ControlDeviceState state;
+	if(IsRewinding() && _currentHistory.InputLogs[port].RemoveFirst(state)) {
 		device->SetRawState(state);
 		return true;
 	} else {
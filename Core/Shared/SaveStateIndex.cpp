@@ -0,0 +1,163 @@
+#include "pch.h"
+
+#if __has_include(<filesystem>)
+	#include <filesystem>
+	namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+	#include <experimental/filesystem>
+	namespace fs = std::experimental::filesystem;
+#endif
+
+#include "Shared/SaveStateIndex.h"
+#include "Utilities/FolderUtilities.h"
+
+string SaveStateIndex::GetIndexPath(string stateFilepath)
+{
+	//All of the save state slots for a game ("[name]_[slot].mss") share the same index file ("[name].mssidx")
+	string name = FolderUtilities::GetFilename(stateFilepath, false);
+	size_t separator = name.find_last_of('_');
+	if(separator != string::npos && separator > 0 && separator + 1 < name.size()) {
+		bool isSlot = true;
+		for(size_t i = separator + 1; i < name.size(); i++) {
+			isSlot &= name[i] >= '0' && name[i] <= '9';
+		}
+		if(isSlot) {
+			name = name.substr(0, separator);
+		}
+	}
+
+	string folder = FolderUtilities::GetFolderName(stateFilepath);
+	return folder.empty() ? name + ".mssidx" : FolderUtilities::CombinePath(folder, name + ".mssidx");
+}
+
+bool SaveStateIndex::GetFileInfo(string stateFilepath, uint64_t& size, uint64_t& modifiedTime)
+{
+	std::error_code error;
+	fs::path path = fs::u8path(stateFilepath);
+	size = (uint64_t)fs::file_size(path, error);
+	if(error) {
+		return false;
+	}
+
+	//Only compared with values read on the same system, the clock's epoch/resolution don't matter
+	modifiedTime = (uint64_t)fs::last_write_time(path, error).time_since_epoch().count();
+	return !error;
+}
+
+void SaveStateIndex::WriteValue(vector<uint8_t>& out, uint64_t value, int byteCount)
+{
+	for(int i = 0; i < byteCount; i++) {
+		out.push_back((uint8_t)(value >> (i * 8)));
+	}
+}
+
+bool SaveStateIndex::ReadValue(vector<uint8_t>& data, size_t& pos, uint64_t& value, int byteCount)
+{
+	if(data.size() - pos < (size_t)byteCount) {
+		return false;
+	}
+
+	value = 0;
+	for(int i = 0; i < byteCount; i++) {
+		value |= (uint64_t)data[pos++] << (i * 8);
+	}
+	return true;
+}
+
+bool SaveStateIndex::Load(string indexPath)
+{
+	_entries.clear();
+
+	//Read the whole index at once
+	ifstream file(indexPath, ios::in | ios::binary);
+	if(!file) {
+		return false;
+	}
+
+	file.seekg(0, ios::end);
+	size_t fileSize = (size_t)file.tellg();
+	file.seekg(0, ios::beg);
+
+	vector<uint8_t> data(fileSize, 0);
+	file.read((char*)data.data(), fileSize);
+	if(file.fail() || fileSize < sizeof(SaveStateIndex::Header) || memcmp(data.data(), SaveStateIndex::Header, sizeof(SaveStateIndex::Header)) != 0) {
+		return false;
+	}
+
+	size_t pos = sizeof(SaveStateIndex::Header);
+	uint64_t count;
+	if(!ReadValue(data, pos, count, 4)) {
+		return false;
+	}
+
+	for(uint64_t i = 0; i < count; i++) {
+		uint64_t nameLength;
+		if(!ReadValue(data, pos, nameLength, 4) || nameLength > data.size() - pos) {
+			break;
+		}
+		string name((char*)data.data() + pos, (size_t)nameLength);
+		pos += (size_t)nameLength;
+
+		SaveStateIndexEntry entry;
+		uint64_t frameCount, previewSize;
+		if(!ReadValue(data, pos, entry.Timestamp, 8) || !ReadValue(data, pos, frameCount, 4) || !ReadValue(data, pos, entry.StateSize, 8) || !ReadValue(data, pos, entry.ModifiedTime, 8)) {
+			break;
+		}
+		if(!ReadValue(data, pos, previewSize, 4) || previewSize > data.size() - pos) {
+			break;
+		}
+		entry.FrameCount = (uint32_t)frameCount;
+		entry.Preview.assign(data.begin() + pos, data.begin() + pos + (size_t)previewSize);
+		pos += (size_t)previewSize;
+
+		_entries[name] = std::move(entry);
+	}
+	return true;
+}
+
+bool SaveStateIndex::Save(string indexPath)
+{
+	vector<uint8_t> data(SaveStateIndex::Header, SaveStateIndex::Header + sizeof(SaveStateIndex::Header));
+	WriteValue(data, _entries.size(), 4);
+	for(auto& [name, entry] : _entries) {
+		WriteValue(data, name.size(), 4);
+		data.insert(data.end(), name.begin(), name.end());
+		WriteValue(data, entry.Timestamp, 8);
+		WriteValue(data, entry.FrameCount, 4);
+		WriteValue(data, entry.StateSize, 8);
+		WriteValue(data, entry.ModifiedTime, 8);
+		WriteValue(data, entry.Preview.size(), 4);
+		data.insert(data.end(), entry.Preview.begin(), entry.Preview.end());
+	}
+
+	//Write to a temporary file first, a failed write must not corrupt the existing index
+	string tmpPath = indexPath + ".tmp";
+	bool result = false;
+	{
+		ofstream file(tmpPath, ios::out | ios::binary);
+		if(file) {
+			file.write((char*)data.data(), data.size());
+			file.close();
+			result = !file.fail();
+		}
+	}
+
+	std::error_code error;
+	if(result) {
+		fs::rename(fs::u8path(tmpPath), fs::u8path(indexPath), error);
+	} else {
+		fs::remove(fs::u8path(tmpPath), error);
+	}
+	return result && !error;
+}
+
+SaveStateIndexEntry* SaveStateIndex::GetEntry(string stateFilename)
+{
+	auto result = _entries.find(stateFilename);
+	return result != _entries.end() ? &result->second : nullptr;
+}
+
+void SaveStateIndex::SetEntry(string stateFilename, SaveStateIndexEntry& entry)
+{
+	_entries[stateFilename] = entry;
+}
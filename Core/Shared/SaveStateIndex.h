@@ -0,0 +1,40 @@
+#pragma once
+#include "pch.h"
+
+struct SaveStateIndexEntry
+{
+	uint64_t Timestamp = 0;
+	uint32_t FrameCount = 0;
+
+	//Size and modification time of the save state file, used to detect files that were modified without updating the index
+	uint64_t StateSize = 0;
+	uint64_t ModifiedTime = 0;
+
+	//Pre-rendered preview image (PNG)
+	vector<uint8_t> Preview;
+};
+
+//Sidecar index file kept next to a game's save states (.mssidx), to display the states' previews without
+//having to read and decode each save state file.
+//Format: [header][entry count (4 bytes)], then for each entry:
+//  [filename length (4 bytes)][filename][timestamp (8 bytes)][frame count (4 bytes)][state size (8 bytes)][modified time (8 bytes)][png size (4 bytes)][png]
+class SaveStateIndex
+{
+private:
+	static constexpr uint8_t Header[4] = { 'M', 'S', 'I', 2 };
+
+	unordered_map<string, SaveStateIndexEntry> _entries;
+
+	static void WriteValue(vector<uint8_t>& out, uint64_t value, int byteCount);
+	static bool ReadValue(vector<uint8_t>& data, size_t& pos, uint64_t& value, int byteCount);
+
+public:
+	static string GetIndexPath(string stateFilepath);
+	static bool GetFileInfo(string stateFilepath, uint64_t& size, uint64_t& modifiedTime);
+
+	bool Load(string indexPath);
+	bool Save(string indexPath);
+
+	SaveStateIndexEntry* GetEntry(string stateFilename);
+	void SetEntry(string stateFilename, SaveStateIndexEntry& entry);
+};
@@ -1,15 +1,27 @@
 #include "pch.h"
+
+#if __has_include(<filesystem>)
+	#include <filesystem>
+	namespace fs = std::filesystem;
+#elif __has_include(<experimental/filesystem>)
+	#include <experimental/filesystem>
+	namespace fs = std::experimental::filesystem;
+#endif
+
 #include "Utilities/FolderUtilities.h"
 #include "Utilities/ZipWriter.h"
 #include "Utilities/ZipReader.h"
 #include "Utilities/PNGHelper.h"
+#include "Utilities/CompressionHelper.h"
 #include "Shared/SaveStateManager.h"
+#include "Shared/SaveStateIndex.h"
 #include "Shared/MessageManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Movies/MovieManager.h"
 #include "Shared/RenderedFrame.h"
 #include "Shared/EventType.h"
+#include "Shared/NotificationManager.h"
 #include "Debugger/Debugger.h"
 #include "Netplay/GameClient.h"
 #include "Shared/Video/VideoDecoder.h"
@@ -20,6 +32,16 @@ SaveStateManager::SaveStateManager(Emulator* emu)
 {
 	_emu = emu;
 	_lastIndex = 1;
+	_stopFlag = false;
+}
+
+SaveStateManager::~SaveStateManager()
+{
+	if(_saveThread) {
+		_stopFlag = true;
+		_saveSignal.Signal();
+		_saveThread->join();
+	}
 }
 
 string SaveStateManager::GetStateFilepath(int stateIndex)
@@ -30,6 +52,16 @@ string SaveStateManager::GetStateFilepath(int stateIndex)
 	return FolderUtilities::CombinePath(folder, filename);
 }
 
+bool SaveStateManager::IsSlotFilepath(string filepath)
+{
+	for(int i = 1; i <= SaveStateManager::AutoSaveStateIndex; i++) {
+		if(filepath == GetStateFilepath(i)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void SaveStateManager::SelectSaveSlot(int slotIndex)
 {
 	_lastIndex = slotIndex;
@@ -58,7 +90,22 @@ bool SaveStateManager::LoadState()
 	return LoadState(_lastIndex);
 }
 
-void SaveStateManager::GetSaveStateHeader(ostream &stream)
+void SaveStateManager::CaptureHeader(SaveStateSnapshot& snapshot)
+{
+	snapshot.ConsoleType = (uint32_t)_emu->GetConsoleType();
+
+	RomInfo romInfo = _emu->GetRomInfo();
+	snapshot.RomName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
+
+	PpuFrameInfo frame = _emu->GetPpuFrame();
+	snapshot.Width = frame.Width;
+	snapshot.Height = frame.Height;
+	snapshot.Scale = (uint32_t)(_emu->GetVideoDecoder()->GetLastFrameScale() * 100);
+	snapshot.FrameBuffer.assign(frame.FrameBuffer, frame.FrameBuffer + frame.FrameBufferSize);
+	snapshot.FrameCount = frame.FrameCount;
+}
+
+void SaveStateManager::WriteHeader(ostream& stream, SaveStateSnapshot& snapshot)
 {
 	uint32_t emuVersion = _emu->GetSettings()->GetVersion();
 	uint32_t formatVersion = SaveStateManager::FileFormatVersion;
@@ -66,14 +113,31 @@ void SaveStateManager::GetSaveStateHeader(ostream &stream)
 	WriteValue(stream, emuVersion);
 	WriteValue(stream, formatVersion);
 
-	WriteValue(stream, (uint32_t)_emu->GetConsoleType());
+	WriteValue(stream, snapshot.ConsoleType);
 
-	SaveVideoData(stream);
+	//Video data (compressed frame buffer)
+	uint32_t frameBufferSize = (uint32_t)snapshot.FrameBuffer.size();
+	WriteValue(stream, frameBufferSize);
+	WriteValue(stream, snapshot.Width);
+	WriteValue(stream, snapshot.Height);
+	WriteValue(stream, snapshot.Scale);
 
-	RomInfo romInfo = _emu->GetRomInfo();
-	string romName = FolderUtilities::GetFilename(romInfo.RomFile.GetFileName(), true);
-	WriteValue(stream, (uint32_t)romName.size());
-	stream.write(romName.c_str(), romName.size());
+	unsigned long compressedSize = compressBound(frameBufferSize);
+	vector<uint8_t> compressedData(compressedSize, 0);
+	compress2(compressedData.data(), &compressedSize, snapshot.FrameBuffer.data(), frameBufferSize, MZ_DEFAULT_LEVEL);
+
+	WriteValue(stream, (uint32_t)compressedSize);
+	stream.write((char*)compressedData.data(), (uint32_t)compressedSize);
+
+	WriteValue(stream, (uint32_t)snapshot.RomName.size());
+	stream.write(snapshot.RomName.c_str(), snapshot.RomName.size());
+}
+
+void SaveStateManager::GetSaveStateHeader(ostream &stream)
+{
+	SaveStateSnapshot snapshot;
+	CaptureHeader(snapshot);
+	WriteHeader(stream, snapshot);
 }
 
 void SaveStateManager::SaveState(ostream &stream)
@@ -84,48 +148,330 @@ void SaveStateManager::SaveState(ostream &stream)
 
 bool SaveStateManager::SaveState(string filepath, bool showSuccessMessage)
 {
-	ofstream file(filepath, ios::out | ios::binary);
+	//Written on the caller's thread, the result indicates whether the file was written to the disk
+	//Pending saves are written first, they are older than this state and may be for the same file
+	WaitForPendingSaves();
+
+	unique_ptr<SaveStateSnapshot> snapshot = CaptureSnapshot(filepath, showSuccessMessage ? "SaveStateSavedFile" : "", filepath);
+	return snapshot && WriteSaveState(*snapshot);
+}
 
-	if(file) {
+void SaveStateManager::SaveState(int stateIndex, bool displayMessage)
+{
+	string filepath = SaveStateManager::GetStateFilepath(stateIndex);
+	QueueSaveState(filepath, displayMessage ? "SaveStateSaved" : "", std::to_string(stateIndex), stateIndex == SaveStateManager::AutoSaveStateIndex);
+}
+
+unique_ptr<SaveStateSnapshot> SaveStateManager::CaptureSnapshot(string filepath, string message, string messageParam)
+{
+	//Only capture the data while the emulation is paused, compression and file I/O are done separately
+	unique_ptr<SaveStateSnapshot> snapshot(new SaveStateSnapshot());
+	snapshot->Filepath = filepath;
+	snapshot->Message = message;
+	snapshot->MessageParam = messageParam;
+	snapshot->Timestamp = (uint64_t)std::time(nullptr);
+	snapshot->IsSlot = IsSlotFilepath(filepath);
+	{
+		auto lock = _emu->AcquireLock();
+		if(!_emu->IsRunning()) {
+			return nullptr;
+		}
+
+		CaptureHeader(*snapshot);
+		if(snapshot->IsSlot) {
+			PreparePreview(*snapshot);
+		}
+		stringstream state;
+		_emu->Serialize(state, false, 0);
+		snapshot->State = state.str();
+		_emu->ProcessEvent(EventType::StateSaved);
+	}
+	return snapshot;
+}
+
+void SaveStateManager::QueueSaveState(string filepath, string message, string messageParam, bool isAutoSave)
+{
+	if(!_emu->IsEmulationThread()) {
+		//Saves are never dropped, other threads wait for the save state thread to catch up instead
+		//(the emulation thread never waits, it is the only one that queues auto saves)
+		WaitForQueueSpace();
+	}
+
+	unique_ptr<SaveStateSnapshot> snapshot = CaptureSnapshot(filepath, message, messageParam);
+	if(!snapshot) {
+		return;
+	}
+	snapshot->IsAutoSave = isAutoSave;
+
+	{
+		auto lock = _saveLock.AcquireSafe();
+		for(auto it = _pendingSaves.begin(); it != _pendingSaves.end(); it++) {
+			if((*it)->Filepath == filepath) {
+				//A newer state for the same file replaces the one that has not been written yet
+				_pendingSaves.erase(it);
+				break;
+			}
+		}
+
+		if(_pendingSaves.size() >= SaveStateManager::MaxPendingSaves) {
+			//Only auto saves can be skipped - states saved by the user are queued even if the queue is over its limit
+			auto autoSave = std::find_if(_pendingSaves.begin(), _pendingSaves.end(), [](unique_ptr<SaveStateSnapshot>& pending) { return pending->IsAutoSave; });
+			if(autoSave != _pendingSaves.end()) {
+				MessageManager::Log("[Save States] Too many save states waiting to be written, skipped auto save: " + (*autoSave)->Filepath);
+				_pendingSaves.erase(autoSave);
+			} else if(snapshot->IsAutoSave) {
+				MessageManager::Log("[Save States] Too many save states waiting to be written, skipped auto save: " + filepath);
+				return;
+			}
+		}
+
+		_pendingSaves.push_back(std::move(snapshot));
+		if(!_saveThread) {
+			_saveThread.reset(new thread(&SaveStateManager::ProcessSaveStates, this));
+		}
+	}
+	_saveSignal.Signal();
+}
+
+void SaveStateManager::WaitForQueueSpace()
+{
+	while(true) {
 		{
-			auto lock = _emu->AcquireLock();
-			SaveState(file);
-			_emu->ProcessEvent(EventType::StateSaved);
+			auto lock = _saveLock.AcquireSafe();
+			if(_pendingSaves.size() < SaveStateManager::MaxPendingSaves) {
+				return;
+			}
 		}
-		file.close();
+		_saveDoneSignal.Wait(50);
+	}
+}
 
-		if(showSuccessMessage) {
-			MessageManager::DisplayMessage("SaveStates", "SaveStateSavedFile", filepath);
+bool SaveStateManager::WriteSaveState(SaveStateSnapshot& snapshot)
+{
+	//Write to a temporary file first, to avoid corrupting the existing save state if the write fails
+	string tmpFilepath = snapshot.Filepath + ".tmp";
+	bool result = false;
+	{
+		ofstream file(tmpFilepath, ios::out | ios::binary);
+		if(file) {
+			WriteHeader(file, snapshot);
+
+			//Same format as Serializer::SaveTo: compression flag, followed by the compressed data's sizes and content
+			//(the first byte of the uncompressed state is its compression flag)
+			vector<uint8_t> compressedState;
+			CompressionHelper::Compress(snapshot.State.substr(1), 1, compressedState);
+			file.put(1);
+			file.write((char*)compressedState.data(), compressedState.size());
+			file.close();
+			result = !file.fail();
 		}
-		return true;
 	}
-	return false;
+
+	std::error_code error;
+	if(result) {
+		fs::rename(fs::u8path(tmpFilepath), fs::u8path(snapshot.Filepath), error);
+	} else {
+		fs::remove(fs::u8path(tmpFilepath), error);
+	}
+
+	if(!result || error) {
+		MessageManager::DisplayMessage("SaveStates", "CouldNotWriteToFile", snapshot.Filepath);
+		return false;
+	}
+
+	if(snapshot.IsSlot) {
+		UpdateIndex(snapshot);
+	}
+
+	//MessageManager can be used from any thread
+	if(!snapshot.Message.empty()) {
+		MessageManager::DisplayMessage("SaveStates", snapshot.Message, snapshot.MessageParam);
+	}
+
+	{
+		//This can run on the save state thread - some listeners (e.g the netplay server's connection list) are only
+		//safe to use while the emulation thread is paused, like when the notification was sent by the emulation thread
+		auto lock = _emu->AcquireLock();
+		_emu->GetNotificationManager()->SendNotification(ConsoleNotificationType::StateSaved);
+	}
+	return true;
 }
 
-void SaveStateManager::SaveState(int stateIndex, bool displayMessage)
+void SaveStateManager::ProcessSaveStates()
 {
-	string filepath = SaveStateManager::GetStateFilepath(stateIndex);
-	if(SaveState(filepath, false)) {
-		if(displayMessage) {
-			MessageManager::DisplayMessage("SaveStates", "SaveStateSaved", std::to_string(stateIndex));
+	while(true) {
+		//The state being written is kept in _currentSave until the file is written (see GetPendingPreview)
+		SaveStateSnapshot* snapshot = nullptr;
+		{
+			auto lock = _saveLock.AcquireSafe();
+			if(!_pendingSaves.empty()) {
+				_currentSave = std::move(_pendingSaves.front());
+				_pendingSaves.pop_front();
+				snapshot = _currentSave.get();
+			}
+		}
+
+		if(!snapshot) {
+			if(_stopFlag) {
+				break;
+			}
+			_saveSignal.Wait();
+			continue;
+		}
+
+		WriteSaveState(*snapshot);
+
+		{
+			auto lock = _saveLock.AcquireSafe();
+			_currentSave.reset();
 		}
+		_saveDoneSignal.Signal();
 	}
 }
 
-void SaveStateManager::SaveVideoData(ostream& stream)
+void SaveStateManager::WaitForPendingSaves()
 {
-	PpuFrameInfo frame = _emu->GetPpuFrame();
-	WriteValue(stream, frame.FrameBufferSize);
-	WriteValue(stream, frame.Width);
-	WriteValue(stream, frame.Height);
-	WriteValue(stream, (uint32_t)(_emu->GetVideoDecoder()->GetLastFrameScale() * 100));
+	while(true) {
+		{
+			auto lock = _saveLock.AcquireSafe();
+			if(_pendingSaves.empty() && !_currentSave) {
+				return;
+			}
+		}
+		_saveDoneSignal.Wait(50);
+	}
+}
 
-	unsigned long compressedSize = compressBound(frame.FrameBufferSize);
-	vector<uint8_t> compressedData(compressedSize, 0);
-	compress2(compressedData.data(), &compressedSize, (const unsigned char*)frame.FrameBuffer, frame.FrameBufferSize, MZ_DEFAULT_LEVEL);
+SaveStateIndex* SaveStateManager::GetIndex(string indexPath)
+{
+	//Index files are only read from the disk once, they are kept up to date in memory as states are saved
+	unique_ptr<SaveStateIndex>& index = _indexes[indexPath];
+	if(!index) {
+		index.reset(new SaveStateIndex());
+		index->Load(indexPath);
+	}
+	return index.get();
+}
 
-	WriteValue(stream, (uint32_t)compressedSize);
-	stream.write((char*)compressedData.data(), (uint32_t)compressedSize);
+void SaveStateManager::UpdateIndex(SaveStateSnapshot& snapshot)
+{
+	SaveStateIndexEntry entry;
+	if(!SaveStateIndex::GetFileInfo(snapshot.Filepath, entry.StateSize, entry.ModifiedTime)) {
+		return;
+	}
+	entry.Timestamp = snapshot.Timestamp;
+	entry.FrameCount = snapshot.FrameCount;
+
+	string preview = EncodePreview(snapshot);
+	entry.Preview.assign(preview.begin(), preview.end());
+
+	string indexPath = SaveStateIndex::GetIndexPath(snapshot.Filepath);
+	auto lock = _indexLock.AcquireSafe();
+	SaveStateIndex* index = GetIndex(indexPath);
+	index->SetEntry(FolderUtilities::GetFilename(snapshot.Filepath, true), entry);
+	if(!index->Save(indexPath)) {
+		MessageManager::Log("[Save States] Could not write index file: " + indexPath);
+	}
+}
+
+bool SaveStateManager::GetPendingPreview(string saveStatePath, uint8_t* pngData, int32_t& size)
+{
+	vector<uint8_t> frameBuffer;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	{
+		auto lock = _saveLock.AcquireSafe();
+
+		//Queued states are newer than the one being written
+		SaveStateSnapshot* snapshot = _currentSave && _currentSave->Filepath == saveStatePath ? _currentSave.get() : nullptr;
+		for(unique_ptr<SaveStateSnapshot>& pending : _pendingSaves) {
+			if(pending->Filepath == saveStatePath) {
+				snapshot = pending.get();
+			}
+		}
+
+		if(!snapshot) {
+			return false;
+		}
+		frameBuffer = snapshot->FrameBuffer;
+		width = snapshot->Width;
+		height = snapshot->Height;
+	}
+
+	string preview = EncodePreview(frameBuffer.data(), width, height);
+	if(preview.size() > SaveStateManager::MaxPreviewSize) {
+		return false;
+	}
+
+	memcpy(pngData, preview.data(), preview.size());
+	size = (int32_t)preview.size();
+	return true;
+}
+
+bool SaveStateManager::GetIndexedPreview(string saveStatePath, uint8_t* pngData, int32_t& size)
+{
+	uint64_t stateSize, modifiedTime;
+	if(!IsSlotFilepath(saveStatePath) || !SaveStateIndex::GetFileInfo(saveStatePath, stateSize, modifiedTime)) {
+		return false;
+	}
+
+	auto lock = _indexLock.AcquireSafe();
+	SaveStateIndexEntry* entry = GetIndex(SaveStateIndex::GetIndexPath(saveStatePath))->GetEntry(FolderUtilities::GetFilename(saveStatePath, true));
+	if(!entry || entry->StateSize != stateSize || entry->ModifiedTime != modifiedTime || entry->Preview.empty()) {
+		//Not in the index (e.g older save state), or the file was replaced since the index was updated
+		return false;
+	} else if(entry->Preview.size() > SaveStateManager::MaxPreviewSize) {
+		//Invalid/corrupted index, the preview would not fit in the caller's buffer
+		return false;
+	}
+
+	memcpy(pngData, entry->Preview.data(), entry->Preview.size());
+	size = (int32_t)entry->Preview.size();
+	return true;
+}
+
+void SaveStateManager::PreparePreview(SaveStateSnapshot& snapshot)
+{
+	//Called while the emulation is paused: the filter reads the current console's settings/state
+	FrameInfo baseFrameInfo;
+	baseFrameInfo.Width = snapshot.Width;
+	baseFrameInfo.Height = snapshot.Height;
+
+	//The filter can alter the buffer it is given (e.g NES PAL borders), use a copy
+	snapshot.PreviewFrameBuffer = snapshot.FrameBuffer;
+	snapshot.PreviewFilter.reset(_emu->GetVideoFilter(true));
+	snapshot.PreviewFilter->SetBaseFrameInfo(baseFrameInfo);
+	FrameInfo frameInfo = snapshot.PreviewFilter->PrepareFrame((uint16_t*)snapshot.PreviewFrameBuffer.data(), 0, 0, nullptr);
+	snapshot.PreviewWidth = frameInfo.Width;
+	snapshot.PreviewHeight = frameInfo.Height;
+}
+
+string SaveStateManager::EncodePreview(SaveStateSnapshot& snapshot)
+{
+	if(!snapshot.PreviewFilter) {
+		return "";
+	}
+
+	snapshot.PreviewFilter->ApplyPreparedFrame();
+
+	std::stringstream pngStream;
+	PNGHelper::WritePNG(pngStream, snapshot.PreviewFilter->GetOutputBuffer(), snapshot.PreviewWidth, snapshot.PreviewHeight);
+	return pngStream.str();
+}
+
+string SaveStateManager::EncodePreview(uint8_t* frameBuffer, uint32_t width, uint32_t height)
+{
+	FrameInfo baseFrameInfo;
+	baseFrameInfo.Width = width;
+	baseFrameInfo.Height = height;
+
+	unique_ptr<BaseVideoFilter> filter(_emu->GetVideoFilter(true));
+	filter->SetBaseFrameInfo(baseFrameInfo);
+	FrameInfo frameInfo = filter->SendFrame((uint16_t*)frameBuffer, 0, 0, nullptr);
+
+	std::stringstream pngStream;
+	PNGHelper::WritePNG(pngStream, filter->GetOutputBuffer(), frameInfo.Width, frameInfo.Height);
+	return pngStream.str();
 }
 
 bool SaveStateManager::GetVideoData(vector<uint8_t>& out, RenderedFrame& frame, istream& stream)
@@ -224,6 +570,8 @@ bool SaveStateManager::LoadState(istream &stream)
 
 bool SaveStateManager::LoadState(string filepath, bool showSuccessMessage)
 {
+	WaitForPendingSaves();
+
 	ifstream file(filepath, ios::in | ios::binary);
 	bool result = false;
 
@@ -320,6 +668,12 @@ void SaveStateManager::LoadRecentGame(string filename, bool resetGame)
 
 int32_t SaveStateManager::GetSaveStatePreview(string saveStatePath, uint8_t* pngData)
 {
+	//Never waits for the save state thread, states that are not written yet are displayed from their snapshot
+	int32_t size;
+	if(GetPendingPreview(saveStatePath, pngData, size) || GetIndexedPreview(saveStatePath, pngData, size)) {
+		return size;
+	}
+
 	ifstream stream(saveStatePath, ios::binary);
 
 	if(!stream) {
@@ -346,18 +700,7 @@ int32_t SaveStateManager::GetSaveStatePreview(string saveStatePath, uint8_t* png
 		vector<uint8_t> frameData;
 		RenderedFrame frame;
 		if(GetVideoData(frameData, frame, stream)) {
-			FrameInfo baseFrameInfo;
-			baseFrameInfo.Width = frame.Width;
-			baseFrameInfo.Height = frame.Height;
-			
-			unique_ptr<BaseVideoFilter> filter(_emu->GetVideoFilter(true));
-			filter->SetBaseFrameInfo(baseFrameInfo);
-			FrameInfo frameInfo = filter->SendFrame((uint16_t*)frameData.data(), 0, 0, nullptr);
-
-			std::stringstream pngStream;
-			PNGHelper::WritePNG(pngStream, filter->GetOutputBuffer(), frameInfo.Width, frameInfo.Height);
-
-			string data = pngStream.str();
+			string data = EncodePreview(frameData.data(), frame.Width, frame.Height);
 			memcpy(pngData, data.c_str(), data.size());
 
 			return (int32_t)frameData.size();
@@ -1,19 +1,90 @@
 #pragma once
 #include "pch.h"
+#include <deque>
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Emulator;
+class SaveStateIndex;
+class BaseVideoFilter;
 struct RenderedFrame;
 
+//Data needed to write a save state file, captured while the emulation is paused
+struct SaveStateSnapshot
+{
+	uint32_t ConsoleType = 0;
+	string RomName;
+
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	uint32_t Scale = 0;
+	vector<uint8_t> FrameBuffer;
+
+	//Filter used to render the index file's preview, set up with the settings of the console that was saved.
+	//The filter is applied to its own copy of the frame buffer and encoded to PNG by the thread that writes the file.
+	unique_ptr<BaseVideoFilter> PreviewFilter;
+	vector<uint8_t> PreviewFrameBuffer;
+	uint32_t PreviewWidth = 0;
+	uint32_t PreviewHeight = 0;
+
+	uint32_t FrameCount = 0;
+	uint64_t Timestamp = 0;
+
+	//Uncompressed state, compressed by the save state thread
+	string State;
+
+	string Filepath;
+	string Message;
+	string MessageParam;
+
+	//Only the save state slots (see GetStateFilepath) are added to the game's index file
+	bool IsSlot = false;
+
+	//Auto saves are the only states that can be skipped when too many states are waiting to be written
+	bool IsAutoSave = false;
+};
+
 class SaveStateManager
 {
 private:
 	static constexpr uint32_t MaxIndex = 10;
+	static constexpr uint32_t MaxPendingSaves = 3;
+
+	//Size of the buffer the UI provides to GetSaveStatePreview
+	static constexpr uint32_t MaxPreviewSize = 512 * 478 * 4;
 
 	atomic<uint32_t> _lastIndex;
 	Emulator* _emu;
 
+	SimpleLock _saveLock;
+	std::deque<unique_ptr<SaveStateSnapshot>> _pendingSaves;
+	unique_ptr<SaveStateSnapshot> _currentSave;
+	unique_ptr<thread> _saveThread;
+	atomic<bool> _stopFlag;
+	AutoResetEvent _saveSignal;
+	AutoResetEvent _saveDoneSignal;
+
+	//Save state index files (previews) loaded so far, by path
+	SimpleLock _indexLock;
+	unordered_map<string, unique_ptr<SaveStateIndex>> _indexes;
+
 	string GetStateFilepath(int stateIndex);
-	void SaveVideoData(ostream& stream);
+	bool IsSlotFilepath(string filepath);
+	void CaptureHeader(SaveStateSnapshot& snapshot);
+	void WriteHeader(ostream& stream, SaveStateSnapshot& snapshot);
+	unique_ptr<SaveStateSnapshot> CaptureSnapshot(string filepath, string message, string messageParam);
+	void QueueSaveState(string filepath, string message, string messageParam, bool isAutoSave);
+	void WaitForQueueSpace();
+	bool WriteSaveState(SaveStateSnapshot& snapshot);
+	void ProcessSaveStates();
+
+	SaveStateIndex* GetIndex(string indexPath);
+	void UpdateIndex(SaveStateSnapshot& snapshot);
+	bool GetPendingPreview(string saveStatePath, uint8_t* pngData, int32_t& size);
+	bool GetIndexedPreview(string saveStatePath, uint8_t* pngData, int32_t& size);
+	void PreparePreview(SaveStateSnapshot& snapshot);
+	string EncodePreview(SaveStateSnapshot& snapshot);
+	string EncodePreview(uint8_t* frameBuffer, uint32_t width, uint32_t height);
 	bool GetVideoData(vector<uint8_t>& out, RenderedFrame& frame, istream& stream);
 
 	void WriteValue(ostream& stream, uint32_t value);
@@ -25,6 +96,11 @@ public:
 	static constexpr uint32_t AutoSaveStateIndex = 11;
 
 	SaveStateManager(Emulator* emu);
+	~SaveStateManager();
+
+	//Waits until all of the save states queued by SaveState(stateIndex) are written to the disk
+	//Must not be called while holding the emulator's lock (the save state thread needs it to send StateSaved)
+	void WaitForPendingSaves();
 
 	void SaveState();
 	bool LoadState();
@@ -32,7 +108,9 @@ public:
 	void GetSaveStateHeader(ostream & stream);
 
 	void SaveState(ostream &stream);
+	//Saves synchronously, returns false if the file could not be written
 	bool SaveState(string filepath, bool showSuccessMessage = true);
+	//Queued, written to the disk by the save state thread (waits when too many states are queued, unless called by the emulation thread)
 	void SaveState(int stateIndex, bool displayMessage = true);
 	bool LoadState(istream &stream);
 	bool LoadState(string filepath, bool showSuccessMessage = true);
@@ -396,6 +396,8 @@ struct GameConfig
 
 	bool OverrideOverscan = false;
 	OverscanDimensions Overscan = {};
+
+	bool SkipIdleLoops = false;
 };
 
 struct GameboyConfig
@@ -550,6 +552,7 @@ struct SnesConfig
 	bool HideSprites = false;
 	bool DisableFrameSkipping = false;
 	bool ForceFixedResolution = false;
+	bool EnableThreadedRendering = false;
 
 	OverscanDimensions Overscan = {};
 
@@ -853,6 +856,7 @@ struct PreferencesConfig
 	HudDisplaySize HudSize = HudDisplaySize::Fixed;
 
 	uint32_t AutoSaveStateDelay = 5;
+	uint32_t AutoSaveBatteryDelay = 30;
 	uint32_t RewindBufferSize = 300;
 
 	const char* SaveFolderOverride = nullptr;
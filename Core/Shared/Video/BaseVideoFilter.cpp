@@ -90,6 +90,14 @@ FrameInfo BaseVideoFilter::GetFrameInfo(uint16_t* ppuOutputBuffer, bool enableOv
 }
 
 FrameInfo BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan)
+{
+	auto lock = _frameLock.AcquireSafe();
+	FrameInfo frameInfo = PrepareFrame(ppuOutputBuffer, frameNumber, videoPhase, frameData, enableOverscan);
+	ApplyPreparedFrame();
+	return frameInfo;
+}
+
+FrameInfo BaseVideoFilter::PrepareFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan)
 {
 	auto lock = _frameLock.AcquireSafe();
 	_overscan = enableOverscan ? _emu->GetSettings()->GetOverscan() : OverscanDimensions{};
@@ -101,11 +109,16 @@ FrameInfo BaseVideoFilter::SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNu
 	FrameInfo frameInfo = GetFrameInfo();
 	_frameInfo = frameInfo;
 	UpdateBufferSize();
-	ApplyFilter(ppuOutputBuffer);
-	_ppuOutputBuffer = nullptr;
 	return frameInfo;
 }
 
+void BaseVideoFilter::ApplyPreparedFrame()
+{
+	auto lock = _frameLock.AcquireSafe();
+	ApplyFilter(_ppuOutputBuffer);
+	_ppuOutputBuffer = nullptr;
+}
+
 uint32_t* BaseVideoFilter::GetOutputBuffer()
 {
 	return _outputBuffer;
@@ -48,6 +48,11 @@ public:
 
 	uint32_t* GetOutputBuffer();
 	FrameInfo SendFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan = true);
+
+	//Same as SendFrame, in 2 steps: PrepareFrame reads the settings and console state the filter needs (e.g while the emulation is paused),
+	//ApplyPreparedFrame runs the filter itself and can be called later, on another thread (the buffer must still be valid)
+	FrameInfo PrepareFrame(uint16_t *ppuOutputBuffer, uint32_t frameNumber, uint32_t videoPhase, void* frameData, bool enableOverscan = true);
+	void ApplyPreparedFrame();
 	void TakeScreenshot(string romName, VideoFilterType filterType);
 	void TakeScreenshot(VideoFilterType filterType, string filename, std::stringstream *stream = nullptr);
 
@@ -6,6 +6,8 @@
 #include "Shared/Emulator.h"
 #include "Shared/RewindManager.h"
 #include "Shared/EmuSettings.h"
+#include "Netplay/GameClient.h"
+#include "Netplay/RollbackManager.h"
 
 void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 {
@@ -87,8 +89,10 @@ void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 		hud->DrawLine(130 + i*2, 60 + 50 - duration*2, 130 + i*2 + 2, 60 + 50 - nextDuration*2, lineColor, 1, startFrame);
 	}
 
-	hud->DrawRectangle(8, 60, 115, 34, 0x40000000, true, 1, startFrame);
-	hud->DrawRectangle(8, 60, 115, 34, 0xFFFFFF, false, 1, startFrame);
+	bool showIdleLoopStats = emu->GetSettings()->GetGameConfig().SkipIdleLoops;
+	int miscHeight = showIdleLoopStats ? 43 : 34;
+	hud->DrawRectangle(8, 60, 115, miscHeight, 0x40000000, true, 1, startFrame);
+	hud->DrawRectangle(8, 60, 115, miscHeight, 0xFFFFFF, false, 1, startFrame);
 
 	hud->DrawString(10, 62, "Misc. Stats", 0xFFFFFF, 0xFF000000, 1, startFrame);
 
@@ -103,4 +107,35 @@ void DebugStats::DisplayStats(Emulator *emu, double lastFrameTime)
 		ss << "   Per min.: " << std::fixed << std::setprecision(2) << (memUsage * 60 * 60 / rewindStats.HistoryDuration) << " MB";
 		hud->DrawString(9, 82, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
 	}
+
+	if(showIdleLoopStats) {
+		//Percentage of the CPU cycles that were run without decoding instructions during the last frame
+		IConsole* console = emu->GetConsoleUnsafe();
+		IdleLoopStats idleStats = console ? console->GetIdleLoopStats() : IdleLoopStats {};
+		uint64_t cpuCycles = idleStats.CpuCycles - _prevIdleLoopStats.CpuCycles;
+		uint64_t skippedCycles = idleStats.SkippedCycles - _prevIdleLoopStats.SkippedCycles;
+		_prevIdleLoopStats = idleStats;
+
+		ss = std::stringstream();
+		ss << "Idle skip: " << std::fixed << std::setprecision(2) << (cpuCycles > 0 && skippedCycles <= cpuCycles ? skippedCycles * 100.0 / cpuCycles : 0.0) << "%";
+		hud->DrawString(10, 91, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	}
+
+	shared_ptr<RollbackManager> rollback = emu->GetGameClient()->GetRollbackManager();
+	if(rollback) {
+		RollbackStats rollbackStats = rollback->GetStats();
+		hud->DrawRectangle(132, 95, 115, 43, 0x40000000, true, 1, startFrame);
+		hud->DrawRectangle(132, 95, 115, 43, 0xFFFFFF, false, 1, startFrame);
+		hud->DrawString(134, 97, "Netplay Rollback", 0xFFFFFF, 0xFF000000, 1, startFrame);
+		hud->DrawString(134, 108, "Count: " + std::to_string(rollbackStats.RollbackCount) + " (" + std::to_string(rollbackStats.StallCount) + " stalls)", 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		uint32_t count = std::max<uint32_t>(rollbackStats.RollbackCount, 1);
+		ss = std::stringstream();
+		ss << "Depth: " << std::fixed << std::setprecision(1) << ((double)rollbackStats.TotalDepth / count) << " avg, " << rollbackStats.MaxDepth << " max";
+		hud->DrawString(134, 117, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+
+		ss = std::stringstream();
+		ss << "Time: " << std::fixed << std::setprecision(2) << (rollbackStats.TotalTime / count) << "/" << rollbackStats.MaxTime << " ms";
+		hud->DrawString(134, 126, ss.str(), 0xFFFFFF, 0xFF000000, 1, startFrame);
+	}
 }
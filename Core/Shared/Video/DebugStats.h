@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include "Shared/Interfaces/IConsole.h"
 
 class Emulator;
 
@@ -10,6 +11,7 @@ private:
 	uint32_t _frameDurationIndex = 0;
 	double _lastFrameMin = 9999;
 	double _lastFrameMax = 0;
+	IdleLoopStats _prevIdleLoopStats = {};
 
 public:
 	void DisplayStats(Emulator *emu, double lastFrameTime);
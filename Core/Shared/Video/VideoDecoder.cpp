@@ -14,6 +14,7 @@
 #include "Shared/Video/DebugHud.h"
 #include "Shared/InputHud.h"
 #include "Shared/RenderedFrame.h"
+#include "Shared/PerformanceTracer.h"
 #include "Shared/Video/SystemHud.h"
 #include "SNES/CartTypes.h"
 
@@ -94,6 +95,8 @@ void VideoDecoder::UpdateVideoFilter()
 
 void VideoDecoder::DecodeFrame(bool forRewind)
 {
+	PipelineTraceScope trace(_emu->GetPerformanceTracer(), PipelineStage::Filter, _frame.FrameNumber);
+
 	UpdateVideoFilter();
 
 	bool isAudioPlayer = _emu->GetAudioPlayerHud() != nullptr;
@@ -122,8 +125,10 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 		}
 	}
 
+	trace.Next(PipelineStage::Hud);
 	_emu->GetDebugHud()->Draw(outputBuffer, frameSize, overscan, _frame.FrameNumber, _videoFilter->GetScaleFactor());
 
+	trace.Next(PipelineStage::Scale);
 	if(_scaleFilter && !isAudioPlayer) {
 		outputBuffer = _scaleFilter->ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height);
 		frameSize = _scaleFilter->GetFrameInfo(frameSize);
@@ -133,6 +138,7 @@ void VideoDecoder::DecodeFrame(bool forRewind)
 		uint8_t scale = std::max<uint8_t>(1, (uint8_t)((double)frameSize.Height / (_frame.Height - overscan.Top - overscan.Bottom)));
 		ScanlineFilter::ApplyFilter(outputBuffer, frameSize.Width, frameSize.Height, _emu->GetSettings()->GetVideoConfig().ScanlineIntensity, scale);
 	}
+	trace.End();
 
 	RenderedFrame convertedFrame((void*)outputBuffer, frameSize.Width, frameSize.Height, _frame.Scale, _frame.FrameNumber, _frame.InputData);
 
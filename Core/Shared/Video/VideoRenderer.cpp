@@ -8,6 +8,7 @@
 #include "Shared/Video/SystemHud.h"
 #include "Shared/InputHud.h"
 #include "Shared/MessageManager.h"
+#include "Shared/PerformanceTracer.h"
 #include "Utilities/Video/IVideoRecorder.h"
 #include "Utilities/Video/AviRecorder.h"
 #include "Utilities/Video/GifRecorder.h"
@@ -91,6 +92,7 @@ void VideoRenderer::RenderThread()
 				frame = _lastFrame;
 			}
 
+			PipelineTraceScope trace(_emu->GetPerformanceTracer(), PipelineStage::Hud, frame.FrameNumber);
 			_inputHud->DrawControllers(size, frame.InputData);
 			{
 				auto lock = _hudLock.AcquireSafe();
@@ -102,6 +104,7 @@ void VideoRenderer::RenderThread()
 
 			if(forceRender || _needRedraw || _emuHudSurface.IsDirty || _scriptHudSurface.IsDirty) {
 				_needRedraw = false;
+				trace.Next(PipelineStage::Present);
 				_renderer->Render(_emuHudSurface, _scriptHudSurface);
 			}
 		}
@@ -285,6 +288,7 @@ void VideoRenderer::StopRecording()
 	shared_ptr<IVideoRecorder> recorder = _recorder.lock();
 	if(recorder) {
 		MessageManager::DisplayMessage("VideoRecorder", "VideoRecorderStopped", recorder->GetOutputFile());
+		MessageManager::Log("[Video Recorder] " + recorder->GetStats().ToString());
 	}
 	_aviRecorderSurface.UpdateSize(0, 0);
 	_recorder.reset();
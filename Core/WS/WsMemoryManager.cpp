@@ -52,6 +52,8 @@ void WsMemoryManager::RefreshMappings()
 	if(!_state.BootRomDisabled) {
 		Map(0x100000 - _bootRomSize, 0xFFFFF, MemoryType::WsBootRom, 0, true);
 	}
+
+	RefreshBusTimings();
 }
 
 void WsMemoryManager::Map(uint32_t start, uint32_t end, MemoryType type, uint32_t offset, bool readonly)
@@ -346,21 +348,25 @@ void WsMemoryManager::InternalWritePort(uint16_t port, uint8_t value, bool isWor
 	}
 }
 
-bool WsMemoryManager::IsWordBus(uint32_t addr)
+void WsMemoryManager::RefreshBusTimings()
 {
-	switch(addr >> 16) {
-		case 0: return true;
-		case 1: return false;
-		default: return _state.CartWordBus;
-	}
-}
+	for(int i = 0; i < 16; i++) {
+		switch(i) {
+			case 0:
+				_wordBus[i] = true;
+				_waitStates[i] = 1;
+				break;
 
-uint8_t WsMemoryManager::GetWaitStates(uint32_t addr)
-{
-	switch(addr >> 16) {
-		case 0: return 1;
-		case 1: return 1 + (uint8_t)_state.SlowSram;
-		default: return 1 + (uint8_t)_state.SlowRom;
+			case 1:
+				_wordBus[i] = false;
+				_waitStates[i] = 1 + (uint8_t)_state.SlowSram;
+				break;
+
+			default:
+				_wordBus[i] = _state.CartWordBus;
+				_waitStates[i] = 1 + (uint8_t)_state.SlowRom;
+				break;
+		}
 	}
 }
 
@@ -43,6 +43,10 @@ private:
 	uint8_t* _reads[256] = {};
 	uint8_t* _writes[256] = {};
 
+	//Bus width/wait states for each 64kb bank, updated when the mappings change
+	bool _wordBus[16] = {};
+	uint8_t _waitStates[16] = {};
+
 	bool IsWordPort(uint16_t port);
 	uint8_t GetPortWaitStates(uint16_t port);
 	bool IsUnmappedPort(uint16_t port);
@@ -54,6 +58,7 @@ public:
 	WsMemoryManagerState& GetState() { return _state; }
 
 	void RefreshMappings();
+	void RefreshBusTimings();
 
 	void Map(uint32_t start, uint32_t end, MemoryType type, uint32_t offset, bool readonly);
 	void Unmap(uint32_t start, uint32_t end);
@@ -147,8 +152,8 @@ public:
 
 	template<typename T> T DebugReadPort(uint16_t port);
 
-	bool IsWordBus(uint32_t addr);
-	uint8_t GetWaitStates(uint32_t addr);
+	__forceinline bool IsWordBus(uint32_t addr) { return _wordBus[(addr >> 16) & 0x0F]; }
+	__forceinline uint8_t GetWaitStates(uint32_t addr) { return _waitStates[(addr >> 16) & 0x0F]; }
 
 	void SetIrqSource(WsIrqSource src);
 	void ClearIrqSource(WsIrqSource src);
@@ -152,6 +152,11 @@ void WsPpu::DrawSprites()
 			}
 
 			uint16_t tileDataAddr = (bank0Addr + tileIndex * tileSize + tileRow * tileBytesPerRow);
+			uint64_t tilePixels = GetTileRowPixels<mode>(tileDataAddr);
+			if(hMirror) {
+				tilePixels = PlanarTileDecoder::Mirror(tilePixels);
+			}
+
 			for(int j = 0; j < 8; j++) {
 				uint8_t x = sprX + j;
 
@@ -166,12 +171,7 @@ void WsPpu::DrawSprites()
 					continue;
 				}
 
-				int tileColumn = j;
-				if(hMirror) {
-					tileColumn = 7 - tileColumn;
-				}
-
-				uint8_t color = GetPixelColor<mode>(tileDataAddr, tileColumn);
+				uint8_t color = PlanarTileDecoder::GetPixel(tilePixels, j);
 				if(color != 0 || (!(palette & 0x04) && mode <= WsVideoMode::Color2bpp)) {
 					_rowData[rowIndex][x] = { palette, color, highPriority ? (uint8_t)2 : (uint8_t)1 };
 				}
@@ -218,9 +218,6 @@ void WsPpu::DrawBackground()
 		uint8_t palette = (tilemapData >> 9) & 0x0F;
 		bool vMirror = tilemapData & 0x8000;
 		bool hMirror = tilemapData & 0x4000;
-		if(hMirror) {
-			tileColumn = 7 - tileColumn;
-		}
 		if(vMirror) {
 			tileRow = 7 - tileRow;
 		}
@@ -228,9 +225,15 @@ void WsPpu::DrawBackground()
 		uint16_t tilesetAddr = mode >= WsVideoMode::Color2bpp && (tilemapData & 0x2000) ? bank1Addr : bank0Addr;
 		uint16_t tileDataAddr = (tilesetAddr + tileIndex * tileSize + tileRow * tileBytesPerRow);
 
+		//Decode the tile's row once, rather than once per pixel
+		uint64_t tilePixels = GetTileRowPixels<mode>(tileDataAddr);
+		if(hMirror) {
+			tilePixels = PlanarTileDecoder::Mirror(tilePixels);
+		}
+
 		for(int i = cycle, end = std::min<int>(cycle + counter, WsConstants::ScreenWidth); i < end; i++) {
-			uint8_t color = GetPixelColor<mode>(tileDataAddr, tileColumn);
-			tileColumn += (hMirror ? -1 : 1);
+			uint8_t color = PlanarTileDecoder::GetPixel(tilePixels, tileColumn);
+			tileColumn++;
 
 			if(_rowData[rowIndex][i].Priority >= layerIndex + 1) {
 				continue;
@@ -254,43 +257,24 @@ void WsPpu::DrawBackground()
 }
 
 template<WsVideoMode mode>
-uint16_t WsPpu::GetPixelColor(uint16_t tileAddr, uint8_t column)
+uint64_t WsPpu::GetTileRowPixels(uint16_t tileAddr)
 {
 	switch(mode) {
-	case WsVideoMode::Monochrome: {
-		uint8_t tileData = _vram[tileAddr];
-		uint8_t tileData2 = _vram[tileAddr + 1];
-		return (
-			((tileData << column) & 0x80) >> 7 |
-			((tileData2 << column) & 0x80) >> 6
-			);
-	}
-
-	case WsVideoMode::Color2bpp: {
-		uint8_t tileData = _vram[tileAddr];
-		uint8_t tileData2 = _vram[tileAddr + 1];
-		return (
-			((tileData << column) & 0x80) >> 7 |
-			((tileData2 << column) & 0x80) >> 6
-			);
-	}
-
-	case WsVideoMode::Color4bpp: {
-		uint8_t tileData = _vram[tileAddr];
-		uint8_t tileData2 = _vram[tileAddr + 1];
-		uint8_t tileData3 = _vram[tileAddr + 2];
-		uint8_t tileData4 = _vram[tileAddr + 3];
-		return (
-			((tileData << column) & 0x80) >> 7 |
-			((tileData2 << column) & 0x80) >> 6 |
-			((tileData3 << column) & 0x80) >> 5 |
-			((tileData4 << column) & 0x80) >> 4
-			);
-	}
-
-	case WsVideoMode::Color4bppPacked: {
-		return (_vram[tileAddr + column / 2] >> (column & 0x01 ? 0 : 4)) & 0x0F;
-	}
+		case WsVideoMode::Monochrome:
+		case WsVideoMode::Color2bpp:
+			return PlanarTileDecoder::Decode2bpp(_vram[tileAddr], _vram[tileAddr + 1]);
+
+		case WsVideoMode::Color4bpp:
+			return PlanarTileDecoder::Decode4bpp(_vram[tileAddr], _vram[tileAddr + 1], _vram[tileAddr + 2], _vram[tileAddr + 3]);
+
+		case WsVideoMode::Color4bppPacked: {
+			uint64_t row = 0;
+			for(int i = 0; i < 4; i++) {
+				uint8_t tileData = _vram[tileAddr + i];
+				row |= (uint64_t)((tileData >> 4) | ((tileData & 0x0F) << 8)) << (i * 16);
+			}
+			return row;
+		}
 	}
 
 	return 0;
@@ -3,6 +3,7 @@
 #include "WS/WsTypes.h"
 #include "Shared/Emulator.h"
 #include "Shared/SettingTypes.h"
+#include "Shared/PlanarTileDecoder.h"
 #include "Utilities/ISerializable.h"
 
 class Emulator;
@@ -48,7 +49,7 @@ private:
 	template<WsVideoMode mode> void DrawSprites();
 	template<WsVideoMode mode, int layerIndex> void DrawBackground();
 
-	template<WsVideoMode mode> __forceinline uint16_t GetPixelColor(uint16_t tileAddr, uint8_t column);
+	template<WsVideoMode mode> __forceinline uint64_t GetTileRowPixels(uint16_t tileAddr);
 
 	__forceinline uint16_t GetBgColor()
 	{
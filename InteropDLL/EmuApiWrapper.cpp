@@ -6,10 +6,12 @@
 #include "Core/Shared/SystemActionManager.h"
 #include "Core/Shared/MessageManager.h"
 #include "Core/Shared/SaveStateManager.h"
+#include "Core/Shared/BatteryManager.h"
 #include "Core/Shared/Interfaces/INotificationListener.h"
 #include "Core/Shared/KeyManager.h"
 #include "Core/Shared/ShortcutKeyHandler.h"
 #include "Core/Shared/TimingInfo.h"
+#include "Core/Shared/PerformanceTracer.h"
 #include "Core/Shared/CheatManager.h"
 #include "Core/Shared/DebuggerRequest.h"
 #include "Core/Netplay/GameClient.h"
@@ -168,6 +170,12 @@ extern "C" {
 		return _emu->GetTimingInfo(cpuType);
 	}
 
+	DllExport void __stdcall SetPerformanceTracing(bool enabled) { _emu->GetPerformanceTracer()->SetEnabled(enabled); }
+	DllExport void __stdcall GetPerformanceStats(PipelineStageStats* stats) { _emu->GetPerformanceTracer()->GetStats(stats); }
+	DllExport bool __stdcall SavePerformanceTrace(char* filename) { return _emu->GetPerformanceTracer()->SaveChromeTrace(filename); }
+
+	DllExport void __stdcall GetBatterySaveStats(BatterySaveStats* stats) { *stats = _emu->GetBatteryManager()->GetStats(); }
+
 	DllExport void __stdcall TakeScreenshot() { _emu->GetVideoDecoder()->TakeScreenshot(); }
 
 	DllExport void __stdcall ProcessAudioPlayerAction(AudioPlayerActionParams p) { _emu->ProcessAudioPlayerAction(p); }
@@ -21,4 +21,6 @@ extern "C"
 	DllExport bool __stdcall MoviePlaying() { return _emu->GetMovieManager()->Playing(); }
 	DllExport bool __stdcall MovieRecording() { return _emu->GetMovieManager()->Recording(); }
 	DllExport void __stdcall MovieRecord(RecordMovieOptions options) { _emu->GetMovieManager()->Record(options); }
+	DllExport bool __stdcall MovieSeek(uint32_t frame) { return _emu->GetMovieManager()->Seek(frame); }
+	DllExport uint32_t __stdcall MovieGetPosition() { return _emu->GetMovieManager()->GetPosition(); }
 }
\ No newline at end of file
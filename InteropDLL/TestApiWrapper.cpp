@@ -2,6 +2,7 @@
 #include "Core/Shared/RecordedRomTest.h"
 #include "Core/Shared/Emulator.h"
 #include "Core/Shared/EmuSettings.h"
+#include "Core/Netplay/NetplayLoopbackTest.h"
 
 extern unique_ptr<Emulator> _emu;
 shared_ptr<RecordedRomTest> _recordedRomTest;
@@ -55,6 +56,12 @@ extern "C"
 		return result;
 	}
 
+	DllExport NetplayLoopbackTestResult __stdcall RunNetplayLoopbackTest(char* filename, uint32_t latency, uint32_t jitter, uint32_t rollbackFrames, uint32_t frameCount)
+	{
+		NetplayLoopbackTest test(latency, jitter);
+		return test.Run(filename, rollbackFrames, frameCount);
+	}
+
 	DllExport void __stdcall RomTestRecord(char* filename, bool reset)
 	{
 		_recordedRomTest.reset(new RecordedRomTest(_emu.get(), false));
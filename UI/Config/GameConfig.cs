@@ -21,12 +21,15 @@ namespace Mesen.Config
 		[Reactive] public bool OverrideOverscan { get; set; } = false;
 		[Reactive] public OverscanConfig Overscan { get; set; } = new();
 
+		[Reactive] public bool SkipIdleLoops { get; set; } = false;
+
 		public void ApplyConfig()
 		{
 			ConfigApi.SetGameConfig(new InteropGameConfig() {
 				DipSwitches = DipSwitches,
 				OverrideOverscan = OverrideOverscan,
-				Overscan = Overscan.ToInterop()
+				Overscan = Overscan.ToInterop(),
+				SkipIdleLoops = SkipIdleLoops
 			});
 		}
 
@@ -65,5 +68,7 @@ namespace Mesen.Config
 		
 		[MarshalAs(UnmanagedType.I1)] public bool OverrideOverscan;
 		public InteropOverscanDimensions Overscan;
+
+		[MarshalAs(UnmanagedType.I1)] public bool SkipIdleLoops;
 	}
 }
\ No newline at end of file
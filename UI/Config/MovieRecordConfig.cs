@@ -1,4 +1,5 @@
 ﻿using Mesen.Interop;
+using System;
 using ReactiveUI.Fody.Helpers;
 
 namespace Mesen.Config
@@ -8,5 +9,7 @@ namespace Mesen.Config
 		[Reactive] public RecordMovieFrom RecordFrom { get; set; } = RecordMovieFrom.CurrentState;
 		[Reactive] public string Author { get; set; } = "";
 		[Reactive] public string Description { get; set; } = "";
+		[Reactive] public bool BinaryInput { get; set; } = false;
+		[Reactive] public UInt32 KeyframeInterval { get; set; } = 0;
 	}
 }
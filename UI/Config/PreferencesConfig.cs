@@ -52,6 +52,9 @@ namespace Mesen.Config
 		[Reactive] public bool EnableAutoSaveState { get; set; } = true;
 		[Reactive] public UInt32 AutoSaveStateDelay { get; set; } = 5;
 
+		[Reactive] public bool EnableAutoSaveBattery { get; set; } = true;
+		[Reactive] public UInt32 AutoSaveBatteryDelay { get; set; } = 30;
+
 		[Reactive] public bool EnableRewind { get; set; } = true;
 		[Reactive] public UInt32 RewindBufferSize { get; set; } = 300;
 
@@ -248,7 +251,8 @@ namespace Mesen.Config
 				SaveStateFolderOverride = OverrideSaveStateFolder ? SaveStateFolder : "",
 				ScreenshotFolderOverride = OverrideScreenshotFolder ? ScreenshotFolder : "",
 				RewindBufferSize = EnableRewind ? RewindBufferSize : 0,
-				AutoSaveStateDelay = EnableAutoSaveState ? AutoSaveStateDelay : 0
+				AutoSaveStateDelay = EnableAutoSaveState ? AutoSaveStateDelay : 0,
+				AutoSaveBatteryDelay = EnableAutoSaveBattery ? AutoSaveBatteryDelay : 0
 			});
 		}
 	}
@@ -296,6 +300,7 @@ namespace Mesen.Config
 		public HudDisplaySize HudSize;
 
 		public UInt32 AutoSaveStateDelay;
+		public UInt32 AutoSaveBatteryDelay;
 		public UInt32 RewindBufferSize;
 
 		public string SaveFolderOverride;
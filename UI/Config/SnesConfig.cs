@@ -39,6 +39,7 @@ namespace Mesen.Config
 		[Reactive] public bool HideSprites { get; set; } = false;
 		[Reactive] public bool DisableFrameSkipping { get; set; } = false;
 		[Reactive] public bool ForceFixedResolution { get; set; } = false;
+		[Reactive] public bool EnableThreadedRendering { get; set; } = false;
 
 		[Reactive] public OverscanConfig Overscan { get; set; } = new() { Top = 7, Bottom = 8 };
 
@@ -97,6 +98,7 @@ namespace Mesen.Config
 				
 				DisableFrameSkipping = DisableFrameSkipping,
 				ForceFixedResolution = ForceFixedResolution,
+				EnableThreadedRendering = EnableThreadedRendering,
 
 				Overscan = Overscan.ToInterop(),
 
@@ -154,6 +156,7 @@ namespace Mesen.Config
 		[MarshalAs(UnmanagedType.I1)] public bool HideSprites;
 		[MarshalAs(UnmanagedType.I1)] public bool DisableFrameSkipping;
 		[MarshalAs(UnmanagedType.I1)] public bool ForceFixedResolution;
+		[MarshalAs(UnmanagedType.I1)] public bool EnableThreadedRendering;
 
 		public InteropOverscanDimensions Overscan;
 
@@ -82,6 +82,18 @@ namespace Mesen.Interop
 
 		[DllImport(DllPath)] public static extern TimingInfo GetTimingInfo(CpuType cpuType);
 
+		[DllImport(DllPath)] public static extern void SetPerformanceTracing([MarshalAs(UnmanagedType.I1)]bool enabled);
+		[DllImport(DllPath, EntryPoint = "GetPerformanceStats")] private static extern void GetPerformanceStatsWrapper([In, Out]PipelineStageStats[] stats);
+		public static PipelineStageStats[] GetPerformanceStats()
+		{
+			PipelineStageStats[] stats = new PipelineStageStats[(int)PipelineStage.Count];
+			GetPerformanceStatsWrapper(stats);
+			return stats;
+		}
+		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool SavePerformanceTrace([MarshalAs(UnmanagedType.LPUTF8Str)]string filename);
+
+		[DllImport(DllPath)] public static extern void GetBatterySaveStats(out BatterySaveStats stats);
+
 		[DllImport(DllPath)] public static extern double GetAspectRatio();
 		[DllImport(DllPath)] public static extern FrameInfo GetBaseScreenSize();
 		[DllImport(DllPath)] public static extern Int32 GetGameMemorySize(MemoryType type);
@@ -145,6 +157,40 @@ namespace Mesen.Interop
 		public UInt32 CycleCount;
 	}
 
+	public enum PipelineStage
+	{
+		Emulate,
+		Filter,
+		Scale,
+		Hud,
+		Present,
+		AudioMix,
+		AudioDevice,
+		FrameLatency,
+		Count
+	}
+
+	public struct PipelineStageStats
+	{
+		public UInt32 SampleCount;
+		public double Average;
+		public double P50;
+		public double P90;
+		public double P99;
+		public double Max;
+	}
+
+	public struct BatterySaveStats
+	{
+		public UInt32 WriteCount;
+		public UInt32 SkipCount;
+		public UInt32 ErrorCount;
+		public UInt32 PendingCount;
+		public UInt64 BytesWritten;
+		public double LastWriteTime;
+		public double MaxWriteTime;
+	}
+
 	public struct FrameInfo
 	{
 		public UInt32 Width;
@@ -25,6 +25,8 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern void MovieStop();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MoviePlaying();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MovieRecording();
+		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool MovieSeek(UInt32 frame);
+		[DllImport(DllPath)] public static extern UInt32 MovieGetPosition();
 	}
 
 	public enum RecordMovieFrom
@@ -40,7 +42,7 @@ namespace Mesen.Interop
 		private const int DescriptionMaxSize = 10000;
 		private const int FilenameMaxSize = 2000;
 
-		public RecordMovieOptions(string filename, string author, string description, RecordMovieFrom recordFrom)
+		public RecordMovieOptions(string filename, string author, string description, RecordMovieFrom recordFrom, bool binaryInput = false, UInt32 keyframeInterval = 0)
 		{
 			Author = Encoding.UTF8.GetBytes(author);
 			Array.Resize(ref Author, AuthorMaxSize);
@@ -55,6 +57,8 @@ namespace Mesen.Interop
 			Filename[FilenameMaxSize - 1] = 0;
 
 			RecordFrom = recordFrom;
+			BinaryInput = binaryInput;
+			KeyframeInterval = keyframeInterval;
 		}
 
 		[MarshalAs(UnmanagedType.ByValArray, SizeConst = FilenameMaxSize)]
@@ -67,6 +71,8 @@ namespace Mesen.Interop
 		public byte[] Description;
 
 		public RecordMovieFrom RecordFrom;
+		[MarshalAs(UnmanagedType.I1)] public bool BinaryInput;
+		public UInt32 KeyframeInterval;
 	}
 
 	public struct RecordAviOptions
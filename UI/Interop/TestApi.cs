@@ -13,6 +13,7 @@ namespace Mesen.Interop
 
 		[DllImport(DllPath)] public static extern RomTestResult RunRecordedTest([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, [MarshalAs(UnmanagedType.I1)]bool inBackground);
 		[DllImport(DllPath)] public static extern UInt64 RunTest([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, int address, MemoryType memType);
+		[DllImport(DllPath)] public static extern NetplayLoopbackTestResult RunNetplayLoopbackTest([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, UInt32 latency, UInt32 jitter, UInt32 rollbackFrames, UInt32 frameCount);
 		[DllImport(DllPath)] public static extern void RomTestRecord([MarshalAs(UnmanagedType.LPUTF8Str)]string filename, [MarshalAs(UnmanagedType.I1)]bool reset);
 		[DllImport(DllPath)] public static extern void RomTestStop();
 		[DllImport(DllPath)] [return: MarshalAs(UnmanagedType.I1)] public static extern bool RomTestRecording();
@@ -24,6 +25,17 @@ namespace Mesen.Interop
 		public Int32 ErrorCode;
 	}
 
+	public struct NetplayLoopbackTestResult
+	{
+		[MarshalAs(UnmanagedType.I1)] public bool Passed;
+		public UInt32 FrameCount;
+		public UInt32 RollbackCount;
+		public UInt32 MaxDepth;
+		public double AverageDepth;
+		public UInt32 StallCount;
+		public UInt32 MaxExpectedDepth;
+	}
+
 	public enum RomTestState
 	{
 		Failed,
@@ -95,6 +95,30 @@ namespace Mesen.Utilities
 			});
 		}
 
+		public static void RunNetplayLoopbackTests()
+		{
+			string romPath = EmuApi.GetRomInfo().RomPath;
+			if(string.IsNullOrWhiteSpace(romPath)) {
+				return;
+			}
+
+			Task.Run(() => {
+				EmuApi.WriteLogEntry("==================");
+				foreach((UInt32 latency, UInt32 jitter) in new (UInt32, UInt32)[] { (0, 0), (30, 0), (50, 20), (100, 50) }) {
+					NetplayLoopbackTestResult result = TestApi.RunNetplayLoopbackTest(romPath, latency, jitter, 10, 1800);
+					string msg = "[Netplay] " + (result.Passed ? "Pass" : "FAIL") + ": latency " + latency + "ms, jitter " + jitter + "ms";
+					msg += " - rollbacks: " + result.RollbackCount + ", max depth: " + result.MaxDepth + " (expected <= " + result.MaxExpectedDepth + ")";
+					msg += ", avg depth: " + result.AverageDepth.ToString("0.00") + ", stalls: " + result.StallCount + ", frames: " + result.FrameCount;
+					EmuApi.WriteLogEntry(msg);
+				}
+				EmuApi.WriteLogEntry("==================");
+
+				Dispatcher.UIThread.Post(() => {
+					ApplicationHelper.GetOrCreateUniqueWindow<LogWindow>(null, () => new LogWindow());
+				});
+			});
+		}
+
 		public static void RunGbMicroTests()
 		{
 			Task.Run(() => {
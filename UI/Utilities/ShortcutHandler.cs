@@ -210,7 +210,9 @@ namespace Mesen.Utilities
 						GetOutputFilename(ConfigManager.MovieFolder, "." + FileDialogHelper.MesenMovieExt),
 						ConfigManager.Config.MovieRecord.Author,
 						ConfigManager.Config.MovieRecord.Description,
-						ConfigManager.Config.MovieRecord.RecordFrom
+						ConfigManager.Config.MovieRecord.RecordFrom,
+						ConfigManager.Config.MovieRecord.BinaryInput,
+						ConfigManager.Config.MovieRecord.KeyframeInterval
 					);
 					RecordApi.MovieRecord(options);
 				}
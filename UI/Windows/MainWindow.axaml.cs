@@ -564,6 +564,9 @@ namespace Mesen.Windows
 			} else if(key == Key.F3) {
 				RomTestHelper.RunAllTests();
 				return true;
+			} else if(key == Key.F9) {
+				RomTestHelper.RunNetplayLoopbackTests();
+				return true;
 			} else if(key == Key.F7) {
 				RomTestHelper.RunGbMicroTests();
 				return true;
@@ -40,7 +40,7 @@ namespace Mesen.Windows
 			MovieRecordConfigViewModel model = (MovieRecordConfigViewModel)DataContext!;
 			model.SaveConfig();
 
-			RecordApi.MovieRecord(new RecordMovieOptions(model.SavePath, model.Config.Author, model.Config.Description, model.Config.RecordFrom));
+			RecordApi.MovieRecord(new RecordMovieOptions(model.SavePath, model.Config.Author, model.Config.Description, model.Config.RecordFrom, model.Config.BinaryInput, model.Config.KeyframeInterval));
 
 			Close(true);
 		}
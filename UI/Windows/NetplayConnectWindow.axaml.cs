@@ -31,7 +31,7 @@ namespace Mesen.Windows
 
 			Close(true);
 
-			NetplayApi.Connect(cfg.Host, cfg.Port, cfg.Password, false); 
+			NetplayApi.Connect(cfg.Host, cfg.Port, cfg.Password, false, cfg.RollbackFrames); 
 		}
 
 		private void Cancel_OnClick(object sender, RoutedEventArgs e)
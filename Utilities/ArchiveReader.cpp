@@ -46,6 +46,15 @@ vector<string> ArchiveReader::GetFileList(std::initializer_list<string> extensio
 	return filenames;
 }
 
+bool ArchiveReader::ExtractFilePrefix(string filename, vector<uint8_t> &output, size_t size)
+{
+	if(ExtractFile(filename, output)) {
+		output.resize(std::min(output.size(), size));
+		return true;
+	}
+	return false;
+}
+
 bool ArchiveReader::CheckFile(string filename)
 {
 	vector<string> files = InternalGetFileList();
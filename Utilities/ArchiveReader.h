@@ -23,6 +23,9 @@ public:
 
 	virtual bool ExtractFile(string filename, vector<uint8_t> &output) = 0;
 
+	//Extracts the first [size] bytes of the file (the whole file is extracted unless the archive format supports partial extraction)
+	virtual bool ExtractFilePrefix(string filename, vector<uint8_t> &output, size_t size);
+
 	static unique_ptr<ArchiveReader> GetReader(std::istream &in);
 	static unique_ptr<ArchiveReader> GetReader(string filepath);
 };
\ No newline at end of file
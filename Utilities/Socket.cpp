@@ -34,6 +34,11 @@ using namespace std;
 	#define ioctlsocket ioctl
 #endif
 
+#ifdef __linux__
+	#include <sys/epoll.h>
+	#include <sys/eventfd.h>
+#endif
+
 Socket::Socket()
 {
 	#ifdef _WIN32	
@@ -109,6 +114,7 @@ void Socket::Close()
 	std::cout << "Socket closed." << std::endl;
 	shutdown(_socket, SD_SEND);
 	closesocket(_socket);
+	_socket = INVALID_SOCKET;
 	SetConnectionErrorFlag();
 }
 
@@ -262,3 +268,119 @@ int Socket::Recv(char *buf, int len, int flags)
 
 	return returnVal;
 }
+
+#ifdef __linux__
+SocketPoller::SocketPoller()
+{
+	_epoll = epoll_create1(0);
+	_wakeEvent = eventfd(0, EFD_NONBLOCK);
+
+	epoll_event ev = {};
+	ev.events = EPOLLIN;
+	ev.data.ptr = nullptr;
+	epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeEvent, &ev);
+}
+
+SocketPoller::~SocketPoller()
+{
+	close(_wakeEvent);
+	close(_epoll);
+}
+
+void SocketPoller::Add(Socket* socket)
+{
+	if(socket->GetHandle() != INVALID_SOCKET) {
+		epoll_event ev = {};
+		ev.events = EPOLLIN | EPOLLRDHUP;
+		ev.data.ptr = socket;
+		epoll_ctl(_epoll, EPOLL_CTL_ADD, (int)socket->GetHandle(), &ev);
+	}
+}
+
+void SocketPoller::Remove(Socket* socket)
+{
+	//Closed sockets are removed from the epoll set automatically
+	if(socket->GetHandle() != INVALID_SOCKET) {
+		epoll_ctl(_epoll, EPOLL_CTL_DEL, (int)socket->GetHandle(), nullptr);
+	}
+}
+
+bool SocketPoller::Wait(int timeoutMs)
+{
+	epoll_event events[16];
+	int count = epoll_wait(_epoll, events, 16, timeoutMs);
+	for(int i = 0; i < count; i++) {
+		if(events[i].data.ptr == nullptr) {
+			uint64_t value;
+			if(read(_wakeEvent, &value, sizeof(value)) < 0) {
+				//Nothing to do, the event was already reset
+			}
+		}
+	}
+	return count > 0;
+}
+
+void SocketPoller::Wake()
+{
+	uint64_t value = 1;
+	if(write(_wakeEvent, &value, sizeof(value)) < 0) {
+		//Counter overflow, the poller is already signaled
+	}
+}
+#else
+SocketPoller::SocketPoller()
+{
+	_wakeFlag = false;
+}
+
+SocketPoller::~SocketPoller()
+{
+}
+
+void SocketPoller::Add(Socket* socket)
+{
+	_sockets.push_back(socket);
+}
+
+void SocketPoller::Remove(Socket* socket)
+{
+	_sockets.erase(std::remove(_sockets.begin(), _sockets.end(), socket), _sockets.end());
+}
+
+bool SocketPoller::Wait(int timeoutMs)
+{
+	if(_wakeFlag.exchange(false)) {
+		return true;
+	}
+
+	fd_set readSockets;
+	FD_ZERO(&readSockets);
+	uintptr_t maxSocket = 0;
+	int socketCount = 0;
+	for(Socket* socket : _sockets) {
+		uintptr_t handle = socket->GetHandle();
+		if(handle != INVALID_SOCKET) {
+			FD_SET(handle, &readSockets);
+			maxSocket = std::max(maxSocket, handle);
+			socketCount++;
+		}
+	}
+
+	if(socketCount == 0) {
+		std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+		return _wakeFlag.exchange(false);
+	}
+
+	//Wake() can't interrupt select(), so don't wait more than 1ms
+	TIMEVAL timeout;
+	timeout.tv_sec = 0;
+	timeout.tv_usec = std::min(timeoutMs, 1) * 1000;
+	int result = select((int)maxSocket + 1, &readSockets, nullptr, nullptr, &timeout);
+	return result > 0 || _wakeFlag.exchange(false);
+}
+
+void SocketPoller::Wake()
+{
+	_wakeFlag = true;
+}
+#endif
@@ -33,4 +33,30 @@ public:
 	void BufferedSend(char *buf, int len);
 	void SendBuffer();
 	int Recv(char *buf, int len, int flags);
+
+	uintptr_t GetHandle() { return _socket; }
+};
+
+//Waits until one of the sockets has data to read, or until Wake() is called
+//Uses epoll on Linux - other platforms fall back to polling the sockets with select() every millisecond
+class SocketPoller
+{
+private:
+	#ifdef __linux__
+	int _epoll = -1;
+	int _wakeEvent = -1;
+	#else
+	vector<Socket*> _sockets;
+	atomic<bool> _wakeFlag;
+	#endif
+
+public:
+	SocketPoller();
+	~SocketPoller();
+
+	void Add(Socket* socket);
+	void Remove(Socket* socket);
+
+	bool Wait(int timeoutMs);
+	void Wake();
 };
@@ -4,13 +4,11 @@
 AviRecorder::AviRecorder(VideoCodec codec, uint32_t compressionLevel)
 {
 	_recording = false;
-	_stopFlag = false;
-	_framePending = false;
-	_frameBuffer = nullptr;
 	_frameBufferLength = 0;
 	_sampleRate = 0;
 	_codec = codec;
 	_compressionLevel = compressionLevel;
+	_droppedFrames = 0;
 }
 
 AviRecorder::~AviRecorder()
@@ -18,11 +16,6 @@ AviRecorder::~AviRecorder()
 	if(_recording) {
 		StopRecording();
 	}
-
-	if(_frameBuffer) {
-		delete[] _frameBuffer;
-		_frameBuffer = nullptr;
-	}
 }
 
 bool AviRecorder::Init(string filename)
@@ -45,7 +38,6 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 		_height = height;
 		_fps = fps;
 		_frameBufferLength = height * width * bpp;
-		_frameBuffer = new uint8_t[_frameBufferLength];
 
 		_aviWriter.reset(new AviWriter());
 		if(!_aviWriter->StartWrite(_outputFile, _codec, width, height, bpp, (uint32_t)(_fps * 1000000), audioSampleRate, _compressionLevel)) {
@@ -53,35 +45,102 @@ bool AviRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 			return false;
 		}
 
-		_aviWriterThread = std::thread([=]() {
-			while(!_stopFlag) {
-				_waitFrame.Wait();
-				if(_stopFlag) {
-					break;
-				}
-
-				auto lock = _lock.AcquireSafe();
-				_aviWriter->AddFrame(_frameBuffer);
-				_framePending = false;
+		//Codecs that support it compress frames on several threads, others compress on the writer thread
+		uint32_t encoderCount = 0;
+		_codecs.clear();
+		unique_ptr<BaseCodec> codec = AviWriter::CreateCodec(_codec);
+		_parallelCompress = codec->SupportsParallelCompress();
+		if(_parallelCompress) {
+			encoderCount = std::clamp<uint32_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+			for(uint32_t i = 0; i < encoderCount; i++) {
+				unique_ptr<BaseCodec> encoder = AviWriter::CreateCodec(_codec);
+				encoder->SetupCompress(width, height, _compressionLevel);
+				_codecs.push_back(std::move(encoder));
 			}
-		});
+			codec->SetupCompress(width, height, _compressionLevel);
+			_keyFrameCodec = std::move(codec);
+		}
+		_droppedFrames = 0;
+
+		_prevFrame.clear();
+		_pendingAudio.clear();
+		_queue.reset(new RecordingQueue(AviRecorder::QueueSize, encoderCount,
+			[this](RecordingQueueItem& item, uint32_t encoderIndex) { EncodeFrame(item, encoderIndex); },
+			[this](RecordingQueueItem& item) { WriteFrame(item); }
+		));
 
 		_recording = true;
 	}
 	return true;
 }
 
+void AviRecorder::EncodeFrame(RecordingQueueItem& item, uint32_t encoderIndex)
+{
+	if(!_parallelCompress) {
+		//Compressed and written in a single step by WriteFrame
+		return;
+	}
+
+	//Frames are written in order, so the frame's index in the file is known unless more frames are dropped before it is written
+	item.IsKeyFrame = _aviWriter->IsKeyFrame((uint32_t)item.Index - _droppedFrames);
+
+	uint8_t* compressedData = nullptr;
+	item.OutputSize = _codecs[encoderIndex]->CompressFrameFromPrevious(item.IsKeyFrame, item.FrameData.data(), item.PrevFrameData.data(), &compressedData);
+	if(item.OutputSize >= 0) {
+		//Chunks are padded to an even size when written
+		item.OutputData.resize(item.OutputSize + 1);
+		memcpy(item.OutputData.data(), compressedData, item.OutputSize);
+	}
+}
+
+void AviRecorder::WriteFrame(RecordingQueueItem& item)
+{
+	if(item.AudioData.size()) {
+		_aviWriter->AddSound(item.AudioData.data(), (uint32_t)item.AudioData.size() / 2);
+	}
+
+	if(_parallelCompress) {
+		if(!item.IsKeyFrame && _aviWriter->IsKeyFrame(_aviWriter->GetFrameCount())) {
+			//The key frame spacing is based on the number of frames in the file
+			uint8_t* compressedData = nullptr;
+			item.IsKeyFrame = true;
+			item.OutputSize = _keyFrameCodec->CompressFrameFromPrevious(true, item.FrameData.data(), item.PrevFrameData.data(), &compressedData);
+			if(item.OutputSize >= 0) {
+				item.OutputData.resize(item.OutputSize + 1);
+				memcpy(item.OutputData.data(), compressedData, item.OutputSize);
+			}
+		}
+
+		if(item.OutputSize >= 0) {
+			_aviWriter->AddCompressedFrame(item.OutputData.data(), item.OutputSize, item.IsKeyFrame);
+		} else {
+			_droppedFrames++;
+		}
+	} else {
+		_aviWriter->AddFrame(item.FrameData.data());
+	}
+}
+
 void AviRecorder::StopRecording()
 {
 	if(_recording) {
 		_recording = false;
 
-		_stopFlag = true;
-		_waitFrame.Signal();
-		_aviWriterThread.join();
+		_queue->Stop();
+
+		{
+			//Write the audio received after the last frame
+			auto lock = _audioLock.AcquireSafe();
+			if(_pendingAudio.size()) {
+				_aviWriter->AddSound(_pendingAudio.data(), (uint32_t)_pendingAudio.size() / 2);
+				_pendingAudio.clear();
+			}
+		}
 
 		_aviWriter->EndWrite();
 		_aviWriter.reset();
+		_codecs.clear();
+		_keyFrameCodec.reset();
 	}
 }
 
@@ -91,15 +150,27 @@ bool AviRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 		if(_width != width || _height != height || _fps != fps) {
 			return false;
 		} else {
-			while(_framePending) {
-				//Previous frame isn't done processing yet, wait
-				std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(1));
+			//Waits for the writer thread if all the queue's slots are in use
+			RecordingQueueItem& item = _queue->BeginPush();
+			item.FrameData.resize(_frameBufferLength);
+			memcpy(item.FrameData.data(), frameBuffer, _frameBufferLength);
+
+			if(_parallelCompress) {
+				if(_prevFrame.empty()) {
+					_prevFrame.resize(_frameBufferLength, 0);
+				}
+				item.PrevFrameData.swap(_prevFrame);
+				_prevFrame.resize(_frameBufferLength);
+				memcpy(_prevFrame.data(), frameBuffer, _frameBufferLength);
+			}
+
+			{
+				auto lock = _audioLock.AcquireSafe();
+				item.AudioData.swap(_pendingAudio);
+				_pendingAudio.clear();
 			}
 
-			auto lock = _lock.AcquireSafe();
-			_framePending = true;
-			memcpy(_frameBuffer, frameBuffer, _frameBufferLength);
-			_waitFrame.Signal();
+			_queue->EndPush();
 		}
 	}
 	return true;
@@ -111,7 +182,8 @@ bool AviRecorder::AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t
 		if(_sampleRate != sampleRate) {
 			return false;
 		} else {
-			_aviWriter->AddSound(soundBuffer, sampleCount);
+			auto lock = _audioLock.AcquireSafe();
+			_pendingAudio.insert(_pendingAudio.end(), soundBuffer, soundBuffer + sampleCount * 2);
 		}
 	}
 	return true;
@@ -125,4 +197,9 @@ bool AviRecorder::IsRecording()
 string AviRecorder::GetOutputFile()
 {
 	return _outputFile;
-}
\ No newline at end of file
+}
+
+RecordingQueueStats AviRecorder::GetStats()
+{
+	return _queue ? _queue->GetStats() : RecordingQueueStats();
+}
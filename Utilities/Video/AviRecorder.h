@@ -1,27 +1,33 @@
 #pragma once
 #include "pch.h"
-#include <thread>
-#include "Utilities/AutoResetEvent.h"
 #include "Utilities/SimpleLock.h"
 #include "Utilities/Video/AviWriter.h"
 #include "Utilities/Video/IVideoRecorder.h"
+#include "Utilities/Video/RecordingQueue.h"
 
 class AviRecorder final : public IVideoRecorder
 {
 private:
-	std::thread _aviWriterThread;
-	
+	static constexpr uint32_t QueueSize = 8;
+
 	unique_ptr<AviWriter> _aviWriter;
+	unique_ptr<RecordingQueue> _queue;
+	vector<unique_ptr<BaseCodec>> _codecs;
 
 	string _outputFile;
-	SimpleLock _lock;
-	AutoResetEvent _waitFrame;
 
-	atomic<bool> _stopFlag;
-	atomic<bool> _framePending;
+	//Audio received since the last frame, written along with the next frame
+	SimpleLock _audioLock;
+	vector<int16_t> _pendingAudio;
+
+	vector<uint8_t> _prevFrame;
+	bool _parallelCompress = false;
+
+	//Used by the writer thread to recompress frames that must be key frames but weren't compressed as such
+	unique_ptr<BaseCodec> _keyFrameCodec;
+	atomic<uint32_t> _droppedFrames;
 
 	bool _recording;
-	uint8_t* _frameBuffer;
 	uint32_t _frameBufferLength;
 	uint32_t _sampleRate;
 
@@ -32,6 +38,9 @@ private:
 	VideoCodec _codec;
 	uint32_t _compressionLevel;
 
+	void EncodeFrame(RecordingQueueItem& item, uint32_t encoderIndex);
+	void WriteFrame(RecordingQueueItem& item);
+
 public:
 	AviRecorder(VideoCodec codec, uint32_t compressionLevel);
 	virtual ~AviRecorder();
@@ -45,4 +54,5 @@ public:
 
 	bool IsRecording() override;
 	string GetOutputFile() override;
-};
\ No newline at end of file
+	RecordingQueueStats GetStats() override;
+};
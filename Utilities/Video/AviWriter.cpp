@@ -64,6 +64,16 @@ void AviWriter::host_writed(uint8_t* buffer, uint32_t value)
 	buffer[3] = value >> 24;
 }
 
+unique_ptr<BaseCodec> AviWriter::CreateCodec(VideoCodec codec)
+{
+	switch(codec) {
+		default:
+		case VideoCodec::None: return std::make_unique<RawCodec>();
+		case VideoCodec::ZMBV: return std::make_unique<ZmbvCodec>();
+		case VideoCodec::CSCD: return std::make_unique<CamstudioCodec>();
+	}
+}
+
 bool AviWriter::StartWrite(string filename, VideoCodec codec, uint32_t width, uint32_t height, uint32_t bpp, uint32_t fps, uint32_t audioSampleRate, uint32_t compressionLevel)
 {
 	_codecType = codec;
@@ -72,12 +82,7 @@ bool AviWriter::StartWrite(string filename, VideoCodec codec, uint32_t width, ui
 		return false;
 	}
 	
-	switch(_codecType) {
-		default:
-		case VideoCodec::None: _codec.reset(new RawCodec()); break;
-		case VideoCodec::ZMBV: _codec.reset(new ZmbvCodec()); break;
-		case VideoCodec::CSCD: _codec.reset(new CamstudioCodec()); break;
-	}
+	_codec = AviWriter::CreateCodec(_codecType);
 
 	if(!_codec->SetupCompress(width, height, compressionLevel)) {
 		return false;
@@ -108,6 +113,14 @@ bool AviWriter::StartWrite(string filename, VideoCodec codec, uint32_t width, ui
 
 void AviWriter::EndWrite()
 {
+	if(_audioPos) {
+		//Write the audio received after the last frame
+		auto lock = _audioLock.AcquireSafe();
+		WriteAviChunk("01wb", _audioPos, _audiobuf, 0);
+		_audiowritten += _audioPos;
+		_audioPos = 0;
+	}
+
 	/* Close the video */
 	uint8_t avi_header[AviWriter::AviHeaderSize];
 	uint32_t main_list;
@@ -233,13 +246,18 @@ void AviWriter::EndWrite()
 	_file.close();
 }
 
+bool AviWriter::IsKeyFrame(uint32_t frameIndex)
+{
+	return _codecType == VideoCodec::None || (frameIndex % 120) == 0;
+}
+
 void AviWriter::AddFrame(uint8_t *frameData)
 {
 	if(!_file) {
 		return;
 	}
 
-	bool isKeyFrame = (_frames % 120 == 0) ? 1 : 0;
+	bool isKeyFrame = IsKeyFrame(_frames);
 
 	uint8_t* compressedData = nullptr;
 	int written = _codec->CompressFrame(isKeyFrame, frameData, &compressedData);
@@ -247,10 +265,16 @@ void AviWriter::AddFrame(uint8_t *frameData)
 		return;
 	}
 
-	if(_codecType == VideoCodec::None) {
-		isKeyFrame = true;
+	AddCompressedFrame(compressedData, written, isKeyFrame);
+}
+
+void AviWriter::AddCompressedFrame(uint8_t* compressedData, int compressedSize, bool isKeyFrame)
+{
+	if(!_file) {
+		return;
 	}
-	WriteAviChunk(_codecType == VideoCodec::None ? "00db" : "00dc", written, compressedData, isKeyFrame ? 0x10 : 0);
+
+	WriteAviChunk(_codecType == VideoCodec::None ? "00db" : "00dc", compressedSize, compressedData, isKeyFrame ? 0x10 : 0);
 	_frames++;
 
 	if(_audioPos) {
@@ -268,6 +292,18 @@ void AviWriter::AddSound(int16_t *data, uint32_t sampleCount)
 	}
 
 	auto lock = _audioLock.AcquireSafe();
-	memcpy(_audiobuf+_audioPos/2, data, sampleCount * 4);
-	_audioPos += sampleCount * 4;
+	while(sampleCount > 0) {
+		if(_audioPos >= sizeof(_audiobuf)) {
+			//Buffer is full (no frame was written for a while), write the audio as its own chunk
+			WriteAviChunk("01wb", _audioPos, _audiobuf, 0);
+			_audiowritten += _audioPos;
+			_audioPos = 0;
+		}
+
+		uint32_t count = std::min<uint32_t>(sampleCount, (sizeof(_audiobuf) - _audioPos) / 4);
+		memcpy(_audiobuf + _audioPos / 2, data, count * 4);
+		_audioPos += count * 4;
+		data += count * 2;
+		sampleCount -= count;
+	}
 }
\ No newline at end of file
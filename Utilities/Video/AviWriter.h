@@ -49,7 +49,13 @@ private:
 	void WriteAviChunk(const char * tag, uint32_t size, void * data, uint32_t flags);
 
 public:
+	static unique_ptr<BaseCodec> CreateCodec(VideoCodec codec);
+
+	bool IsKeyFrame(uint32_t frameIndex);
+	uint32_t GetFrameCount() { return _frames; }
+
 	void AddFrame(uint8_t* frameData);
+	void AddCompressedFrame(uint8_t* compressedData, int compressedSize, bool isKeyFrame);
 	void AddSound(int16_t * data, uint32_t sampleCount);
 
 	bool StartWrite(string filename, VideoCodec codec, uint32_t width, uint32_t height, uint32_t bpp, uint32_t fps, uint32_t audioSampleRate, uint32_t compressionLevel);
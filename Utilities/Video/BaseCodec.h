@@ -8,5 +8,10 @@ public:
 	virtual int CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** compressedData) = 0;
 	virtual const char* GetFourCC() = 0;
 
+	//Codecs whose output only depends on the current and previous frames can compress several frames in parallel
+	//(using one codec instance per thread), by receiving the previous frame explicitly
+	virtual bool SupportsParallelCompress() { return false; }
+	virtual int CompressFrameFromPrevious(bool isKeyFrame, uint8_t* frameData, uint8_t* prevFrameData, uint8_t** compressedData) { return -1; }
+
 	virtual ~BaseCodec() { }
 };
\ No newline at end of file
@@ -88,6 +88,19 @@ int CamstudioCodec::CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t**
 	return _compressor.total_out + 2;
 }
 
+int CamstudioCodec::CompressFrameFromPrevious(bool isKeyFrame, uint8_t* frameData, uint8_t* prevFrameData, uint8_t** compressedData)
+{
+	if(!isKeyFrame) {
+		//Each frame is compressed with a new deflate stream, so only the previous frame's content is needed
+		uint8_t* rowBuffer = _prevFrame;
+		for(int y = 0; y < _height; y++) {
+			LoadRow(prevFrameData + (_height - y - 1) * _orgWidth * 4, rowBuffer);
+			rowBuffer += _rowStride;
+		}
+	}
+	return CompressFrame(isKeyFrame, frameData, compressedData);
+}
+
 const char* CamstudioCodec::GetFourCC()
 {
 	return "CSCD";
@@ -26,5 +26,7 @@ public:
 
 	virtual bool SetupCompress(int width, int height, uint32_t compressionLevel) override;
 	virtual int CompressFrame(bool isKeyFrame, uint8_t *frameData, uint8_t** compressedData) override;
+	virtual bool SupportsParallelCompress() override { return true; }
+	virtual int CompressFrameFromPrevious(bool isKeyFrame, uint8_t* frameData, uint8_t* prevFrameData, uint8_t** compressedData) override;
 	virtual const char* GetFourCC() override;
 };
\ No newline at end of file
@@ -31,18 +31,34 @@ bool GifRecorder::StartRecording(uint32_t width, uint32_t height, uint32_t bpp,
 
 	_recording = GifBegin(_gif.get(), _outputFile.c_str(), width, height, 2, 8, false);
 	_frameCounter = 0;
+
+	if(_recording) {
+		//Palette quantization is slow, do it on a separate thread (frames depend on each other, so a single thread is used)
+		_queue.reset(new RecordingQueue(GifRecorder::QueueSize, 0,
+			[](RecordingQueueItem& item, uint32_t encoderIndex) {},
+			[this](RecordingQueueItem& item) {
+				GifWriteFrame(_gif.get(), item.FrameData.data(), _width, _height, 2, 8, false);
+			}
+		));
+	}
 	return _recording;
 }
 
 void GifRecorder::StopRecording()
 {
 	if(_recording) {
+		_recording = false;
+		_queue->Stop();
 		GifEnd(_gif.get());
 	}
 }
 
 bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, double fps)
 {
+	if(!_recording) {
+		return true;
+	}
+
 	if(_width != width || _height != height || _fps != fps) {
 		return false;
 	}
@@ -51,7 +67,10 @@ bool GifRecorder::AddFrame(void* frameBuffer, uint32_t width, uint32_t height, d
 	
 	if(fps < 55 || (_frameCounter % 6) != 0) {
 		//At 60 FPS, skip 1 of every 6 frames (max FPS for GIFs is 50fps)
-		GifWriteFrame(_gif.get(), (uint8_t*)frameBuffer, width, height, 2, 8, false);
+		RecordingQueueItem& item = _queue->BeginPush();
+		item.FrameData.resize(width * height * 4);
+		memcpy(item.FrameData.data(), frameBuffer, item.FrameData.size());
+		_queue->EndPush();
 	}
 
 	return true;
@@ -70,4 +89,9 @@ bool GifRecorder::IsRecording()
 string GifRecorder::GetOutputFile()
 {
 	return _outputFile;
+}
+
+RecordingQueueStats GifRecorder::GetStats()
+{
+	return _queue ? _queue->GetStats() : RecordingQueueStats();
 }
\ No newline at end of file
@@ -1,13 +1,17 @@
 #pragma once
 #include "pch.h"
 #include "Utilities/Video/IVideoRecorder.h"
+#include "Utilities/Video/RecordingQueue.h"
 
 struct GifWriter;
 
 class GifRecorder final : public IVideoRecorder
 {
 private:
+	static constexpr uint32_t QueueSize = 8;
+
 	std::unique_ptr<GifWriter> _gif;
+	unique_ptr<RecordingQueue> _queue;
 	bool _recording = false;
 	uint32_t _frameCounter = 0;
 	string _outputFile;
@@ -26,4 +30,5 @@ public:
 	bool AddSound(int16_t* soundBuffer, uint32_t sampleCount, uint32_t sampleRate) override;
 	bool IsRecording() override;
 	string GetOutputFile() override;
-};
\ No newline at end of file
+	RecordingQueueStats GetStats() override;
+};
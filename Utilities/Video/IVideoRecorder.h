@@ -1,5 +1,6 @@
 #pragma once
 #include "pch.h"
+#include "Utilities/Video/RecordingQueue.h"
 
 class IVideoRecorder
 {
@@ -16,4 +17,5 @@ public:
 
 	virtual bool IsRecording() = 0;
 	virtual string GetOutputFile() = 0;
+	virtual RecordingQueueStats GetStats() = 0;
 };
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "Utilities/Video/RecordingQueue.h"
+#include "Utilities/Timer.h"
+
+RecordingQueue::RecordingQueue(uint32_t capacity, uint32_t encoderCount, EncodeFunc encode, WriteFunc write)
+{
+	_slots.resize(capacity);
+	_encode = encode;
+	_write = write;
+	_stats.Capacity = capacity;
+
+	for(uint32_t i = 0; i < encoderCount; i++) {
+		_encoders.push_back(std::thread(&RecordingQueue::EncoderThread, this, i));
+	}
+	_writer = std::thread(&RecordingQueue::WriterThread, this);
+}
+
+RecordingQueue::~RecordingQueue()
+{
+	Stop();
+}
+
+RecordingQueueItem& RecordingQueue::BeginPush()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	Slot& slot = GetSlot(_pushIndex);
+	if(slot.State != SlotState::Free) {
+		Timer timer;
+		_signal.wait(lock, [&] { return slot.State == SlotState::Free; });
+		_stats.BlockedCount++;
+		_stats.BlockedTime += timer.GetElapsedMS();
+	}
+
+	slot.State = SlotState::Filling;
+	slot.Item.Index = _pushIndex;
+	return slot.Item;
+}
+
+void RecordingQueue::EndPush()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		GetSlot(_pushIndex).State = SlotState::Queued;
+		_pushIndex++;
+		_stats.ItemCount++;
+		_stats.MaxQueueDepth = std::max(_stats.MaxQueueDepth, (uint32_t)(_pushIndex - _writeIndex));
+	}
+	_signal.notify_all();
+}
+
+void RecordingQueue::EncoderThread(uint32_t encoderIndex)
+{
+	while(true) {
+		uint64_t index;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_signal.wait(lock, [&] { return _encodeIndex < _pushIndex || _stopFlag; });
+			if(_encodeIndex >= _pushIndex) {
+				//Stop requested and all items have been encoded
+				return;
+			}
+			index = _encodeIndex++;
+			GetSlot(index).State = SlotState::Encoding;
+		}
+
+		_encode(GetSlot(index).Item, encoderIndex);
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			GetSlot(index).State = SlotState::Encoded;
+		}
+		_signal.notify_all();
+	}
+}
+
+void RecordingQueue::WriterThread()
+{
+	SlotState readyState = _encoders.empty() ? SlotState::Queued : SlotState::Encoded;
+	while(true) {
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_signal.wait(lock, [&] {
+				return (_writeIndex < _pushIndex && GetSlot(_writeIndex).State == readyState) || (_stopFlag && _writeIndex == _pushIndex);
+			});
+			if(_writeIndex == _pushIndex) {
+				return;
+			}
+			GetSlot(_writeIndex).State = SlotState::Writing;
+		}
+
+		RecordingQueueItem& item = GetSlot(_writeIndex).Item;
+		if(_encoders.empty()) {
+			_encode(item, 0);
+		}
+		_write(item);
+
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			GetSlot(_writeIndex).State = SlotState::Free;
+			_writeIndex++;
+		}
+		_signal.notify_all();
+	}
+}
+
+void RecordingQueue::Stop()
+{
+	{
+		std::unique_lock<std::mutex> lock(_mutex);
+		if(_stopFlag) {
+			return;
+		}
+		_stopFlag = true;
+	}
+	_signal.notify_all();
+
+	for(std::thread& encoder : _encoders) {
+		encoder.join();
+	}
+	_writer.join();
+}
+
+RecordingQueueStats RecordingQueue::GetStats()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	return _stats;
+}
+
+string RecordingQueueStats::ToString()
+{
+	return std::to_string(ItemCount) + " items, max queue depth: " + std::to_string(MaxQueueDepth) + "/" + std::to_string(Capacity) +
+		", blocked " + std::to_string(BlockedCount) + " times (" + std::to_string((int)BlockedTime) + " ms)";
+}
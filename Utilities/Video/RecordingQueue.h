@@ -0,0 +1,94 @@
+#pragma once
+#include "pch.h"
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+struct RecordingQueueItem
+{
+	uint64_t Index = 0;
+	bool IsKeyFrame = false;
+
+	vector<uint8_t> FrameData;
+	vector<uint8_t> PrevFrameData;
+	vector<int16_t> AudioData;
+
+	vector<uint8_t> OutputData;
+	int32_t OutputSize = 0;
+};
+
+struct RecordingQueueStats
+{
+	uint32_t Capacity = 0;
+	uint32_t MaxQueueDepth = 0;
+	uint64_t ItemCount = 0;
+
+	//Number of times (and total time) the producer had to wait for a free slot
+	uint64_t BlockedCount = 0;
+	double BlockedTime = 0;
+
+	string ToString();
+};
+
+//Bounded queue used by the recorders to encode and write data on background threads
+//Items are encoded by a pool of worker threads (or by the writer thread when encoderCount is 0),
+//and are always written in the order they were pushed. When the queue is full, the producer waits.
+class RecordingQueue
+{
+public:
+	using EncodeFunc = std::function<void(RecordingQueueItem& item, uint32_t encoderIndex)>;
+	using WriteFunc = std::function<void(RecordingQueueItem& item)>;
+
+private:
+	enum class SlotState
+	{
+		Free,
+		Filling,
+		Queued,
+		Encoding,
+		Encoded,
+		Writing
+	};
+
+	struct Slot
+	{
+		RecordingQueueItem Item;
+		SlotState State = SlotState::Free;
+	};
+
+	vector<Slot> _slots;
+	std::mutex _mutex;
+	std::condition_variable _signal;
+
+	uint64_t _pushIndex = 0;
+	uint64_t _encodeIndex = 0;
+	uint64_t _writeIndex = 0;
+	bool _stopFlag = false;
+
+	EncodeFunc _encode;
+	WriteFunc _write;
+
+	vector<std::thread> _encoders;
+	std::thread _writer;
+
+	RecordingQueueStats _stats = {};
+
+	Slot& GetSlot(uint64_t index) { return _slots[index % _slots.size()]; }
+
+	void EncoderThread(uint32_t encoderIndex);
+	void WriterThread();
+
+public:
+	RecordingQueue(uint32_t capacity, uint32_t encoderCount, EncodeFunc encode, WriteFunc write);
+	~RecordingQueue();
+
+	//Returns the next free item, waiting for the writer if the queue is full
+	RecordingQueueItem& BeginPush();
+	void EndPush();
+
+	//Writes all pending items and stops the threads
+	void Stop();
+
+	RecordingQueueStats GetStats();
+};
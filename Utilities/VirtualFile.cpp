@@ -266,6 +266,36 @@ bool VirtualFile::ReadFile(uint8_t* out, uint32_t expectedSize)
 	return false;
 }
 
+bool VirtualFile::ReadFilePrefix(vector<uint8_t>& out, size_t size)
+{
+	if(_data.size() > 0) {
+		out.assign(_data.begin(), _data.begin() + std::min(_data.size(), size));
+		return true;
+	}
+
+	out.clear();
+	if(!_innerFile.empty()) {
+		unique_ptr<ArchiveReader> reader = ArchiveReader::GetReader(_path);
+		if(reader) {
+			if(_innerFileIndex >= 0) {
+				vector<string> filelist = reader->GetFileList(VirtualFile::RomExtensions);
+				return (int32_t)filelist.size() > _innerFileIndex && reader->ExtractFilePrefix(filelist[_innerFileIndex], out, size);
+			} else {
+				return reader->ExtractFilePrefix(_innerFile, out, size);
+			}
+		}
+	} else {
+		ifstream input(_path, std::ios::in | std::ios::binary);
+		if(input.good()) {
+			out.resize(size, 0);
+			input.read((char*)out.data(), size);
+			out.resize((size_t)input.gcount());
+			return true;
+		}
+	}
+	return false;
+}
+
 uint8_t VirtualFile::ReadByte(uint32_t offset)
 {
 	InitChunks();
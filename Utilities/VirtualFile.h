@@ -48,6 +48,9 @@ public:
 	bool ReadFile(std::stringstream &out);
 	bool ReadFile(uint8_t* out, uint32_t expectedSize);
 
+	//Reads up to [size] bytes from the start of the file, without loading the whole file when possible
+	bool ReadFilePrefix(vector<uint8_t> &out, size_t size);
+
 	uint8_t ReadByte(uint32_t offset);
 
 	bool ApplyPatch(VirtualFile &patch);
@@ -63,4 +63,36 @@ bool ZipReader::ExtractFile(string filename, vector<uint8_t> &output)
 	}
 
 	return false;
-}
\ No newline at end of file
+}
+
+struct ZipPrefixData
+{
+	vector<uint8_t>* Output;
+	size_t Size;
+};
+
+static size_t ZipPrefixCallback(void* opaque, mz_uint64 offset, const void* buffer, size_t n)
+{
+	ZipPrefixData* data = (ZipPrefixData*)opaque;
+	size_t count = std::min(n, data->Size - data->Output->size());
+	data->Output->insert(data->Output->end(), (uint8_t*)buffer, (uint8_t*)buffer + count);
+
+	//Returning less than n stops the decompression once enough data has been extracted
+	return data->Output->size() < data->Size ? n : 0;
+}
+
+bool ZipReader::ExtractFilePrefix(string filename, vector<uint8_t> &output, size_t size)
+{
+	if(_initialized) {
+		output.clear();
+		if(size == 0) {
+			return true;
+		}
+
+		ZipPrefixData data = { &output, size };
+		bool result = mz_zip_reader_extract_file_to_callback(&_zipArchive, filename.c_str(), ZipPrefixCallback, &data, 0) != 0;
+		return result || output.size() == size;
+	}
+
+	return false;
+}
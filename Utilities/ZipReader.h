@@ -17,4 +17,5 @@ public:
 	virtual ~ZipReader();
 
 	bool ExtractFile(string filename, vector<uint8_t> &output);
+	bool ExtractFilePrefix(string filename, vector<uint8_t> &output, size_t size) override;
 };
\ No newline at end of file
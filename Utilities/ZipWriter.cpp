@@ -34,14 +34,14 @@ void ZipWriter::AddFile(string filepath, string zipFilename)
 	}
 }
 
-void ZipWriter::AddFile(vector<uint8_t> &fileData, string zipFilename)
+void ZipWriter::AddFile(vector<uint8_t> &fileData, string zipFilename, int compressionLevel)
 {
-	if(!mz_zip_writer_add_mem(&_zipArchive, zipFilename.c_str(), fileData.data(), fileData.size(), MZ_BEST_COMPRESSION)) {
+	if(!mz_zip_writer_add_mem(&_zipArchive, zipFilename.c_str(), fileData.data(), fileData.size(), compressionLevel)) {
 		std::cout << "mz_zip_writer_add_file() failed!" << std::endl;
 	}
 }
 
-void ZipWriter::AddFile(std::stringstream &filestream, string zipFilename)
+void ZipWriter::AddFile(std::stringstream &filestream, string zipFilename, int compressionLevel)
 {
 	filestream.seekg(0, std::ios::end);
 	size_t bufferSize = (size_t)filestream.tellg();
@@ -50,5 +50,5 @@ void ZipWriter::AddFile(std::stringstream &filestream, string zipFilename)
 	vector<uint8_t> buffer(bufferSize);
 	filestream.read((char*)buffer.data(), bufferSize);
 
-	AddFile(buffer, zipFilename);
+	AddFile(buffer, zipFilename, compressionLevel);
 }